@@ -2,37 +2,42 @@
 #include <stdio.h>
 #include "cartridge.h"
 #include "cpu.h"
-#include "memory_map.h"
 #include "memory.h"
+#include "memory_map.h"
 #include "mbc.h"
 
-// Read cartridge info and setup the cpu based on it
-void cartridgeInfo(Cpu *cpu, FILE *rom) {
+// Read cartridge info and setup the cpu based on it, printing the details if verbose. Returns 0, or an error
+// number with error set to what's wrong with the rom.
+int cartridgeInfo(Cpu *cpu, FILE *rom, bool verbose, const char **error) {
     // Read in cartridge header
     fseek(rom, CART_HEADER_BASE, SEEK_SET);
     uint8 header[CART_HEADER_BOUND];
     if (fread(header, 1, sizeof(header), rom) < CART_HEADER_BOUND) {
-        printf("Header incorrectly read\n");
-        exit(795);
+        *error = "Header incorrectly read";
+        return 795;
     }
     rewind(rom);
 
     // Fetch and store the title
-    char title[16];
+    char title[17] = { 0 };
     for (int i = 0; i < 16; i++) {
         title[i] = (header + 0x34)[i];
     }
-    printf("Now playing: %s\n", title);
+    if (verbose) {
+        printf("Now playing: %s\n", title);
+    }
 
     // Check if it's gbc only rom
     if (header[0x43] == 0xC0) {
-        printf("GBC cartridges not supported!\n");
-        exit(523);
+        *error = "GBC cartridges not supported!";
+        return 523;
     }
 
     // Get cartridge type
     cpu->cart_type = header[0x47];
-    printf("Cartridge type: 0x%X\n", cpu->cart_type);
+    if (verbose) {
+        printf("Cartridge type: 0x%X\n", cpu->cart_type);
+    }
 
     // Get size of cartridge internal rom and ram
     uint8 romValue = header[0x48];
@@ -47,8 +52,8 @@ void cartridgeInfo(Cpu *cpu, FILE *rom) {
         case 0x07:
         case 0x08: cpu->maxRomBank = (2 << romValue); break;
         default:
-            printf("Invalid cartridge!\n");
-            exit(22);
+            *error = "Invalid cartridge!";
+            return 22;
     }
     uint32 romSize = cpu->maxRomBank * ROM_BANK_SIZE;
 
@@ -63,11 +68,13 @@ void cartridgeInfo(Cpu *cpu, FILE *rom) {
         case 0x04:  ramSize = 128; break;
         case 0x05:  ramSize = 64;  break;
         default:
-            printf("Invalid cartridge!\n");
-            exit(22);
+            *error = "Invalid cartridge!";
+            return 22;
     }
     cpu->maxRamBank = (ramSize / 8);
-    printf("ROM size: %dKB\nInternal RAM size: %dKB\n", romSize, ramSize);
+    if (verbose) {
+        printf("ROM size: %dKB\nInternal RAM size: %dKB\n", romSize, ramSize);
+    }
 
     // Setup the cpu for the type of cartridge the game is.
     switch (cpu->cart_type) {
@@ -86,8 +93,8 @@ void cartridgeInfo(Cpu *cpu, FILE *rom) {
         case 0x1A:
         case 0x1B: cpu->mbc = 5; break;
         default:
-            printf("Cartridge type not supported\n");
-            exit(13);
+            *error = "Cartridge type not supported";
+            return 13;
     }
     setupMBCCallbacks(cpu);
 
@@ -101,18 +108,22 @@ void cartridgeInfo(Cpu *cpu, FILE *rom) {
         exit(631);
     }
     if (fread(cpu->memory.rom, 1, romSize, rom) < romSize) {
-        printf("File size does not match cartridge size\n");
-        exit(750);
+        *error = "File size does not match cartridge size";
+        return 750;
     }
     cpu->memory.romBank = cpu->memory.rom + ROM_BANK_SIZE;
 
     // Allocate ram
     if (cpu->RAM_exists) {
-        cpu->memory.ram = (uint8 *) malloc(ramSize * 1024 * sizeof(uint8));
+        cpu->memory.ram = (uint8 *) calloc(ramSize * 1024, sizeof(uint8));
         if (!cpu->memory.ram) {
             printf("Unabled to malloc space for ram\n");
             exit(632);
         }
         cpu->memory.ramBank = cpu->memory.ram;
     }
+
+    // Map the cartridge into the address space
+    mapMemory(cpu);
+    return 0;
 }
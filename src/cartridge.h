@@ -4,6 +4,6 @@
 #include <stdio.h>
 #include "cpu.h"
 
-extern void cartridgeInfo(Cpu *cpu, FILE *rom);
+extern int cartridgeInfo(Cpu *cpu, FILE *rom, bool verbose, const char **error);
 
 #endif /* CARTRIDE_H */
\ No newline at end of file
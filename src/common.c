@@ -33,9 +33,9 @@ void printInstruction(bool showPC, uint16 PC, Cpu *cpu) {
     uint8 opcode = readByte(PC, cpu);
     if (opcode == 0xCB) { //print CB prefix instruction
         printf("%s\n", get_cb_opcode(readByte(PC + 1, cpu)).name);
-    } else if (get_opcode(opcode).bytes == 1) { //print single byte instruction
+    } else if (opcode_length[opcode] == 1) { //print single byte instruction
         printf("%s\n", get_opcode(opcode).name);
-    } else if (get_opcode(opcode).bytes == 2) { //print two byte instruction
+    } else if (opcode_length[opcode] == 2) { //print two byte instruction
         printf(get_opcode(opcode).name, readByte(PC + 1, cpu));
         printf("\n");
     } else { //print three byte instruction
@@ -51,12 +51,13 @@ void printInstructionToFile(uint16 PC, FILE *file, Cpu *cpu) {
 		return;
 	}
     fprintf(file, "0x%04X:  ", PC);
+    cpu->registers.F = readFlagsRegister(cpu);
     uint8 opcode = readByte(PC, cpu);
     if (opcode == 0xCB) { //print CB prefix instruction
         fprintf(file, "%s\nAF:\t%X\tBC:\t%X\tDE:\t%X\tHL:\t%X\n", get_cb_opcode(readByte(PC + 1, cpu)).name, cpu->registers.AF, cpu->registers.BC, cpu->registers.DE, cpu->registers.HL);
-    } else if (get_opcode(opcode).bytes == 1) { //print single byte instruction
+    } else if (opcode_length[opcode] == 1) { //print single byte instruction
         fprintf(file, "%s\nAF:\t%X\tBC:\t%X\tDE:\t%X\tHL:\t%X\n", get_opcode(opcode).name, cpu->registers.AF, cpu->registers.BC, cpu->registers.DE, cpu->registers.HL);
-    } else if (get_opcode(opcode).bytes == 2) { //print two byte instruction
+    } else if (opcode_length[opcode] == 2) { //print two byte instruction
         fprintf(file, get_opcode(opcode).name, readByte(PC + 1, cpu));
         fprintf(file, "\nAF:\t%X\tBC:\t%X\tDE:\t%X\tHL:\t%X\n", cpu->registers.AF, cpu->registers.BC, cpu->registers.DE, cpu->registers.HL);
     } else { //print three byte instruction
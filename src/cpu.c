@@ -4,25 +4,37 @@
 #endif
 #include "types.h"
 #include "opcodes/opcodes.h"
+#include "memory.h"
+#include "opcodes/block.h"
+#include "debug/profiler.h"
+#ifdef JIT
+    #include "jit/jit.h"
+#endif
 #include "cpu.h"
+#include "scheduler.h"
+#include "screen.h"
+#include "interrupts.h"
+#include "display.h"
+#include "renderer.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
-// Initialise the cpu
+// Initialise the cpu to the state the boot rom leaves it in. The memory segments are already allocated, and
+// the cartridge, if one is loaded, stays loaded.
 static void initCPU(Cpu *cpu) {
-    // Malloc memory segments
-    cpu->memory.wram = (uint8 *) malloc(8 * WRAM_BANK_SIZE * sizeof(uint8));
-    cpu->memory.vram = (uint8 *) malloc(2 * VRAM_BANK_SIZE * sizeof(uint8));
-    if (!cpu->memory.wram || !cpu->memory.vram) {
-        printf("Failed to malloc vram or wram\n");
-        exit(523);
-    }
+    // Cleared so every emulator starts from the same state
+    memset(cpu->memory.wram, 0, 8 * WRAM_BANK_SIZE);
+    memset(cpu->memory.vram, 0, 2 * VRAM_BANK_SIZE);
+    memset(cpu->memory.oam, 0, sizeof(cpu->memory.oam));
+    memset(cpu->memory.io, 0, sizeof(cpu->memory.io));
+    memset(cpu->memory.hram, 0, sizeof(cpu->memory.hram));
     cpu->memory.wramBank = cpu->memory.wram + WRAM_BANK_SIZE;
     cpu->memory.vramBank = cpu->memory.vram;
 
-    // Rom and ram is handled when reading the cartridge
-    cpu->memory.rom = cpu->memory.romBank = NULL;
-    cpu->memory.ram = cpu->memory.ramBank = NULL;
+    // Back to the first banks of the cartridge. Its ram keeps its contents, like a battery-backed cartridge.
+    cpu->memory.romBank = (cpu->memory.rom) ? cpu->memory.rom + ROM_BANK_SIZE : NULL;
+    cpu->memory.ramBank = cpu->memory.ram;
 
     // Setup the PC and SP
     cpu->PC = 0x100;
@@ -31,12 +43,8 @@ static void initCPU(Cpu *cpu) {
 
     // Setup mbc stuff
     cpu->currentRomBank = 1;
-    cpu->maxRomBank = 1;
     cpu->currentRamBank = 0;
-    cpu->maxRamBank = 0;
     cpu->RAM_enable = false;
-    cpu->readMBC = NULL;
-    cpu->writeMBC = NULL;
     cpu->mbc1Mode = false;
 
     // Setup interrupts
@@ -44,9 +52,12 @@ static void initCPU(Cpu *cpu) {
     cpu->ime_enable = false;
     cpu->halt = false;
     cpu->halt_bug = false;
+    cpu->blockExit = false;
+    cpu->volatileRead = false;
 
     // Setup startup values of registers
     cpu->registers.AF = 0x01B0;
+    writeFlagsRegister(cpu->registers.F, cpu);
     cpu->registers.BC = 0x0013;
     cpu->registers.DE = 0x00D8;
     cpu->registers.HL = 0x014D;
@@ -85,22 +96,94 @@ static void initCPU(Cpu *cpu) {
     cpu->memory.io[WINDOW_Y - IO_BASE] = 0x00; // WY
     cpu->memory.io[WINDOW_X - IO_BASE] = 0x00; // WX
     cpu->memory.ie = 0x00; // INTERRUPTS ENABLED
+
+    // Map the cartridge, if there is one yet. See cartridgeInfo
+    mapMemory(cpu);
+
+    // No buttons pressed
+    cpu->inputs = (input) { 0 };
+
+    // Setup the clock and start the screen and timer
+    cpu->instructions = 0;
+    resetScheduler(cpu);
+    resetDisplay(cpu);
+    resetScreen(cpu);
+    resetTimer(cpu);
+
+    // Drop any code decoded from the previous cartridge
+    resetBlockCache(cpu);
+    #ifdef JIT
+        resetJitCache(cpu);
+    #endif
 }
 
 // Create the cpu
 Cpu* createCPU() {
-    Cpu *cpu = (Cpu *) malloc(sizeof(Cpu));
+    Cpu *cpu = (Cpu *) calloc(1, sizeof(Cpu));
+    if (!cpu) {
+        printf("Failed to malloc cpu\n");
+        exit(523);
+    }
+    // Malloc memory segments
+    cpu->memory.wram = (uint8 *) malloc(8 * WRAM_BANK_SIZE * sizeof(uint8));
+    cpu->memory.vram = (uint8 *) malloc(2 * VRAM_BANK_SIZE * sizeof(uint8));
+    if (!cpu->memory.wram || !cpu->memory.vram) {
+        printf("Failed to malloc vram or wram\n");
+        exit(523);
+    }
+    // Rom and ram is handled when reading the cartridge
+    cpu->memory.rom = NULL;
+    cpu->memory.ram = NULL;
+    cpu->maxRomBank = 1;
+    cpu->maxRamBank = 0;
+    cpu->readMBC = NULL;
+    cpu->writeMBC = NULL;
+    cpu->blocks = createBlockCache();
+    #ifdef JIT
+        cpu->jit = createJitCache();
+    #endif
+    cpu->profiler = NULL;
+    cpu->display = createDisplay();
+    cpu->renderer = NULL;
+    cpu->videoCallback = NULL;
+    cpu->inputCallback = NULL;
+    cpu->callbackData = NULL;
     // Initialise the cpu
     initCPU(cpu);
 
     return cpu;
 }
 
-// Reset the cpu
+// Free the cpu and everything it holds
+void freeCPU(Cpu *cpu) {
+    if (cpu->renderer) {
+        stopRenderer(cpu);
+    }
+    if (cpu->profiler) {
+        freeProfiler(cpu);
+    }
+    free(cpu->memory.rom);
+    free(cpu->memory.ram);
+    free(cpu->memory.wram);
+    free(cpu->memory.vram);
+    free(cpu->blocks);
+    #ifdef JIT
+        freeJitCache(cpu);
+    #endif
+    free(cpu->display);
+    free(cpu);
+}
+
+// Reset the cpu, keeping the cartridge, the profiler and the frontend's display settings
 void resetCPU(Cpu *cpu) {
-    // Re-initialise the cpu
+    // The renderer thread's copy of the display would be stale. It starts again at the end of the next frame.
+    bool threaded = cpu->display->renderThreaded;
+    if (cpu->renderer) {
+        stopRenderer(cpu);
+    }
+    // Re-initialise the cpu, along with its scheduler, timer, screen and display
     initCPU(cpu);
-    // TDOD: reset timers and display stuff
+    cpu->display->renderThreaded = threaded;
 }
 
 // Execute a single cpu step
@@ -110,7 +193,20 @@ int executeCPU(Cpu *cpu) {
             return 1;
         }
     #endif
-    int errNum = executeNextInstruction(cpu);
+    int errNum;
+    if (cpu->profiler) {
+        // Profile a single instruction at a time so each one is counted
+        errNum = profileInstruction(cpu);
+    } else {
+        #ifdef DEBUG
+            // Step a single instruction at a time so the debugger sees each one
+            errNum = executeNextInstruction(cpu);
+        #elif defined(JIT)
+            errNum = executeJit(cpu);
+        #else
+            errNum = executeBlock(cpu);
+        #endif
+    }
     if (errNum) {
         #ifdef DEBUG
             // Force a run/runto to stop when an error has occurred
@@ -123,8 +219,3 @@ int executeCPU(Cpu *cpu) {
         return 0;
     }
 }
-
-// Cycle cpu clock.
-void cycleCPU(Cpu *cpu) {
-    cpu->wait--;
-}
@@ -3,6 +3,8 @@
 
 #include "types.h"
 #include "memory_map.h"
+#include "scheduler.h"
+#include "input.h"
 
 // Constant positions of flags in flags array
 enum {
@@ -16,6 +18,13 @@ typedef struct Cpu Cpu;
 
 // Struct to hold the cpu state
 struct Cpu {
+    struct BlockCache *blocks; // malloc'ed
+#ifdef JIT
+    struct JitCache *jit; // malloc'ed
+#endif
+    struct Profiler *profiler; // malloc'ed, NULL when not profiling
+    struct Display *display; // malloc'ed
+    struct Renderer *renderer; // malloc'ed, NULL when frames are drawn on the cpu's thread
     struct Memory {
         uint8 oam[OAM_BOUND];
         uint8 io[IO_BOUND];
@@ -29,6 +38,9 @@ struct Cpu {
         uint8 *wram; // malloc'ed
         uint8 *vram; // malloc'ed
         uint8 ie;
+        // Host memory for each 256 byte page of the address space, NULL when it needs the slow path
+        uint8 *readMap[0x100];
+        uint8 *writeMap[0x100];
     } memory;
     struct Registers {
         union {
@@ -59,12 +71,33 @@ struct Cpu {
             };
             uint16 HL;
         };
+        // Flags are kept unpacked from the results of the last operation that set them, so
+        // instructions don't have to rebuild F. F is only built when something reads it.
+        uint16 carry; // Carry flag is bit 8
+        uint16 half; // Half-carry flag is bit 4
+        uint8 zero; // Zero flag is set when this is 0
+        bool negative;
     } registers;
     uint8 (*readMBC)(uint16 address, Cpu *cpu);
     void (*writeMBC)(uint16 address, uint8 value, Cpu *cpu);
     uint16 PC;
     uint16 SP;
-    uint16 cycles;
+    // Host memory instructions are fetched from, covering fetchBound bytes from fetchBase
+    uint8 *fetch;
+    uint16 fetchBase;
+    uint16 fetchBound;
+    uint64 clock; // master clock, counted in cycles
+    uint64 instructions; // instructions executed
+    uint64 events[EVENT_COUNT]; // time each event is next due
+    uint64 nextEvent;
+    uint64 divider_reset; // clock time the internal divider was last reset
+    uint64 timer_synced; // clock time TIMA was last brought up to date
+    bool displayActive; // false while waiting for the LCD to be switched back on
+    input inputs; // last inputs read from the frontend
+    // Frontend callbacks, each passed callbackData
+    void (*videoCallback)(uint8 *frameBuffer, void *data);
+    void (*inputCallback)(input *inputs, void *data);
+    void *callbackData;
     uint16 currentRomBank;
     uint16 maxRomBank;
     uint8 currentRamBank;
@@ -80,16 +113,17 @@ struct Cpu {
     bool mbc1_small_ram;
     bool ime;
     bool ime_enable;
+    bool blockExit; // Set when the running block must stop after the current instruction
+    bool volatileRead; // Set when TIMA, DIV or the joypad is read, as they change without an event
 };
 
 // Create and return a new cpu state
 extern Cpu *createCPU();
+// Free the given cpu state
+extern void freeCPU(Cpu *cpu);
 // Reset the given cpu state back to initial values
 extern void resetCPU(Cpu *cpu);
 // Execute an instruction
 extern int executeCPU(Cpu *cpu);
-// Cycle the cpu while instruction is taking place
-// Used to emulate the time taken to exec each instruction
-extern void cycleCPU(Cpu *cpu);
 
 #endif /* CPU_H */
@@ -85,6 +85,7 @@ bool debug(bool force, Cpu * cpu) {
             printf("\n");
         } else if (!strcmp(r, argv[0])) {
             // Print registers, values at memory locations, and cartridge info.
+            cpu->registers.F = readFlagsRegister(cpu);
             printf("A:\t");
             printByte(cpu->registers.A);
             printf("\tF:\t");
@@ -0,0 +1,390 @@
+/* -*-mode:c; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+#include "../types.h"
+#include "../cpu.h"
+#include "../memory_map.h"
+#include "../memory.h"
+#include "../opcodes/opcodes.h"
+#include "profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Locations are counted in pages of 4KB of a bank, allocated when code first runs there
+#define PROFILE_PAGE_SIZE 0x1000
+#define PROFILE_BANKS 0x200
+#define PROFILE_PAGES (PROFILE_BANKS * (0x10000 / PROFILE_PAGE_SIZE))
+// Number of interrupt vectors, from 0x40 to 0x60
+#define PROFILE_INTERRUPTS 5
+// Marks call tree nodes for interrupt handlers, which are keyed by vector
+#define PROFILE_INTERRUPT 0x80000000
+
+static const char *INTERRUPT_NAMES[PROFILE_INTERRUPTS] = {
+    "vblank", "stat", "timer", "serial", "joypad"
+};
+
+// Instructions run and cycles used by a location, opcode or interrupt
+typedef struct {
+    uint64 count;
+    uint64 cycles;
+} ProfileCount;
+
+// A function in the call tree, holding the cycles spent in it and not in its calls
+typedef struct {
+    uint32 key; // bank and address called, or the vector of an interrupt
+    uint32 parent;
+    uint32 child;
+    uint32 sibling;
+    uint64 cycles;
+} ProfileNode;
+
+// A call that hasn't returned yet
+typedef struct {
+    uint32 node;
+    uint16 sp; // SP after the return address was pushed
+    int8 interrupt; // innermost interrupt being handled, or -1
+} ProfileFrame;
+
+// A location in the report
+typedef struct {
+    uint16 bank;
+    uint16 address;
+    ProfileCount count;
+} ProfileLocation;
+
+struct Profiler {
+    char *path;
+    ProfileCount *pages[PROFILE_PAGES]; // malloc'ed
+    ProfileCount opcodes[0x200]; // CB prefixed opcodes follow the others
+    ProfileCount interrupts[PROFILE_INTERRUPTS];
+    ProfileNode *nodes; // malloc'ed, node 0 is the root
+    uint32 nodeCount;
+    uint32 nodeCapacity;
+    ProfileFrame frames[PROFILE_MAX_DEPTH];
+    uint16 depth; // frames[0] is the root
+    uint64 instructions;
+    uint64 cycles; // cycles spent running instructions and entering interrupts
+    uint64 startClock;
+};
+
+// Return the bank mapped at an address, 0 where there is no banking
+static uint16 bankOf(uint16 address, Cpu *cpu) {
+    if (address >= ROM_SWITCHABLE_BASE && address < ROM_SWITCHABLE_BASE + ROM_SWITCHABLE_BOUND) {
+        return cpu->currentRomBank % PROFILE_BANKS;
+    } else if (address >= EXTERNAL_RAM_BASE && address < EXTERNAL_RAM_BASE + EXTERNAL_RAM_BOUND) {
+        return cpu->currentRamBank;
+    }
+    return 0;
+}
+
+// Read a byte of a bank, which may not be the one mapped in
+static uint8 bankByte(uint16 bank, uint16 address, Cpu *cpu) {
+    if (address < ROM_FIXED_BASE + ROM_FIXED_BOUND) {
+        return cpu->memory.rom[address];
+    } else if (address < ROM_SWITCHABLE_BASE + ROM_SWITCHABLE_BOUND && bank < cpu->maxRomBank) {
+        return cpu->memory.rom[(bank * ROM_BANK_SIZE) + address - ROM_SWITCHABLE_BASE];
+    }
+    return readByte(address, cpu);
+}
+
+// Return the counts for a location, allocating its page if needed
+static ProfileCount *locationCount(uint16 bank, uint16 address, struct Profiler *profiler) {
+    uint32 page = (((uint32) bank) << 4) | (address / PROFILE_PAGE_SIZE);
+    if (!profiler->pages[page]) {
+        profiler->pages[page] = (ProfileCount *) calloc(PROFILE_PAGE_SIZE, sizeof(ProfileCount));
+        if (!profiler->pages[page]) {
+            printf("Failed to malloc profiler page\n");
+            exit(526);
+        }
+    }
+    return &profiler->pages[page][address % PROFILE_PAGE_SIZE];
+}
+
+// Find the child of a node with the given key, adding it if it isn't there
+static uint32 childNode(uint32 parent, uint32 key, struct Profiler *profiler) {
+    for (uint32 node = profiler->nodes[parent].child; node; node = profiler->nodes[node].sibling) {
+        if (profiler->nodes[node].key == key) {
+            return node;
+        }
+    }
+    if (profiler->nodeCount == profiler->nodeCapacity) {
+        profiler->nodeCapacity *= 2;
+        profiler->nodes = (ProfileNode *) realloc(profiler->nodes, profiler->nodeCapacity * sizeof(ProfileNode));
+        if (!profiler->nodes) {
+            printf("Failed to malloc profiler call tree\n");
+            exit(526);
+        }
+    }
+    uint32 node = profiler->nodeCount++;
+    profiler->nodes[node] = (ProfileNode) {
+        .key = key,
+        .parent = parent,
+        .child = 0,
+        .sibling = profiler->nodes[parent].child,
+        .cycles = 0
+    };
+    profiler->nodes[parent].child = node;
+    return node;
+}
+
+// Enter a call or interrupt handler. Calls past the deepest frame are counted in the caller.
+static void pushFrame(uint32 key, int8 interrupt, Cpu *cpu) {
+    struct Profiler *profiler = cpu->profiler;
+    if (profiler->depth + 1 >= PROFILE_MAX_DEPTH) {
+        return;
+    }
+    ProfileFrame *caller = &profiler->frames[profiler->depth++];
+    ProfileFrame *frame = &profiler->frames[profiler->depth];
+    frame->node = childNode(caller->node, key, profiler);
+    frame->sp = cpu->SP;
+    frame->interrupt = (interrupt >= 0) ? interrupt : caller->interrupt;
+}
+
+// Leave every frame whose return address has been popped. This covers returns, and code that drops
+// its return address or resets the SP.
+static void popFrames(Cpu *cpu) {
+    struct Profiler *profiler = cpu->profiler;
+    while (profiler->depth && cpu->SP > profiler->frames[profiler->depth].sp) {
+        profiler->depth--;
+    }
+}
+
+// Add cycles to the running function and interrupt
+static void countCycles(uint8 cycles, struct Profiler *profiler) {
+    ProfileFrame *frame = &profiler->frames[profiler->depth];
+    profiler->nodes[frame->node].cycles += cycles;
+    if (frame->interrupt >= 0) {
+        profiler->interrupts[frame->interrupt].cycles += cycles;
+    }
+    profiler->cycles += cycles;
+}
+
+// Return true for instructions that push a return address and jump
+static bool isCall(uint8 opcode) {
+    switch (opcode) {
+        case 0xC4: case 0xCC: case 0xCD: case 0xD4: case 0xDC: // CALL
+        case 0xC7: case 0xCF: case 0xD7: case 0xDF: case 0xE7: case 0xEF: case 0xF7: case 0xFF: // RST
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Create a profiler that writes its report to the given path when the emulator stops
+struct Profiler *createProfiler(const char *path, Cpu *cpu) {
+    struct Profiler *profiler = (struct Profiler *) calloc(1, sizeof(struct Profiler));
+    if (!profiler) {
+        printf("Failed to malloc profiler\n");
+        exit(526);
+    }
+    profiler->path = strdup(path);
+    profiler->nodeCapacity = 1024;
+    profiler->nodes = (ProfileNode *) malloc(profiler->nodeCapacity * sizeof(ProfileNode));
+    if (!profiler->path || !profiler->nodes) {
+        printf("Failed to malloc profiler\n");
+        exit(526);
+    }
+    profiler->nodes[0] = (ProfileNode) { 0 };
+    profiler->nodeCount = 1;
+    profiler->frames[0].node = 0;
+    profiler->frames[0].sp = 0xFFFF;
+    profiler->frames[0].interrupt = -1;
+    profiler->startClock = cpu->clock;
+    return profiler;
+}
+
+// Execute the next instruction through the interpreter and count it
+int profileInstruction(Cpu *cpu) {
+    struct Profiler *profiler = cpu->profiler;
+    uint16 pc = cpu->PC;
+    uint16 sp = cpu->SP;
+    uint16 bank = bankOf(pc, cpu);
+    uint8 opcode = readByte(pc, cpu);
+    uint16 index = (opcode == 0xCB) ? 0x100 | readByte(pc + 1, cpu) : opcode;
+    int errNum = executeNextInstruction(cpu);
+    if (errNum) {
+        return errNum;
+    }
+    ProfileCount *location = locationCount(bank, pc, profiler);
+    location->count++;
+    location->cycles += cpu->wait;
+    profiler->opcodes[index].count++;
+    profiler->opcodes[index].cycles += cpu->wait;
+    profiler->instructions++;
+    countCycles(cpu->wait, profiler);
+    // Taken calls push a frame for the function called
+    if (isCall(opcode) && cpu->SP == (uint16) (sp - 2)) {
+        pushFrame((((uint32) bankOf(cpu->PC, cpu)) << 16) | cpu->PC, -1, cpu);
+    } else {
+        popFrames(cpu);
+    }
+    return 0;
+}
+
+// Count an interrupt that has just been entered
+void profileInterrupt(Cpu *cpu) {
+    struct Profiler *profiler = cpu->profiler;
+    int8 interrupt = (cpu->PC - 0x40) / 8;
+    if (cpu->PC < 0x40 || interrupt >= PROFILE_INTERRUPTS) {
+        return;
+    }
+    profiler->interrupts[interrupt].count++;
+    pushFrame(PROFILE_INTERRUPT | cpu->PC, interrupt, cpu);
+    countCycles(cpu->wait, profiler);
+}
+
+// Order by cycles, most first
+static int compareCounts(const ProfileCount *a, const ProfileCount *b) {
+    return (a->cycles < b->cycles) - (a->cycles > b->cycles);
+}
+
+static int compareLocations(const void *a, const void *b) {
+    return compareCounts(&((const ProfileLocation *) a)->count, &((const ProfileLocation *) b)->count);
+}
+
+// Write the instruction at a location, in the same form as the debugger
+static void writeInstruction(uint16 bank, uint16 address, FILE *file, Cpu *cpu) {
+    uint8 opcode = bankByte(bank, address, cpu);
+    uint8 low = bankByte(bank, address + 1, cpu);
+    uint8 high = bankByte(bank, address + 2, cpu);
+    if (opcode == 0xCB) {
+        fprintf(file, "%s", get_cb_opcode(low).name);
+    } else if (opcode_length[opcode] == 1) {
+        fprintf(file, "%s", get_opcode(opcode).name);
+    } else if (opcode_length[opcode] == 2) {
+        fprintf(file, get_opcode(opcode).name, low);
+    } else {
+        fprintf(file, get_opcode(opcode).name, (high << 8) | low);
+    }
+}
+
+// Write a node's name in the folded stacks
+static int nodeName(char *name, size_t size, uint32 key) {
+    if (key == 0) {
+        return snprintf(name, size, "main");
+    } else if (key & PROFILE_INTERRUPT) {
+        return snprintf(name, size, "int_%s", INTERRUPT_NAMES[((key & 0xFFFF) - 0x40) / 8]);
+    }
+    return snprintf(name, size, "%02X:%04X", key >> 16, key & 0xFFFF);
+}
+
+// Write a line for every node in the call tree with cycles of its own, as the semicolon separated
+// names of the calls leading to it, followed by its cycles
+static void writeFolded(uint32 node, char *stack, size_t length, size_t size, FILE *file, struct Profiler *profiler) {
+    if (length) {
+        stack[length++] = ';';
+    }
+    length += nodeName(stack + length, size - length, profiler->nodes[node].key);
+    if (profiler->nodes[node].cycles) {
+        fprintf(file, "%.*s %llu\n", (int) length, stack, (unsigned long long) profiler->nodes[node].cycles);
+    }
+    for (uint32 child = profiler->nodes[node].child; child; child = profiler->nodes[child].sibling) {
+        writeFolded(child, stack, length, size, file, profiler);
+    }
+}
+
+// Write the report, sorted by cycles, and the folded stacks for flamegraph tools to <path>.folded
+void writeProfile(Cpu *cpu) {
+    struct Profiler *profiler = cpu->profiler;
+    FILE *file = fopen(profiler->path, "w");
+    if (!file) {
+        fprintf(stderr, "Error: could not open profile %s\n", profiler->path);
+        return;
+    }
+    uint64 total = cpu->clock - profiler->startClock;
+    double percent = (profiler->cycles) ? 100.0 / profiler->cycles : 0;
+    fprintf(file, "%llu instructions, %llu cycles running, %llu cycles halted\n",
+            (unsigned long long) profiler->instructions, (unsigned long long) profiler->cycles,
+            (unsigned long long) (total - profiler->cycles));
+
+    // Locations
+    uint32 used = 0;
+    for (uint32 page = 0; page < PROFILE_PAGES; page++) {
+        if (profiler->pages[page]) {
+            used++;
+        }
+    }
+    ProfileLocation *locations = (ProfileLocation *) malloc((used * PROFILE_PAGE_SIZE + 1) * sizeof(ProfileLocation));
+    if (!locations) {
+        printf("Failed to malloc profile report\n");
+        exit(526);
+    }
+    uint32 count = 0;
+    for (uint32 page = 0; page < PROFILE_PAGES; page++) {
+        for (uint32 i = 0; profiler->pages[page] && i < PROFILE_PAGE_SIZE; i++) {
+            if (profiler->pages[page][i].count) {
+                locations[count++] = (ProfileLocation) {
+                    .bank = page >> 4,
+                    .address = ((page & 0xF) * PROFILE_PAGE_SIZE) + i,
+                    .count = profiler->pages[page][i]
+                };
+            }
+        }
+    }
+    qsort(locations, count, sizeof(ProfileLocation), compareLocations);
+    fprintf(file, "\nLocations by cycles\n%-10s %12s %14s %7s  %s\n", "bank:pc", "count", "cycles", "%", "instruction");
+    for (uint32 i = 0; i < count && i < PROFILE_TOP_LOCATIONS; i++) {
+        fprintf(file, "%02X:%04X    %12llu %14llu %6.2f%%  ", locations[i].bank, locations[i].address,
+                (unsigned long long) locations[i].count.count, (unsigned long long) locations[i].count.cycles,
+                locations[i].count.cycles * percent);
+        writeInstruction(locations[i].bank, locations[i].address, file, cpu);
+        fprintf(file, "\n");
+    }
+
+    // Opcodes
+    ProfileLocation opcodes[0x200];
+    count = 0;
+    for (uint16 i = 0; i < 0x200; i++) {
+        if (profiler->opcodes[i].count) {
+            opcodes[count++] = (ProfileLocation) { .address = i, .count = profiler->opcodes[i] };
+        }
+    }
+    qsort(opcodes, count, sizeof(ProfileLocation), compareLocations);
+    fprintf(file, "\nOpcodes by cycles\n%-10s %12s %14s %7s  %s\n", "opcode", "count", "cycles", "%", "name");
+    for (uint32 i = 0; i < count; i++) {
+        uint16 opcode = opcodes[i].address;
+        fprintf(file, (opcode & 0x100) ? "CB %02X      " : "%02X         ", opcode & 0xFF);
+        fprintf(file, "%12llu %14llu %6.2f%%  %s\n", (unsigned long long) opcodes[i].count.count,
+                (unsigned long long) opcodes[i].count.cycles, opcodes[i].count.cycles * percent,
+                (opcode & 0x100) ? get_cb_opcode(opcode & 0xFF).name : get_opcode(opcode).name);
+    }
+
+    // Interrupts, including the cycles of their handlers
+    fprintf(file, "\nInterrupts\n%-10s %12s %14s %7s\n", "vector", "count", "cycles", "%");
+    for (uint8 i = 0; i < PROFILE_INTERRUPTS; i++) {
+        fprintf(file, "%02X %-7s %12llu %14llu %6.2f%%\n", 0x40 + (i * 8), INTERRUPT_NAMES[i],
+                (unsigned long long) profiler->interrupts[i].count,
+                (unsigned long long) profiler->interrupts[i].cycles, profiler->interrupts[i].cycles * percent);
+    }
+    fclose(file);
+    free(locations);
+
+    // Folded stacks
+    size_t length = strlen(profiler->path);
+    char *path = (char *) malloc(length + sizeof(".folded"));
+    char stack[PROFILE_MAX_DEPTH * 16];
+    if (!path) {
+        printf("Failed to malloc profile path\n");
+        exit(526);
+    }
+    sprintf(path, "%s.folded", profiler->path);
+    file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "Error: could not open profile %s\n", path);
+    } else {
+        writeFolded(0, stack, 0, sizeof(stack), file, profiler);
+        fclose(file);
+    }
+    free(path);
+}
+
+// Free the profiler
+void freeProfiler(Cpu *cpu) {
+    struct Profiler *profiler = cpu->profiler;
+    for (uint32 page = 0; page < PROFILE_PAGES; page++) {
+        free(profiler->pages[page]);
+    }
+    free(profiler->nodes);
+    free(profiler->path);
+    free(profiler);
+    cpu->profiler = NULL;
+}
@@ -0,0 +1,18 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "../cpu.h"
+#include "../types.h"
+
+// Number of (bank, PC) locations listed in the report
+#define PROFILE_TOP_LOCATIONS 64
+// Deepest call stack followed for the folded stacks
+#define PROFILE_MAX_DEPTH 128
+
+extern struct Profiler *createProfiler(const char *path, Cpu *cpu);
+extern int profileInstruction(Cpu *cpu);
+extern void profileInterrupt(Cpu *cpu);
+extern void writeProfile(Cpu *cpu);
+extern void freeProfiler(Cpu *cpu);
+
+#endif /* PROFILER_H */
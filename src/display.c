@@ -1,255 +1,581 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "types.h"
 #include "memory.h"
 #include "display.h"
-#include "window.h"
+#include "renderer.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 const uint8 COLOURS[] = {0xFF, 0xC0, 0x60, 0x00};
-uint8 backgroundColourOffset[] = {0, 1, 2, 3};
-uint8 spritePaletteZero[] = {0, 1, 2, 3};
-uint8 spritePaletteOne[] = {0, 1, 2, 3};
 
-// Store the un-offset colour of the current scanline.
-// Used to decided whether sprites will draw if they don't have priority
-// Without this, sprites will be invisible on some games
-static uint8 lineBuffer[DISPLAY_WIDTH];
-static uint8 frameBuffer[4 * DISPLAY_WIDTH * DISPLAY_HEIGHT];
-static uint8 tiles[384][8][8];
+// Create the display state
+struct Display *createDisplay() {
+    struct Display *display = (struct Display *) malloc(sizeof(struct Display));
+    if (!display) {
+        printf("Failed to malloc display\n");
+        exit(528);
+    }
+    display->pixelFormat = PIXEL_RGBA8888;
+    return display;
+}
+
+// Bytes per pixel of a pixel format
+uint8 pixelFormatSize(PixelFormat format) {
+    switch (format) {
+        case PIXEL_RGBA8888:
+        case PIXEL_XRGB8888: return 4;
+        case PIXEL_RGB565: return 2;
+        default: return 1;
+    }
+}
+
+// Reset the palettes and clear the frame
+void resetDisplay(Cpu *cpu) {
+    struct Display *display = cpu->display;
+    for (uint8 i = 0; i < 4; i++) {
+        display->backgroundColourOffset[i] = i;
+        display->spritePaletteZero[i] = i;
+        display->spritePaletteOne[i] = i;
+    }
+    memset(display->lineBuffer, 0, sizeof(display->lineBuffer));
+    memset(display->shades, 0, sizeof(display->shades));
+    memset(display->frameBuffer, 0, sizeof(display->frameBuffer));
+    memset(display->tiles, 0, sizeof(display->tiles));
+    memset(display->flippedTiles, 0, sizeof(display->flippedTiles));
+    // Decode everything on the first scanline
+    display->dirtyCount = 0;
+    memset(display->tileDirty, 0, sizeof(display->tileDirty));
+    for (uint16 tile = 0; tile < TILE_COUNT; tile++) {
+        markTileDirty(tile, cpu);
+    }
+    // Draw every map entry again once the tiles are decoded
+    memset(display->tileVersions, 0, sizeof(display->tileVersions));
+    memset(display->mapTileVersions, 0, sizeof(display->mapTileVersions));
+    memset(display->mapRowVersions, 0, sizeof(display->mapRowVersions));
+    display->vramVersion = 1;
+    display->oamVersion = 0;
+    memset(display->lineInputs, 0, sizeof(display->lineInputs));
+    memset(display->frameLinesChanged, 0, sizeof(display->frameLinesChanged));
+    markFrameChanged(cpu);
+    display->windowLine = 0;
+    display->rendering = true;
+    display->renderFrames = true;
+    display->renderThreaded = false;
+    markSpritesDirty(cpu);
+}
 
 // Update colour palette for the background
-void updateBackgroundColour(uint8 value) {
+void updateBackgroundColour(uint8 value, Cpu *cpu) {
     for (uint8 i = 0; i < 4; i++) {
         // Mask the two bits to get the background colour set
-        backgroundColourOffset[i] = (value >> (i * 2)) & 0b11;
+        cpu->display->backgroundColourOffset[i] = (value >> (i * 2)) & 0b11;
     }
 }
 
 // Update colour palette for the sprites
-void updateSpritePalette(uint8 palette, uint8 value) {
+void updateSpritePalette(uint8 palette, uint8 value, Cpu *cpu) {
     for (uint8 i = 0; i < 4; i++) {
         // Mask the two bits to get the background colour set
         if (palette) { // palette 1
-            spritePaletteOne[i] = (value >> (i * 2)) & 0b11;
+            cpu->display->spritePaletteOne[i] = (value >> (i * 2)) & 0b11;
         } else { // pallete 0
-            spritePaletteZero[i] = (value >> (i * 2)) & 0b11;
+            cpu->display->spritePaletteZero[i] = (value >> (i * 2)) & 0b11;
+        }
+    }
+}
+
+// Queue a tile to be decoded again after its data in vram is written
+void markTileDirty(uint16 tile, Cpu *cpu) {
+    struct Display *display = cpu->display;
+    display->vramVersion++;
+    if (!display->tileDirty[tile]) {
+        display->tileDirty[tile] = true;
+        display->dirtyTiles[display->dirtyCount++] = tile;
+    }
+}
+
+// Note a change to a background map entry, so the map images are checked against it
+void markMapDirty(Cpu *cpu) {
+    cpu->display->vramVersion++;
+}
+
+// Rebuild the sprite lists before the next scanline after OAM is written
+void markSpritesDirty(Cpu *cpu) {
+    cpu->display->spritesDirty = true;
+    cpu->display->oamVersion++;
+}
+
+// Treat every line as changed in the next frame, and convert all of it, for when the frame buffers no longer
+// hold what the frontend was last passed
+void markFrameChanged(Cpu *cpu) {
+    struct Display *display = cpu->display;
+    memset(display->linesChanged, true, sizeof(display->linesChanged));
+    display->convertedFormat = PIXEL_SHADES;
+}
+
+// Note which lines changed in the frame about to be passed to the frontend, and start counting again
+void finishFrameChanges(Cpu *cpu) {
+    struct Display *display = cpu->display;
+    memcpy(display->frameLinesChanged, display->linesChanged, sizeof(display->linesChanged));
+    memset(display->linesChanged, false, sizeof(display->linesChanged));
+}
+
+// Fill in which lines of the last frame passed to the frontend changed from the one passed before it, if lines
+// isn't NULL, and return whether any did
+bool frameChanges(bool *lines, Cpu *cpu) {
+    struct Display *display = cpu->display;
+    if (lines) {
+        memcpy(lines, display->frameLinesChanged, sizeof(display->frameLinesChanged));
+    }
+    for (uint8 line = 0; line < DISPLAY_HEIGHT; line++) {
+        if (display->frameLinesChanged[line]) {
+            return true;
         }
     }
+    return false;
 }
 
-// Load all tiles. 384 in total as set 0 overlaps set 1 by 128 tiles.
+// Decoded tile rows for each bitplane byte. Byte x of an entry is the bit for pixel x (bit 7 - x),
+// so a row's shades are the low plane's entry ORed with the high plane's shifted up by one.
+#define TILE_ROW_BITS(v) ((((v) >> 7) & 1ULL) | ((((v) >> 6) & 1ULL) << 8) | ((((v) >> 5) & 1ULL) << 16) | \
+                          ((((v) >> 4) & 1ULL) << 24) | ((((v) >> 3) & 1ULL) << 32) | ((((v) >> 2) & 1ULL) << 40) | \
+                          ((((v) >> 1) & 1ULL) << 48) | (((v) & 1ULL) << 56))
+// The same mirrored on x, where byte x is bit x
+#define TILE_ROW_BITS_FLIPPED(v) (((v) & 1ULL) | ((((v) >> 1) & 1ULL) << 8) | ((((v) >> 2) & 1ULL) << 16) | \
+                                  ((((v) >> 3) & 1ULL) << 24) | ((((v) >> 4) & 1ULL) << 32) | \
+                                  ((((v) >> 5) & 1ULL) << 40) | ((((v) >> 6) & 1ULL) << 48) | ((((v) >> 7) & 1ULL) << 56))
+#define TILE_ROW_4(f, v) f(v), f((v) + 1), f((v) + 2), f((v) + 3)
+#define TILE_ROW_16(f, v) TILE_ROW_4(f, v), TILE_ROW_4(f, (v) + 4), TILE_ROW_4(f, (v) + 8), TILE_ROW_4(f, (v) + 12)
+#define TILE_ROW_64(f, v) TILE_ROW_16(f, v), TILE_ROW_16(f, (v) + 16), TILE_ROW_16(f, (v) + 32), TILE_ROW_16(f, (v) + 48)
+#define TILE_ROW_256(f) TILE_ROW_64(f, 0), TILE_ROW_64(f, 64), TILE_ROW_64(f, 128), TILE_ROW_64(f, 192)
+static const uint64 TILE_ROWS[256] = {TILE_ROW_256(TILE_ROW_BITS)};
+static const uint64 TILE_ROWS_FLIPPED[256] = {TILE_ROW_256(TILE_ROW_BITS_FLIPPED)};
+// The low bit of each pixel in a row
+#define PIXEL_LOW_BITS 0x0101010101010101ULL
+
+// Decode the tiles written since they were last decoded
 void loadTiles(Cpu *cpu) {
+    struct Display *display = cpu->display;
     uint8 *vram = cpu->memory.vramBank;
-    for (int tileNum = 0; tileNum < 384; tileNum++) {
+    for (uint16 i = 0; i < display->dirtyCount; i++) {
+        uint16 tileNum = display->dirtyTiles[i];
+        display->tileDirty[tileNum] = false;
+        uint8 *data = vram + tileNum*16;
         for (int y = 0; y < 8; y++) {
-            uint8 byteLow = *(vram + 2*y + tileNum*16);
-            uint8 byteHigh = *(vram + 2*y + 1 + tileNum*16);
-            for (int x = 0; x < 8; x++) {
-                tiles[tileNum][x][y] = ((byteLow & 0x80) >> 7) | ((byteHigh & 0x80) >> 6);
-                byteLow <<= 1;
-                byteHigh <<= 1;
+            // All 8 pixels of the row at once
+            uint64 row = TILE_ROWS[data[2*y]] | (TILE_ROWS[data[2*y + 1]] << 1);
+            memcpy(display->tiles[tileNum][y], &row, sizeof(row));
+            row = TILE_ROWS_FLIPPED[data[2*y]] | (TILE_ROWS_FLIPPED[data[2*y + 1]] << 1);
+            memcpy(display->flippedTiles[tileNum][y], &row, sizeof(row));
+        }
+        display->tileVersions[tileNum]++;
+    }
+    display->dirtyCount = 0;
+}
+
+// Get line y of a background map's image, drawn with a tile set. If vram has changed since the row of tiles it's
+// in was last checked, the map entries whose tile number or tile data have changed are drawn again first.
+static uint8 *loadMapLine(bool map, bool tileSet, uint8 y, Cpu *cpu) {
+    struct Display *display = cpu->display;
+    uint8 image = map * 2 + tileSet;
+    uint8 row = y >> 3;
+    if (display->mapRowVersions[image][row] != display->vramVersion) {
+        uint16 mapLocation = ((map) ? BG_MAP_DATA2_BASE : BG_MAP_DATA1_BASE) - VRAM_BASE;
+        uint8 *mapRow = cpu->memory.vramBank + mapLocation + (row << 5);
+        for (uint8 column = 0; column < 32; column++) {
+            uint16 tile = mapRow[column];
+            // Tile set 0 is numbered -128 to 128. In tiles array it takes index 128 to 383.
+            if (!tileSet) {
+                tile = ((int8) tile) + 256;
+            }
+            uint16 entry = (row << 5) + column;
+            if (display->mapTiles[image][entry] != tile ||
+                display->mapTileVersions[image][entry] != display->tileVersions[tile]) {
+                display->mapTiles[image][entry] = tile;
+                display->mapTileVersions[image][entry] = display->tileVersions[tile];
+                for (uint8 i = 0; i < 8; i++) {
+                    memcpy(&display->mapImages[image][(row << 3) + i][column << 3], display->tiles[tile][i], 8);
+                }
             }
         }
+        display->mapRowVersions[image][row] = display->vramVersion;
+    }
+    return display->mapImages[image][y];
+}
+
+// Shade the line buffer from start onwards into the frame with the background palette
+static void drawBackgroundPixels(uint8 scanLine, uint16 start, Cpu *cpu) {
+    struct Display *display = cpu->display;
+    uint8 *shade = display->shades + DISPLAY_WIDTH * scanLine;
+    for (uint16 i = start; i < DISPLAY_WIDTH; i++) {
+        shade[i] = display->backgroundColourOffset[display->lineBuffer[i]];
     }
 }
 
 // Load Background into framebuffer
 static void loadBackgroundLine(uint8 scanLine, bool tileSet, Cpu *cpu) {
+    struct Display *display = cpu->display;
     // Check if background enabled
     if (readBit(0, &cpu->memory.io[LCDC - IO_BASE])) {
-        // Select map location
-        uint16 mapLocation = (readBit(3, &cpu->memory.io[LCDC - IO_BASE])) ? BG_MAP_DATA2_BASE : BG_MAP_DATA1_BASE;
-        mapLocation -= VRAM_BASE;
-        // Draw tileset onto the window
-        // Wrap the y offset at 32 to wrap the background vertically. Map is 32x32. Same for xOffset below.
-        uint16 yOffset = (((scanLine + cpu->memory.io[SCROLL_Y - IO_BASE]) >> 3) % 32) << 5;
-        uint16 xOffset = (cpu->memory.io[SCROLL_X - IO_BASE] >> 3) % 32;
-        short x = cpu->memory.io[SCROLL_X - IO_BASE] % 8;
-        short y = (scanLine + cpu->memory.io[SCROLL_Y - IO_BASE]) % 8;
-        uint16 tile = cpu->memory.vramBank[mapLocation + xOffset + yOffset];
-        // Tile set 0 is numbered -128 to 128. In tiles array it takes index 128 to 383.
-        if (!tileSet) {
-            tile = ((int8) tile) + 256;
-        }
-        // Pixel offset for the current scanline
-        uint16 drawOffset = DISPLAY_WIDTH * scanLine;
-        // Put data in framebuffer
-        for (uint16 i = 0; i < DISPLAY_WIDTH; i++) {
-            uint8 colour = tiles[tile][x][y];
-            frameBuffer[(drawOffset + i)*4 + 0] = COLOURS[backgroundColourOffset[colour]];
-            frameBuffer[(drawOffset + i)*4 + 1] = COLOURS[backgroundColourOffset[colour]];
-            frameBuffer[(drawOffset + i)*4 + 2] = COLOURS[backgroundColourOffset[colour]];
-            frameBuffer[(drawOffset + i)*4 + 3] = 0xFF;
-            lineBuffer[i] = colour;
-            x++;
-            // Tile completed, draw next one.
-            if (x == 8) {
-                x = 0;
-                xOffset = (xOffset + 1) % 32; // Wrap the x offset at 32 to wrap background horizonally. See above.
-                tile = cpu->memory.vramBank[mapLocation + xOffset + yOffset];
-                // Tile set 0 is numbered -128 to 128. In tiles array it takes index 128 to 383.
-                if (!tileSet) {
-                    tile = ((int8) tile) + 256;
-                }
-            }
+        // Select map location. The y offset wraps at the bottom of the map.
+        bool map = readBit(3, &cpu->memory.io[LCDC - IO_BASE]);
+        uint8 *line = loadMapLine(map, tileSet, scanLine + cpu->memory.io[SCROLL_Y - IO_BASE], cpu);
+        // Copy from the x offset, wrapping at the right of the map
+        uint8 scrollX = cpu->memory.io[SCROLL_X - IO_BASE];
+        uint16 count = MAP_SIZE - scrollX;
+        if (count > DISPLAY_WIDTH) {
+            count = DISPLAY_WIDTH;
         }
+        memcpy(display->lineBuffer, line + scrollX, count);
+        memcpy(display->lineBuffer + count, line, DISPLAY_WIDTH - count);
+        drawBackgroundPixels(scanLine, 0, cpu);
     } else { // Clear screen if no background
-        short drawOffset = DISPLAY_WIDTH * scanLine;
-        for (uint16 i = 0; i < DISPLAY_WIDTH; i++) {
-            frameBuffer[(drawOffset + i)*4 + 0] = 0xFF;
-            frameBuffer[(drawOffset + i)*4 + 1] = 0xFF;
-            frameBuffer[(drawOffset + i)*4 + 2] = 0xFF;
-            frameBuffer[(drawOffset + i)*4 + 3] = 0xFF;
-            lineBuffer[i] = 0;
-        }
+        memset(display->lineBuffer, 0, sizeof(display->lineBuffer));
+        memset(display->shades + DISPLAY_WIDTH * scanLine, 0, DISPLAY_WIDTH);
     }
 }
 
-// Current window line. GB can pause the display of a window and restart at the same line somewhere down
-// the screen. This allows for split UIs among other things.
-static uint8 display_window_line = 0;
-
 // Set window line to 0.
-void resetWindowLine() {
-    display_window_line = 0;
+void resetWindowLine(Cpu *cpu) {
+    cpu->display->windowLine = 0;
+}
+
+// Start rendering the next frame, or skip it, as the frontend last asked
+void startFrame(Cpu *cpu) {
+    cpu->display->rendering = cpu->display->renderFrames;
 }
 
 // Load window into frameBuffer
+// Check if the window is enabled and shows on a line
+static bool windowOnLine(uint8 scanLine, Cpu *cpu) {
+    int16 windowX = cpu->memory.io[WINDOW_X - IO_BASE] - 7;
+    uint8 windowY = cpu->memory.io[WINDOW_Y - IO_BASE];
+    // Not if the window is below, or off screen
+    return readBit(5, &cpu->memory.io[LCDC - IO_BASE]) && scanLine >= windowY && windowX <= 159 && windowY <= 143;
+}
+
 static void loadWindowLine(uint8 scanLine, bool tileSet, Cpu *cpu) {
-    // Check if window is enabled
-    if (readBit(5, &cpu->memory.io[LCDC - IO_BASE])) {
+    struct Display *display = cpu->display;
+    if (windowOnLine(scanLine, cpu)) {
         int16 windowX = cpu->memory.io[WINDOW_X - IO_BASE] - 7;
-        uint8 windowY = cpu->memory.io[WINDOW_Y - IO_BASE];
-        // Skip line if the window is below, or off screen
-        if (scanLine < windowY || windowX > 159 || windowY > 143) {
-            return;
-        }
-        uint16 mapLocation = (readBit(6, &cpu->memory.io[LCDC - IO_BASE])) ? BG_MAP_DATA2_BASE : BG_MAP_DATA1_BASE;
-        mapLocation -= VRAM_BASE;
-        // Draw tileset onto the window
-        uint16 xOffset = windowX >> 3;
-        uint16 yOffset = (display_window_line >> 3) << 5;
-        short x = 0;
-        short y = display_window_line % 8;
-        uint16 tile = cpu->memory.vramBank[mapLocation + xOffset + yOffset];
-        // Tile set 0 is numbered -128 to 128. In tiles array it takes index 128 to 383.
-        if (!tileSet) {
-            tile = ((int8) tile) + 256;
-        }
-        short drawOffset = DISPLAY_WIDTH * scanLine;
-        for (int16 i = windowX; i < DISPLAY_WIDTH; i++) {
-            if (i >= 0) {
-                uint8 colour = tiles[tile][x][y];
-                frameBuffer[(drawOffset + i)*4 + 0] = COLOURS[backgroundColourOffset[colour]];
-                frameBuffer[(drawOffset + i)*4 + 1] = COLOURS[backgroundColourOffset[colour]];
-                frameBuffer[(drawOffset + i)*4 + 2] = COLOURS[backgroundColourOffset[colour]];
-                frameBuffer[(drawOffset + i)*4 + 3] = 0xFF;
-                lineBuffer[i] = colour;
+        bool map = readBit(6, &cpu->memory.io[LCDC - IO_BASE]);
+        uint8 *line = loadMapLine(map, tileSet, display->windowLine, cpu);
+        // The window map starts at its left edge, which can be up to 7 pixels off screen
+        uint16 start = (windowX < 0) ? 0 : windowX;
+        uint8 skip = (windowX < 0) ? -windowX : 0;
+        memcpy(display->lineBuffer + start, line + skip, DISPLAY_WIDTH - start);
+        drawBackgroundPixels(scanLine, start, cpu);
+        display->windowLine++;
+    }
+}
+
+// Select the sprites drawn on each line from OAM. Like the DMG, a line takes the first 10 sprites in OAM that
+// cover it, whatever their x. Where they overlap, the one with the lower x is on top, then the one earlier in OAM.
+static void loadSpriteLists(uint8 height, Cpu *cpu) {
+    struct Display *display = cpu->display;
+    memset(display->lineSpriteCount, 0, sizeof(display->lineSpriteCount));
+    for (uint8 sprite = 0; sprite < SPRITE_COUNT; sprite++) {
+        // y coord. Offset by -16
+        int16 spriteY = cpu->memory.oam[sprite * 4] - 16;
+        uint8 spriteX = cpu->memory.oam[sprite * 4 + 1];
+        int16 first = (spriteY < 0) ? 0 : spriteY;
+        int16 last = (spriteY + height > DISPLAY_HEIGHT) ? DISPLAY_HEIGHT : spriteY + height;
+        for (int16 line = first; line < last; line++) {
+            uint8 count = display->lineSpriteCount[line];
+            if (count == SPRITES_PER_LINE) {
+                continue;
             }
-            x++;
-            if (x == 8) {
-                x = 0;
-                xOffset += 1;
-                tile = cpu->memory.vramBank[mapLocation + xOffset + yOffset];
-                // Tile set 0 is numbered -128 to 128. In tiles array it takes index 128 to 383.
-                if (!tileSet) {
-                    tile = ((int8) tile) + 256;
-                }
+            // Insert by x. Sprites already listed are earlier in OAM, so stay ahead on a tie.
+            uint8 *list = display->lineSprites[line];
+            uint8 i = count;
+            while (i > 0 && cpu->memory.oam[list[i - 1] * 4 + 1] > spriteX) {
+                list[i] = list[i - 1];
+                i--;
             }
+            list[i] = sprite;
+            display->lineSpriteCount[line] = count + 1;
         }
-        display_window_line++;
     }
+    display->spriteHeight = height;
+    display->spritesDirty = false;
 }
 
 // Add spites onto the current scanline in framebuffer
 static void loadSpriteLine(uint8 scanLine, Cpu *cpu) {
+    struct Display *display = cpu->display;
     // Check if sprites enabled
-    if (readBit(1, &cpu->memory.io[LCDC - IO_BASE])) {
-        // Check if 8 or 16 pixels high
-        bool sprite8x16 = (readBit(2, &cpu->memory.io[LCDC - IO_BASE]));
-        // Iterate through all sprites data in OAM
-        for (uint8 sprite = 0; sprite < 40; sprite++) {
-            // 4 bytes per sprite data.
-            // First byte is y, second is x, third is title number, fourth is attributes
-            uint16 spriteOffset = sprite * 4;
-
-            // y coord. Offset by -16
-            int16 spriteY = cpu->memory.oam[spriteOffset] - 16;
-            // x coord. Offset by -8
-            int16 spriteX = cpu->memory.oam[spriteOffset + 1] - 8;
-            // Tile number
-            uint8 tile = cpu->memory.oam[spriteOffset + 2];
-            // Attributes
-            uint8 attributes = cpu->memory.oam[spriteOffset + 3];
-
-            // Get attributes
-            bool flipX = readBit(5, &attributes);
-            bool flipY = readBit(6, &attributes);
-            bool priority = readBit(7, &attributes);
-            bool palette = readBit(4, &attributes);
-
-            // Set sprite height based on the LCDC bit
-            uint8 height = (sprite8x16) ? 16 : 8;
-
-            //fprintf(stdout, "x: 0x%X y: 0x%X tile: 0x%X attrubutes: 0x%X\n", spriteX, spriteY, tile, attributes);
-            //fprintf(stdout, "C: 0x%X\n", cpu->registers.C);
-
-            // Check if sprite is on this line number
-            if ((scanLine >= spriteY) && (scanLine < (spriteY + height))) {
-                short drawOffset = DISPLAY_WIDTH * scanLine;
-                uint8 y = scanLine - spriteY;
-                // Correct for 8x16 sprites. When not mirrored on y, move to next tile if y > 7. When mirrored move to next tile for y <= 7.
-                // This corrects for mirroring the sprite in halfs. Eg 1234 becomes 4321 not 2143.
-                if (sprite8x16 && ((flipY && y <= 7) || (!flipY && y > 7))) {
-                    tile++;
-                }
-                y %= 8;
-                //printf("x: %d y: %d \n", spriteX, y);
-                // Iterate over the length of the title
-                for (uint8 x = 0; x < 8; x++) {
-                    //printf("POS: %d x: %d sx: %d\n", x + spriteX, x, spriteX);
-                    // Skip pixel if off screen
-                    if (x + spriteX < 0 || x + spriteX > 159) {
-                        //printf("POS: %d x: %d sx: %d\n", x + spriteX, x, spriteX);
-                        continue;
-                    }
-                    // Switch tile for 8x16 sprite
-                    uint8 drawX = (flipX) ? 7 - x : x;
-                    uint8 drawY = (flipY) ? 7 - y : y;
-
-                    uint8 colour = tiles[tile][drawX][drawY];
-                    // Skip clear pixels
-                    if (!colour) {
-                        continue;
-                    }
-                    colour = (palette) ?  spritePaletteOne[tiles[tile][drawX][drawY]] : spritePaletteZero[tiles[tile][drawX][drawY]];
-                    if (!priority || !lineBuffer[x + spriteX]) {
-                        frameBuffer[(drawOffset + x + spriteX)*4 + 0] = COLOURS[colour];
-                        frameBuffer[(drawOffset + x + spriteX)*4 + 1] = COLOURS[colour];
-                        frameBuffer[(drawOffset + x + spriteX)*4 + 2] = COLOURS[colour];
-                        frameBuffer[(drawOffset + x + spriteX)*4 + 3] = 0xFF;
-                    }
-                }
-            } else {
-                //fprintf(stdout, "x: 0x%X y: 0x%X tile: 0x%X attrubutes: 0x%X\n", spriteX, spriteY, tile, attributes);
-            }
+    if (!readBit(1, &cpu->memory.io[LCDC - IO_BASE])) {
+        return;
+    }
+    // Check if 8 or 16 pixels high
+    bool sprite8x16 = (readBit(2, &cpu->memory.io[LCDC - IO_BASE]));
+    uint8 height = (sprite8x16) ? 16 : 8;
+    if (display->spritesDirty || display->spriteHeight != height) {
+        loadSpriteLists(height, cpu);
+    }
+    uint8 count = display->lineSpriteCount[scanLine];
+    if (!count) {
+        return;
+    }
+    // Sprite rows are merged 8 pixels at a time into a copy of the line. It's padded by a tile either side,
+    // which is where the x coord's offset of 8 puts them, so sprites partly off screen need no clipping.
+    uint8 line[DISPLAY_WIDTH + 16] = {0};
+    uint8 background[DISPLAY_WIDTH + 16] = {0};
+    // Pixels already covered by a higher priority sprite. A sprite behind the background still hides those
+    // below it, even where the background shows through.
+    uint8 covered[DISPLAY_WIDTH + 16] = {0};
+    uint8 *shades = &display->shades[DISPLAY_WIDTH * scanLine];
+    memcpy(line + 8, shades, DISPLAY_WIDTH);
+    memcpy(background + 8, display->lineBuffer, DISPLAY_WIDTH);
+    for (uint8 i = 0; i < count; i++) {
+        // 4 bytes per sprite data.
+        // First byte is y, second is x, third is title number, fourth is attributes
+        uint16 spriteOffset = display->lineSprites[scanLine][i] * 4;
+
+        // y coord. Offset by -16
+        int16 spriteY = cpu->memory.oam[spriteOffset] - 16;
+        // x coord. Offset by 8, the same as the padding
+        uint8 spriteX = cpu->memory.oam[spriteOffset + 1];
+        if (spriteX >= DISPLAY_WIDTH + 8) {
+            continue;
         }
+        // Tile number
+        uint8 tile = cpu->memory.oam[spriteOffset + 2];
+        // Attributes
+        uint8 attributes = cpu->memory.oam[spriteOffset + 3];
+
+        // Get attributes
+        bool flipX = readBit(5, &attributes);
+        bool flipY = readBit(6, &attributes);
+        bool priority = readBit(7, &attributes);
+        bool palette = readBit(4, &attributes);
+
+        uint8 y = scanLine - spriteY;
+        // Correct for 8x16 sprites. When not mirrored on y, move to next tile if y > 7. When mirrored move to next tile for y <= 7.
+        // This corrects for mirroring the sprite in halfs. Eg 1234 becomes 4321 not 2143.
+        if (sprite8x16 && ((flipY && y <= 7) || (!flipY && y > 7))) {
+            tile++;
+        }
+        y %= 8;
+        uint64 row;
+        memcpy(&row, ((flipX) ? display->flippedTiles : display->tiles)[tile][(flipY) ? 7 - y : y], sizeof(row));
+        // Split the shades into their low and high bits, then make masks of the pixels to draw
+        uint64 low = row & PIXEL_LOW_BITS;
+        uint64 high = (row >> 1) & PIXEL_LOW_BITS;
+        uint64 opaque = (low | high) * 0xFF;
+        uint64 drawn;
+        memcpy(&drawn, covered + spriteX, sizeof(drawn));
+        uint64 show = opaque & ~drawn;
+        drawn |= opaque;
+        memcpy(covered + spriteX, &drawn, sizeof(drawn));
+        if (priority) {
+            uint64 behind;
+            memcpy(&behind, background + spriteX, sizeof(behind));
+            show &= ~(((behind | (behind >> 1)) & PIXEL_LOW_BITS) * 0xFF);
+        }
+        if (!show) {
+            continue;
+        }
+        // Apply the palette to each shade
+        uint8 *spritePalette = (palette) ? display->spritePaletteOne : display->spritePaletteZero;
+        uint64 colour = (low & ~high) * spritePalette[1] | (high & ~low) * spritePalette[2] |
+                        (low & high) * spritePalette[3];
+        uint64 pixels;
+        memcpy(&pixels, line + spriteX, sizeof(pixels));
+        pixels = (pixels & ~show) | (colour & show);
+        memcpy(line + spriteX, &pixels, sizeof(pixels));
     }
+    memcpy(shades, line + 8, DISPLAY_WIDTH);
 }
 
 // Load scanline into the frame buffer
 void loadScanline(Cpu *cpu) {
+    struct Display *display = cpu->display;
     uint8 scanLine = cpu->memory.io[SCANLINE - IO_BASE];
+    // Leave the line as it is if nothing it's drawn from has changed since it was drawn
+    static const uint16 LINE_REGISTERS[8] = {
+        LCDC, SCROLL_Y, SCROLL_X, BG_PALETTE, SP_PALETTE_0, SP_PALETTE_1, WINDOW_Y, WINDOW_X
+    };
+    LineInputs inputs;
+    memset(&inputs, 0, sizeof(inputs));
+    inputs.vramVersion = display->vramVersion;
+    inputs.oamVersion = display->oamVersion;
+    for (uint8 i = 0; i < 8; i++) {
+        inputs.registers[i] = cpu->memory.io[LINE_REGISTERS[i] - IO_BASE];
+    }
+    inputs.windowLine = display->windowLine;
+    inputs.drawn = true;
+    if (!memcmp(&inputs, &display->lineInputs[scanLine], sizeof(inputs))) {
+        if (windowOnLine(scanLine, cpu)) {
+            display->windowLine++;
+        }
+        return;
+    }
+    display->lineInputs[scanLine] = inputs;
+
+    uint8 *shades = display->shades + DISPLAY_WIDTH * scanLine;
+    uint8 previous[DISPLAY_WIDTH];
+    memcpy(previous, shades, DISPLAY_WIDTH);
     bool tileSet = readBit(4, &cpu->memory.io[LCDC - IO_BASE]);
+    // Bring tiles written since the last scanline up to date, so mid-frame changes show
+    if (display->dirtyCount) {
+        loadTiles(cpu);
+    }
     loadBackgroundLine(scanLine, tileSet, cpu);
     loadWindowLine(scanLine, tileSet, cpu);
     loadSpriteLine(scanLine, cpu);
+    if (memcmp(previous, shades, DISPLAY_WIDTH)) {
+        display->linesChanged[scanLine] = true;
+    }
+}
+
+// The colour of each shade in a pixel format, in host byte order
+uint32 shadeColour(uint8 shade, PixelFormat format) {
+    uint8 grey = COLOURS[shade];
+    switch (format) {
+        case PIXEL_RGBA8888: {
+            uint8 bytes[4] = {grey, grey, grey, 0xFF};
+            uint32 colour;
+            memcpy(&colour, bytes, sizeof(colour));
+            return colour;
+        }
+        case PIXEL_XRGB8888: return 0xFF000000 | (grey << 16) | (grey << 8) | grey;
+        case PIXEL_RGB565: return ((grey >> 3) << 11) | ((grey >> 2) << 5) | (grey >> 3);
+        default: return grey;
+    }
 }
 
-// Draw framebuffer to screen
+#ifdef __SSE2__
+// Pick the palette entry matching each lane's shade, given a mask of the lanes holding each shade
+static inline __m128i selectShades(const __m128i *masks, const __m128i *palette) {
+    return _mm_or_si128(_mm_or_si128(_mm_and_si128(masks[0], palette[0]), _mm_and_si128(masks[1], palette[1])),
+                        _mm_or_si128(_mm_and_si128(masks[2], palette[2]), _mm_and_si128(masks[3], palette[3])));
+}
+#endif
+
+// Convert lines of shades into a pixel format, 16 pixels at a time. Each line is written pitch bytes after the last.
+void convertShades(const uint8 *shades, uint8 lines, PixelFormat format, uint8 *pixels, uint32 pitch) {
+    uint8 size = pixelFormatSize(format);
+    uint32 colours[4];
+    for (uint8 shade = 0; shade < 4; shade++) {
+        colours[shade] = shadeColour(shade, format);
+    }
+#ifdef __SSE2__
+    __m128i palette[4];
+    for (uint8 shade = 0; shade < 4; shade++) {
+        palette[shade] = (size == 4) ? _mm_set1_epi32(colours[shade]) :
+                         (size == 2) ? _mm_set1_epi16(colours[shade]) : _mm_set1_epi8(colours[shade]);
+    }
+    for (uint8 line = 0; line < lines; line++) {
+        __m128i *out = (__m128i *) (pixels + line * pitch);
+        for (uint32 i = line * DISPLAY_WIDTH; i < (line + 1) * DISPLAY_WIDTH; i += 16) {
+            __m128i sixteen = _mm_loadu_si128((const __m128i *) (shades + i));
+            __m128i masks[4];
+            for (uint8 shade = 0; shade < 4; shade++) {
+                masks[shade] = _mm_cmpeq_epi8(sixteen, _mm_set1_epi8(shade));
+            }
+            if (size == 1) {
+                _mm_storeu_si128(out++, selectShades(masks, palette));
+                continue;
+            }
+            // Widen the byte masks to the pixel size, keeping pixel order
+            __m128i low[4], high[4];
+            for (uint8 shade = 0; shade < 4; shade++) {
+                low[shade] = _mm_unpacklo_epi8(masks[shade], masks[shade]);
+                high[shade] = _mm_unpackhi_epi8(masks[shade], masks[shade]);
+            }
+            if (size == 2) {
+                _mm_storeu_si128(out++, selectShades(low, palette));
+                _mm_storeu_si128(out++, selectShades(high, palette));
+                continue;
+            }
+            __m128i quarter[4];
+            for (uint8 shade = 0; shade < 4; shade++) {
+                quarter[shade] = _mm_unpacklo_epi16(low[shade], low[shade]);
+            }
+            _mm_storeu_si128(out++, selectShades(quarter, palette));
+            for (uint8 shade = 0; shade < 4; shade++) {
+                quarter[shade] = _mm_unpackhi_epi16(low[shade], low[shade]);
+            }
+            _mm_storeu_si128(out++, selectShades(quarter, palette));
+            for (uint8 shade = 0; shade < 4; shade++) {
+                quarter[shade] = _mm_unpacklo_epi16(high[shade], high[shade]);
+            }
+            _mm_storeu_si128(out++, selectShades(quarter, palette));
+            for (uint8 shade = 0; shade < 4; shade++) {
+                quarter[shade] = _mm_unpackhi_epi16(high[shade], high[shade]);
+            }
+            _mm_storeu_si128(out++, selectShades(quarter, palette));
+        }
+    }
+#else
+    for (uint8 line = 0; line < lines; line++) {
+        uint8 *out = pixels + line * pitch;
+        for (uint16 x = 0; x < DISPLAY_WIDTH; x++) {
+            uint32 colour = colours[shades[line * DISPLAY_WIDTH + x]];
+            if (size == 4) {
+                memcpy(out + x * 4, &colour, 4);
+            } else if (size == 2) {
+                uint16 half = colour;
+                memcpy(out + x * 2, &half, 2);
+            } else {
+                out[x] = colour;
+            }
+        }
+    }
+#endif
+}
+
+// Convert the frame's shades into the pixel format the frontend asked for. Runs of lines that haven't changed
+// since the last conversion are skipped, unless the format has.
+void convertFrame(Cpu *cpu) {
+    struct Display *display = cpu->display;
+    PixelFormat format = display->pixelFormat;
+    uint32 pitch = DISPLAY_WIDTH * pixelFormatSize(format);
+    bool all = (format != display->convertedFormat);
+    display->convertedFormat = format;
+    for (uint8 line = 0; line < DISPLAY_HEIGHT;) {
+        if (!all && !display->frameLinesChanged[line]) {
+            line++;
+            continue;
+        }
+        uint8 end = line + 1;
+        while (end < DISPLAY_HEIGHT && (all || display->frameLinesChanged[end])) {
+            end++;
+        }
+        convertShades(display->shades + line * DISPLAY_WIDTH, end - line, format, display->frameBuffer + line * pitch,
+                      pitch);
+        line = end;
+    }
+}
+
+// Pass the frame to the frontend, converted to its pixel format
 void draw(Cpu *cpu) {
-    //loadTiles(cpu);
-    //for (uint8 i = 0; i < DISPLAY_HEIGHT; i++) {
-        //loadScanline(i, cpu);
-    //}
-    displayOnWindow(frameBuffer);
+    if (cpu->renderer) {
+        // The frame is drawn on the renderer's thread
+        drawRendererFrame(cpu);
+        return;
+    }
+    if (cpu->display->rendering) {
+        finishFrameChanges(cpu);
+        if (cpu->display->pixelFormat != PIXEL_SHADES) {
+            convertFrame(cpu);
+        }
+    }
+    if (cpu->videoCallback) {
+        if (!cpu->display->rendering) {
+            // Nothing was drawn, but the frontend still counts the frame
+            cpu->videoCallback(NULL, cpu->callbackData);
+        } else if (cpu->display->pixelFormat == PIXEL_SHADES) {
+            cpu->videoCallback(cpu->display->shades, cpu->callbackData);
+        } else {
+            cpu->videoCallback(cpu->display->frameBuffer, cpu->callbackData);
+        }
+    }
+    if (cpu->display->renderThreaded) {
+        startRenderer(cpu);
+    }
 }
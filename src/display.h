@@ -6,12 +6,108 @@
 
 #define DISPLAY_HEIGHT 144
 #define DISPLAY_WIDTH 160
+// Tiles in vram. Set 0 overlaps set 1 by 128 tiles.
+#define TILE_COUNT 384
+// Sprites in OAM, and the most the display can draw on one line
+#define SPRITE_COUNT 40
+#define SPRITES_PER_LINE 10
+// Background maps are 32x32 tiles, giving a 256x256 pixel image. There's an image for each map with each tile set.
+#define MAP_SIZE 256
+#define MAP_IMAGES 4
 
-extern void updateBackgroundColour(uint8 value);
-extern void updateSpritePalette(uint8 palette, uint8 value);
-extern void resetWindowLine();
+// Formats a finished frame can be passed to the frontend in
+typedef enum {
+    PIXEL_RGBA8888, // R, G, B and A bytes. The default.
+    PIXEL_XRGB8888, // 32-bit 0xFFRRGGBB in host byte order
+    PIXEL_RGB565,   // 16-bit in host byte order
+    PIXEL_GREY8,    // One grey byte
+    PIXEL_SHADES,   // The shade index of each pixel, from 0 (white) to 3 (black), with no conversion
+} PixelFormat;
+
+// What a line is drawn from, besides vram and OAM, which are covered by their versions. A line drawn from the
+// same inputs as in the frame before would come out the same, so is left as it is.
+typedef struct {
+    uint32 vramVersion;
+    uint32 oamVersion;
+    uint8 registers[8];
+    uint8 windowLine;
+    bool drawn;
+} LineInputs;
+
+struct Display {
+    uint8 backgroundColourOffset[4];
+    uint8 spritePaletteZero[4];
+    uint8 spritePaletteOne[4];
+    // Store the un-offset colour of the current scanline.
+    // Used to decided whether sprites will draw if they don't have priority
+    // Without this, sprites will be invisible on some games
+    uint8 lineBuffer[DISPLAY_WIDTH];
+    // Shade index of each pixel of the frame, after the palettes
+    uint8 shades[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+    // The frame converted to the frontend's pixel format. Only changed lines are converted again, unless the
+    // format differs from the last conversion's.
+    PixelFormat pixelFormat;
+    PixelFormat convertedFormat;
+    uint8 frameBuffer[4 * DISPLAY_WIDTH * DISPLAY_HEIGHT];
+    // Inputs each line was last drawn from
+    LineInputs lineInputs[DISPLAY_HEIGHT];
+    // Lines that have changed since the last frame passed to the frontend, and those that had for that frame
+    bool linesChanged[DISPLAY_HEIGHT];
+    bool frameLinesChanged[DISPLAY_HEIGHT];
+    // Decoded tiles, as the shade of each pixel by [tile][row][column]
+    uint8 tiles[TILE_COUNT][8][8];
+    // The same tiles mirrored on x, for sprites
+    uint8 flippedTiles[TILE_COUNT][8][8];
+    // Tiles written since they were last decoded. They're decoded before the next scanline is drawn.
+    bool tileDirty[TILE_COUNT];
+    uint16 dirtyTiles[TILE_COUNT];
+    uint16 dirtyCount;
+    // Times each tile has been decoded, and times any tile or map entry has changed
+    uint32 tileVersions[TILE_COUNT];
+    uint32 vramVersion;
+    // Times OAM has changed
+    uint32 oamVersion;
+    // Background map images, by map then tile set. Rows of tiles are brought up to date when drawn, if vram has
+    // changed since. Each map entry keeps the tile and version of it that it was drawn with.
+    uint8 mapImages[MAP_IMAGES][MAP_SIZE][MAP_SIZE];
+    uint16 mapTiles[MAP_IMAGES][32 * 32];
+    uint32 mapTileVersions[MAP_IMAGES][32 * 32];
+    uint32 mapRowVersions[MAP_IMAGES][32];
+    // Sprites drawn on each line, highest priority first. Rebuilt from OAM when it changes or the sprite
+    // height does.
+    uint8 lineSprites[DISPLAY_HEIGHT][SPRITES_PER_LINE];
+    uint8 lineSpriteCount[DISPLAY_HEIGHT];
+    uint8 spriteHeight;
+    bool spritesDirty;
+    // Current window line. GB can pause the display of a window and restart at the same line somewhere down
+    // the screen. This allows for split UIs among other things.
+    uint8 windowLine;
+    // Whether the current frame is being rendered, and whether the frames after it will be. When a frame isn't
+    // rendered the screen timing runs as normal, but no pixels are drawn.
+    bool rendering;
+    bool renderFrames;
+    // Whether frames are to be drawn on a second thread, from the end of the current one. See renderer.c.
+    bool renderThreaded;
+};
+
+extern struct Display *createDisplay();
+extern void resetDisplay(Cpu *cpu);
+extern uint8 pixelFormatSize(PixelFormat format);
+extern uint32 shadeColour(uint8 shade, PixelFormat format);
+extern void updateBackgroundColour(uint8 value, Cpu *cpu);
+extern void updateSpritePalette(uint8 palette, uint8 value, Cpu *cpu);
+extern void resetWindowLine(Cpu *cpu);
+extern void startFrame(Cpu *cpu);
+extern void markTileDirty(uint16 tile, Cpu *cpu);
+extern void markMapDirty(Cpu *cpu);
+extern void markSpritesDirty(Cpu *cpu);
+extern void markFrameChanged(Cpu *cpu);
+extern void finishFrameChanges(Cpu *cpu);
+extern bool frameChanges(bool *lines, Cpu *cpu);
 extern void loadTiles(Cpu *cpu);
 extern void loadScanline(Cpu *cpu);
+extern void convertShades(const uint8 *shades, uint8 lines, PixelFormat format, uint8 *pixels, uint32 pitch);
+extern void convertFrame(Cpu *cpu);
 extern void draw(Cpu *cpu);
 
 #endif /* DISPLAY_H */
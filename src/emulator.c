@@ -0,0 +1,128 @@
+/* -*-mode:c; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+#include "types.h"
+#include "emulator.h"
+#include "cpu.h"
+#include "screen.h"
+#include "interrupts.h"
+#include "cartridge.h"
+#include "scheduler.h"
+#include "renderer.h"
+#include "debug/profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Create an emulator running the given rom. All of its state is held in the returned cpu, so any
+// number can run at once, each on one thread at a time. Exits if the rom can't be run.
+Cpu *createEmulator(FILE *rom) {
+    // Set up cpu
+    Cpu *cpu = createCPU();
+
+    // Read and print cartridge info and setup memory banks
+    const char *error;
+    int errNum = cartridgeInfo(cpu, rom, true, &error);
+    if (errNum) {
+        printf("%s\n", error);
+        exit(errNum);
+    }
+
+    return cpu;
+}
+
+// Create an emulator like createEmulator, without printing the cartridge details. Returns NULL, with error
+// set to what's wrong with the rom, if it can't be run.
+Cpu *loadEmulator(FILE *rom, const char **error) {
+    Cpu *cpu = createCPU();
+    if (cartridgeInfo(cpu, rom, false, error)) {
+        freeCPU(cpu);
+        return NULL;
+    }
+    return cpu;
+}
+
+// Set the functions the emulator passes frames to and reads inputs from. Either may be NULL.
+void setEmulatorCallbacks(videoCallback video, inputCallback input, void *data, Cpu *cpu) {
+    cpu->videoCallback = video;
+    cpu->inputCallback = input;
+    cpu->callbackData = data;
+}
+
+// Set the pixel format frames are passed to the video callback in. PIXEL_SHADES skips colour
+// conversion, for frontends that don't show the frame.
+void setEmulatorPixelFormat(PixelFormat format, Cpu *cpu) {
+    cpu->display->pixelFormat = format;
+}
+
+// Choose whether frames are rendered, from the next frame started on. Skipped frames keep the screen's
+// timing and interrupts, but draw no pixels and pass NULL to the video callback. Frontends that only look
+// at some frames can turn rendering on for just those, for example from the video callback.
+void setEmulatorRendering(bool render, Cpu *cpu) {
+    cpu->display->renderFrames = render;
+}
+
+// Choose whether frames are drawn on a second thread while the cpu runs the next one, from the end of the
+// current frame. The video callback then gets each frame at the end of the one after it, still from the cpu's
+// thread. Switching on passes the current frame on twice, and switching off skips one.
+void setEmulatorThreadedRendering(bool threaded, Cpu *cpu) {
+    cpu->display->renderThreaded = threaded;
+}
+
+// Find which lines of the last frame passed to the video callback changed from the frame passed before it, so
+// frontends can skip uploading or encoding the rest. Fills in DISPLAY_HEIGHT entries of lines, unless it's NULL,
+// and returns whether any line changed. Call it from the video callback.
+bool getEmulatorFrameChanges(bool *lines, Cpu *cpu) {
+    return frameChanges(lines, (cpu->renderer) ? rendererCopy(cpu) : cpu);
+}
+
+// Convert lines of a frame passed to the video callback as PIXEL_SHADES into a pixel format, writing each line
+// pitch bytes after the last. Frontends can convert straight into memory they don't own, like a locked texture.
+void convertEmulatorShades(const uint8 *shades, uint8 lines, PixelFormat format, uint8 *pixels, uint32 pitch) {
+    convertShades(shades, lines, format, pixels, pitch);
+}
+
+// Step the emulator one instruction.
+int stepEmulator(Cpu *cpu) {
+    // Check interrupts
+    uint8 interrupts = availableInterrupts(cpu);
+    // Clear halt if there are interrupts
+    if (interrupts) {
+        cpu->halt = false;
+    }
+    // Update the IME (Interrupt Master Enable). This allows it to be set at the correct offset.
+    bool active_ime = updateIME(cpu);
+    // Check interrupts. Servicing one sets the wait to the cycles taken to jump to the handler.
+    handleInterrupts(cpu, active_ime, interrupts);
+    if (cpu->profiler && cpu->wait) {
+        profileInterrupt(cpu);
+    }
+    if (cpu->wait == 0) {
+        if (cpu->halt) {
+            // Only an event can raise an interrupt while halted, so idle in machine cycles until the
+            // next one has run
+            advanceToNextEvent(4, cpu);
+        } else {
+            // Execute instruction
+            int errNum = executeCPU(cpu);
+            if (errNum) {
+                return errNum;
+            }
+        }
+    }
+    // Move the clock forward by the length of the instruction, running any screen and timer
+    // events that fall within it.
+    advanceClock(cpu->wait, cpu);
+    cpu->wait = 0;
+    return 0;
+}
+
+// Raise the joypad interrupt, for when a button is pressed
+void joypadPressed(Cpu *cpu) {
+    setInterruptFlag(INTR_JOYPAD, cpu);
+}
+
+// Write any profile, then free the emulator
+void destroyEmulator(Cpu *cpu) {
+    if (cpu->profiler) {
+        writeProfile(cpu);
+    }
+    freeCPU(cpu);
+}
@@ -0,0 +1,28 @@
+#ifndef EMULATOR_H
+#define EMULATOR_H
+
+#include <stdio.h>
+#include "types.h"
+#include "input.h"
+#include "cpu.h"
+#include "display.h"
+
+// Called with the finished frame, in the pixel format given to setEmulatorPixelFormat (RGBA by default).
+// frameBuffer is NULL for frames skipped with setEmulatorRendering.
+typedef void (*videoCallback)(uint8 *frameBuffer, void *data);
+// Called to fill in the buttons held down
+typedef void (*inputCallback)(input *inputs, void *data);
+
+extern Cpu *createEmulator(FILE *rom);
+extern Cpu *loadEmulator(FILE *rom, const char **error);
+extern void setEmulatorCallbacks(videoCallback video, inputCallback input, void *data, Cpu *cpu);
+extern void setEmulatorPixelFormat(PixelFormat format, Cpu *cpu);
+extern void setEmulatorRendering(bool render, Cpu *cpu);
+extern void setEmulatorThreadedRendering(bool threaded, Cpu *cpu);
+extern bool getEmulatorFrameChanges(bool *lines, Cpu *cpu);
+extern void convertEmulatorShades(const uint8 *shades, uint8 lines, PixelFormat format, uint8 *pixels, uint32 pitch);
+extern int stepEmulator(Cpu *cpu);
+extern void joypadPressed(Cpu *cpu);
+extern void destroyEmulator(Cpu *cpu);
+
+#endif /* EMULATOR_H */
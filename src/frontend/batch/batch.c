@@ -0,0 +1,391 @@
+/* -*-mode:c; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+// Runs a manifest of rom sessions across a pool of threads, writing a JSON line of results for each.
+//
+// Usage: gbe-batch [manifest] [results] [threads]
+//
+// Each manifest line is a job: [rom] [frames] [input script], with the script optional and lines
+// starting with # ignored. Each script line is [frame] [buttons], holding the buttons (a comma
+// separated list of a, b, start, select, up, down, left and right, or none) from that frame on.
+#include "../../types.h"
+#include "../../cpu.h"
+#include "../../memory.h"
+#include "../../display.h"
+#include "../../emulator.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BATCH_MAX_THREADS 256
+#define BATCH_LINE_LENGTH 4096
+#define BATCH_CYCLES_PER_FRAME 70224
+// Jobs get this many frames' worth of cycles per frame asked for, so roms that leave the LCD off still finish
+#define BATCH_FRAME_BUDGET 4
+
+// A change of the buttons held, from the input script
+typedef struct {
+    uint32 frame;
+    input buttons;
+} InputChange;
+
+typedef struct {
+    char *rom;
+    char *script;
+    uint32 frames;
+} Job;
+
+// An emulator running a job
+typedef struct {
+    Cpu *cpu;
+    InputChange *changes;
+    uint32 changeCount;
+    uint32 nextChange;
+    input held;
+    uint32 frame;
+    uint64 *frameHashes;
+} Session;
+
+// Jobs queued for a worker. The worker takes from the tail, and idle workers steal from the head.
+typedef struct {
+    pthread_mutex_t lock;
+    uint32 *jobs;
+    uint32 head;
+    uint32 tail;
+} Deque;
+
+typedef struct {
+    Job *jobs;
+    Deque *deques;
+    uint32 workers;
+    FILE *results;
+    pthread_mutex_t resultsLock;
+} Pool;
+
+typedef struct {
+    Pool *pool;
+    uint32 index;
+} Worker;
+
+// FNV-1a hash, continuing from hash
+static uint64 hashBytes(uint64 hash, const uint8 *bytes, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+#define HASH_START 1469598103934665603ULL
+
+// Hash the registers and memory the game can see
+static uint64 hashState(Cpu *cpu) {
+    uint16 registers[] = {
+        (cpu->registers.A << 8) | readFlagsRegister(cpu), cpu->registers.BC, cpu->registers.DE,
+        cpu->registers.HL, cpu->SP, cpu->PC
+    };
+    uint64 hash = hashBytes(HASH_START, (uint8 *) registers, sizeof(registers));
+    hash = hashBytes(hash, cpu->memory.wram, 8 * WRAM_BANK_SIZE);
+    hash = hashBytes(hash, cpu->memory.vram, 2 * VRAM_BANK_SIZE);
+    hash = hashBytes(hash, cpu->memory.oam, OAM_BOUND);
+    hash = hashBytes(hash, cpu->memory.io, IO_BOUND);
+    hash = hashBytes(hash, cpu->memory.hram, HRAM_BOUND);
+    return hashBytes(hash, &cpu->memory.ie, 1);
+}
+
+// Hold the buttons the script gives for the current frame
+static void applyScript(Session *session) {
+    while (session->nextChange < session->changeCount && session->changes[session->nextChange].frame <= session->frame) {
+        input *buttons = &session->changes[session->nextChange++].buttons;
+        // Fire the joypad interrupt for newly pressed buttons, like a frontend does on a key press
+        if ((buttons->a && !session->held.a) || (buttons->b && !session->held.b)
+            || (buttons->start && !session->held.start) || (buttons->select && !session->held.select)
+            || (buttons->up && !session->held.up) || (buttons->down && !session->held.down)
+            || (buttons->left && !session->held.left) || (buttons->right && !session->held.right)) {
+            joypadPressed(session->cpu);
+        }
+        session->held = *buttons;
+    }
+}
+
+// Hash the shades of each frame, then move the script on to the next one
+static void sessionVideo(uint8 *frameBuffer, void *data) {
+    Session *session = (Session *) data;
+    session->frameHashes[session->frame++] = hashBytes(HASH_START, frameBuffer, DISPLAY_WIDTH * DISPLAY_HEIGHT);
+    applyScript(session);
+}
+
+static void sessionInput(input *inputs, void *data) {
+    *inputs = ((Session *) data)->held;
+}
+
+// Read an input script. Returns false if it can't be read.
+static bool loadScript(const char *path, Session *session) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        return false;
+    }
+    char line[BATCH_LINE_LENGTH];
+    char buttons[BATCH_LINE_LENGTH];
+    uint32 capacity = 0;
+    while (fgets(line, sizeof(line), file)) {
+        uint32 frame;
+        if (line[0] == '#' || sscanf(line, "%u %s", &frame, buttons) != 2) {
+            continue;
+        }
+        if (session->changeCount == capacity) {
+            capacity = (capacity) ? capacity * 2 : 64;
+            session->changes = (InputChange *) realloc(session->changes, capacity * sizeof(InputChange));
+            if (!session->changes) {
+                printf("Failed to malloc input script\n");
+                exit(530);
+            }
+        }
+        InputChange *change = &session->changes[session->changeCount++];
+        change->frame = frame;
+        change->buttons = (input) { 0 };
+        char *next;
+        for (char *button = strtok_r(buttons, ",", &next); button; button = strtok_r(NULL, ",", &next)) {
+            if (!strcmp(button, "a")) {
+                change->buttons.a = true;
+            } else if (!strcmp(button, "b")) {
+                change->buttons.b = true;
+            } else if (!strcmp(button, "start")) {
+                change->buttons.start = true;
+            } else if (!strcmp(button, "select")) {
+                change->buttons.select = true;
+            } else if (!strcmp(button, "up")) {
+                change->buttons.up = true;
+            } else if (!strcmp(button, "down")) {
+                change->buttons.down = true;
+            } else if (!strcmp(button, "left")) {
+                change->buttons.left = true;
+            } else if (!strcmp(button, "right")) {
+                change->buttons.right = true;
+            } else if (strcmp(button, "none")) {
+                fclose(file);
+                return false;
+            }
+        }
+    }
+    fclose(file);
+    return true;
+}
+
+// Write a string as a JSON string
+static void writeJsonString(const char *string, FILE *file) {
+    fputc('"', file);
+    for (; *string; string++) {
+        if (*string == '"' || *string == '\\') {
+            fputc('\\', file);
+        }
+        fputc(*string, file);
+    }
+    fputc('"', file);
+}
+
+// Write the results of a job as one JSON line
+static void writeResult(uint32 index, Job *job, const char *error, Session *session, uint64 stateHash,
+                        double seconds, Pool *pool) {
+    pthread_mutex_lock(&pool->resultsLock);
+    FILE *file = pool->results;
+    fprintf(file, "{\"job\":%u,\"rom\":", index);
+    writeJsonString(job->rom, file);
+    if (error) {
+        fprintf(file, ",\"error\":");
+        writeJsonString(error, file);
+    } else {
+        fprintf(file, ",\"frames\":%u,\"cycles\":%llu,\"seconds\":%.6f,\"state_hash\":\"%016llx\",\"frame_hashes\":[",
+                session->frame, (unsigned long long) session->cpu->clock, seconds, (unsigned long long) stateHash);
+        for (uint32 i = 0; i < session->frame; i++) {
+            fprintf(file, (i) ? ",\"%016llx\"" : "\"%016llx\"", (unsigned long long) session->frameHashes[i]);
+        }
+        fprintf(file, "]");
+    }
+    fprintf(file, "}\n");
+    fflush(file);
+    pthread_mutex_unlock(&pool->resultsLock);
+}
+
+// Run a job to its frame count, or until its cycle budget runs out, and write its results
+static void runJob(uint32 index, Pool *pool) {
+    Job *job = &pool->jobs[index];
+    Session session = { 0 };
+    if (job->script && !loadScript(job->script, &session)) {
+        writeResult(index, job, "could not read input script", &session, 0, 0, pool);
+        free(session.changes);
+        return;
+    }
+    FILE *rom = fopen(job->rom, "rb");
+    if (!rom) {
+        writeResult(index, job, "could not open rom", &session, 0, 0, pool);
+        free(session.changes);
+        return;
+    }
+    session.frameHashes = (uint64 *) malloc((job->frames + 1) * sizeof(uint64));
+    if (!session.frameHashes) {
+        printf("Failed to malloc frame hashes\n");
+        exit(530);
+    }
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    // Loaded quietly, as details printed from each thread would interleave
+    const char *error;
+    session.cpu = loadEmulator(rom, &error);
+    fclose(rom);
+    if (!session.cpu) {
+        writeResult(index, job, error, &session, 0, 0, pool);
+        free(session.frameHashes);
+        free(session.changes);
+        return;
+    }
+    setEmulatorCallbacks(sessionVideo, sessionInput, &session, session.cpu);
+    // Frames are only hashed, so skip converting them to colour
+    setEmulatorPixelFormat(PIXEL_SHADES, session.cpu);
+    applyScript(&session);
+    uint64 budget = session.cpu->clock + (uint64) job->frames * BATCH_CYCLES_PER_FRAME * BATCH_FRAME_BUDGET;
+    int errNum = 0;
+    while (session.frame < job->frames && !errNum && session.cpu->clock < budget) {
+        errNum = stepEmulator(session.cpu);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    error = NULL;
+    if (errNum) {
+        error = "emulator error";
+    } else if (session.frame < job->frames) {
+        error = "frame limit";
+    }
+    writeResult(index, job, error, &session, hashState(session.cpu), seconds, pool);
+    destroyEmulator(session.cpu);
+    free(session.frameHashes);
+    free(session.changes);
+}
+
+// Take a job from the tail of a worker's own deque, or steal one from the head of another's
+static bool takeJob(uint32 worker, uint32 *job, Pool *pool) {
+    for (uint32 i = 0; i < pool->workers; i++) {
+        Deque *deque = &pool->deques[(worker + i) % pool->workers];
+        bool found = false;
+        pthread_mutex_lock(&deque->lock);
+        if (deque->head < deque->tail) {
+            *job = (i) ? deque->jobs[deque->head++] : deque->jobs[--deque->tail];
+            found = true;
+        }
+        pthread_mutex_unlock(&deque->lock);
+        if (found) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void *runWorker(void *data) {
+    Worker *worker = (Worker *) data;
+    uint32 job;
+    while (takeJob(worker->index, &job, worker->pool)) {
+        runJob(job, worker->pool);
+    }
+    return NULL;
+}
+
+// Read the jobs from the manifest. Returns the number read.
+static uint32 loadManifest(const char *path, Job **jobs) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Error: could not open manifest %s\n", path);
+        exit(2);
+    }
+    char line[BATCH_LINE_LENGTH];
+    char rom[BATCH_LINE_LENGTH];
+    char script[BATCH_LINE_LENGTH];
+    uint32 count = 0;
+    uint32 capacity = 0;
+    while (fgets(line, sizeof(line), file)) {
+        uint32 frames;
+        int fields = sscanf(line, "%s %u %s", rom, &frames, script);
+        if (line[0] == '#' || fields < 2) {
+            continue;
+        }
+        if (count == capacity) {
+            capacity = (capacity) ? capacity * 2 : 64;
+            *jobs = (Job *) realloc(*jobs, capacity * sizeof(Job));
+            if (!*jobs) {
+                printf("Failed to malloc jobs\n");
+                exit(530);
+            }
+        }
+        Job *job = &(*jobs)[count++];
+        job->rom = strdup(rom);
+        job->frames = frames;
+        job->script = (fields == 3) ? strdup(script) : NULL;
+    }
+    fclose(file);
+    return count;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "Error: Usage: %s [manifest] [results] [threads]\n", argv[0]);
+        exit(1);
+    }
+    Pool pool = { 0 };
+    uint32 count = loadManifest(argv[1], &pool.jobs);
+    pool.results = fopen(argv[2], "w");
+    if (!pool.results) {
+        fprintf(stderr, "Error: could not open results %s\n", argv[2]);
+        exit(2);
+    }
+    long workers = (argc > 3) ? atol(argv[3]) : sysconf(_SC_NPROCESSORS_ONLN);
+    if (workers < 1) {
+        workers = 1;
+    } else if (workers > BATCH_MAX_THREADS) {
+        workers = BATCH_MAX_THREADS;
+    }
+    pool.workers = workers;
+    pthread_mutex_init(&pool.resultsLock, NULL);
+
+    // Deal the jobs out to the workers
+    pool.deques = (Deque *) calloc(pool.workers, sizeof(Deque));
+    if (!pool.deques) {
+        printf("Failed to malloc job queues\n");
+        exit(530);
+    }
+    for (uint32 i = 0; i < pool.workers; i++) {
+        pthread_mutex_init(&pool.deques[i].lock, NULL);
+        pool.deques[i].jobs = (uint32 *) malloc((count / pool.workers + 1) * sizeof(uint32));
+        if (!pool.deques[i].jobs) {
+            printf("Failed to malloc job queues\n");
+            exit(530);
+        }
+    }
+    for (uint32 job = 0; job < count; job++) {
+        Deque *deque = &pool.deques[job % pool.workers];
+        deque->jobs[deque->tail++] = job;
+    }
+
+    pthread_t threads[BATCH_MAX_THREADS];
+    Worker worker[BATCH_MAX_THREADS];
+    for (uint32 i = 0; i < pool.workers; i++) {
+        worker[i] = (Worker) { .pool = &pool, .index = i };
+        pthread_create(&threads[i], NULL, runWorker, &worker[i]);
+    }
+    for (uint32 i = 0; i < pool.workers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    fclose(pool.results);
+    for (uint32 i = 0; i < pool.workers; i++) {
+        pthread_mutex_destroy(&pool.deques[i].lock);
+        free(pool.deques[i].jobs);
+    }
+    for (uint32 job = 0; job < count; job++) {
+        free(pool.jobs[job].rom);
+        free(pool.jobs[job].script);
+    }
+    free(pool.deques);
+    free(pool.jobs);
+    pthread_mutex_destroy(&pool.resultsLock);
+    return 0;
+}
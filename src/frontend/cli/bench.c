@@ -0,0 +1,250 @@
+/* -*-mode:c; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+// Headless benchmark. Runs a rom with no presentation and reports throughput.
+//
+// It sits next to the cli frontend but doesn't share its code. cli.c runs one emulator through gbe.c's
+// global cpu until it stops. The bench needs a fresh emulator for each trial, run for a set number of
+// cycles, so it drives the core directly through emulator.h.
+//
+// Usage: gbe-bench [rom] [--frames n] [--warmup n] [--trials n] [--render-every n] [--threaded on|off] [--json file]
+//                  [--baseline file] [--tolerance percent]
+//
+// Each trial starts a fresh emulator, runs the warm-up frames untimed, then times the given number of
+// frames. Trials are measured in emulated time, in frames of the hardware's 70224 cycles, so roms that switch
+// the LCD off still finish. The core's screen draws a frame every 67704 cycles, so a trial draws a few more
+// frames than it asks for: frames/s counts the frames actually drawn, while speed compares the cycles run
+// with real hardware. The median trial is reported. --json writes the results as JSON, which can be passed back
+// as --baseline to compare against; the exit code is 3 when frames/s drops by more than the tolerance.
+// --render-every n renders one frame in n and skips the pixel work for the rest, like a fast-forward.
+// --threaded on draws frames on a second thread while the cpu runs the next one.
+#include "../../types.h"
+#include "../../cpu.h"
+#include "../../emulator.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_CLOCK_SPEED 4194304
+#define BENCH_CYCLES_PER_FRAME 70224
+#define BENCH_FRAME_RATE 59.73
+#define BENCH_MAX_TRIALS 100
+
+typedef struct {
+    double seconds;
+    uint64 cycles;
+    uint64 instructions;
+    uint64 frames; // frames drawn
+    uint64 rendered; // frames drawn with pixels
+} Trial;
+
+typedef struct {
+    Cpu *cpu;
+    uint32 renderEvery;
+    uint64 drawn;
+    uint64 rendered;
+} Session;
+
+// Count the frames drawn, and choose whether the next one is rendered
+static void benchVideo(uint8 *frameBuffer, void *data) {
+    Session *session = (Session *) data;
+    session->drawn++;
+    if (frameBuffer) {
+        session->rendered++;
+    }
+    setEmulatorRendering(session->drawn % session->renderEvery == 0, session->cpu);
+}
+
+// Run one trial of the rom
+static Trial runTrial(const char *path, uint32 frames, uint32 warmup, uint32 renderEvery, bool threaded) {
+    FILE *rom = fopen(path, "rb");
+    if (!rom) {
+        fprintf(stderr, "Error: could not open rom %s\n", path);
+        exit(2);
+    }
+    Cpu *cpu = createEmulator(rom);
+    fclose(rom);
+    Session session = {cpu, renderEvery, 0, 0};
+    setEmulatorCallbacks(benchVideo, NULL, &session, cpu);
+    setEmulatorPixelFormat(PIXEL_SHADES, cpu);
+    setEmulatorThreadedRendering(threaded, cpu);
+
+    // Warm up the caches and translations
+    while (cpu->clock < (uint64) warmup * BENCH_CYCLES_PER_FRAME) {
+        if (stepEmulator(cpu)) {
+            fprintf(stderr, "Error: emulator stopped during warm-up\n");
+            exit(4);
+        }
+    }
+
+    Trial trial;
+    uint64 startClock = cpu->clock;
+    uint64 startInstructions = cpu->instructions;
+    uint64 startDrawn = session.drawn;
+    uint64 startRendered = session.rendered;
+    uint64 end = startClock + (uint64) frames * BENCH_CYCLES_PER_FRAME;
+    struct timespec start, stop;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (cpu->clock < end) {
+        if (stepEmulator(cpu)) {
+            fprintf(stderr, "Error: emulator stopped during trial\n");
+            exit(4);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    trial.seconds = (stop.tv_sec - start.tv_sec) + (stop.tv_nsec - start.tv_nsec) / 1e9;
+    trial.cycles = cpu->clock - startClock;
+    trial.instructions = cpu->instructions - startInstructions;
+    trial.frames = session.drawn - startDrawn;
+    trial.rendered = session.rendered - startRendered;
+    destroyEmulator(cpu);
+    return trial;
+}
+
+static int compareTrials(const void *a, const void *b) {
+    double x = ((const Trial *) a)->seconds;
+    double y = ((const Trial *) b)->seconds;
+    return (x > y) - (x < y);
+}
+
+// Write a string as a JSON string
+static void writeJsonString(const char *string, FILE *file) {
+    fputc('"', file);
+    for (; *string; string++) {
+        if (*string == '"' || *string == '\\') {
+            fputc('\\', file);
+        }
+        fputc(*string, file);
+    }
+    fputc('"', file);
+}
+
+// Read frames_per_second from a JSON file written by --json. Returns 0 if it can't be found.
+static double readBaseline(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Error: could not open baseline %s\n", path);
+        exit(2);
+    }
+    char text[4096];
+    size_t length = fread(text, 1, sizeof(text) - 1, file);
+    text[length] = '\0';
+    fclose(file);
+    char *field = strstr(text, "\"frames_per_second\":");
+    return (field) ? strtod(field + strlen("\"frames_per_second\":"), NULL) : 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Error: Usage: %s [rom] [--frames n] [--warmup n] [--trials n] [--render-every n] [--threaded on|off] [--json file] [--baseline file] [--tolerance percent]\n", argv[0]);
+        exit(1);
+    }
+    uint32 frames = 3600;
+    uint32 warmup = 300;
+    uint32 trials = 5;
+    uint32 renderEvery = 1;
+    bool threaded = false;
+    const char *json = NULL;
+    const char *baseline = NULL;
+    double tolerance = 5;
+    for (int i = 2; i < argc; i++) {
+        if (i + 1 >= argc) {
+            fprintf(stderr, "Error: Missing value for %s\n", argv[i]);
+            exit(1);
+        } else if (!strcmp(argv[i], "--frames")) {
+            frames = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--warmup")) {
+            warmup = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--trials")) {
+            trials = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--render-every")) {
+            renderEvery = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--threaded")) {
+            threaded = !strcmp(argv[++i], "on");
+        } else if (!strcmp(argv[i], "--json")) {
+            json = argv[++i];
+        } else if (!strcmp(argv[i], "--baseline")) {
+            baseline = argv[++i];
+        } else if (!strcmp(argv[i], "--tolerance")) {
+            tolerance = atof(argv[++i]);
+        } else {
+            fprintf(stderr, "Error: Unknown argument %s\n", argv[i]);
+            exit(1);
+        }
+    }
+    if (trials < 1) {
+        trials = 1;
+    } else if (trials > BENCH_MAX_TRIALS) {
+        trials = BENCH_MAX_TRIALS;
+    }
+    if (frames < 1) {
+        frames = 1;
+    }
+    if (renderEvery < 1) {
+        renderEvery = 1;
+    }
+
+    Trial results[BENCH_MAX_TRIALS];
+    for (uint32 i = 0; i < trials; i++) {
+        results[i] = runTrial(argv[1], frames, warmup, renderEvery, threaded);
+    }
+    qsort(results, trials, sizeof(Trial), compareTrials);
+    Trial *median = &results[trials / 2];
+    double framesPerSecond = median->frames / median->seconds;
+    double cyclesPerSecond = median->cycles / median->seconds;
+    double instructionsPerSecond = median->instructions / median->seconds;
+    // Hardware frames run per second, against the hardware's frame rate
+    double speed = (cyclesPerSecond / BENCH_CYCLES_PER_FRAME) / BENCH_FRAME_RATE;
+
+    // Reports go to stderr, as the core prints cartridge details to stdout
+    fprintf(stderr, "rom:            %s\n", argv[1]);
+    fprintf(stderr, "trials:         %u x %u frames (%u warm-up), %llu frames drawn, %llu rendered\n", trials, frames,
+            warmup, (unsigned long long) median->frames, (unsigned long long) median->rendered);
+    fprintf(stderr, "time:           %.4fs median, %.4fs min, %.4fs max\n", median->seconds, results[0].seconds,
+            results[trials - 1].seconds);
+    fprintf(stderr, "frames/s:       %.1f\n", framesPerSecond);
+    fprintf(stderr, "cycles/s:       %.0f\n", cyclesPerSecond);
+    fprintf(stderr, "instructions/s: %.0f\n", instructionsPerSecond);
+    fprintf(stderr, "speed:          %.2fx\n", speed);
+
+    int out = 0;
+    double change = 0;
+    double baselineFrames = 0;
+    if (baseline) {
+        baselineFrames = readBaseline(baseline);
+        if (baselineFrames > 0) {
+            change = 100 * (framesPerSecond - baselineFrames) / baselineFrames;
+            fprintf(stderr, "baseline:       %.1f frames/s, %+.2f%%\n", baselineFrames, change);
+            if (change < -tolerance) {
+                fprintf(stderr, "Slower than the baseline by more than %.2f%%\n", tolerance);
+                out = 3;
+            }
+        } else {
+            fprintf(stderr, "Error: no frames_per_second in baseline %s\n", baseline);
+        }
+    }
+
+    if (json) {
+        FILE *file = fopen(json, "w");
+        if (!file) {
+            fprintf(stderr, "Error: could not open %s\n", json);
+            exit(2);
+        }
+        fprintf(file, "{\"rom\":");
+        writeJsonString(argv[1], file);
+        fprintf(file, ",\"frames\":%u,\"warmup\":%u,\"trials\":%u,\"render_every\":%u,\"threaded\":%s,\"frames_drawn\":%llu,"
+                      "\"frames_rendered\":%llu,"
+                      "\"seconds\":%.6f,\"seconds_min\":%.6f,\"seconds_max\":%.6f,\"frames_per_second\":%.3f,"
+                      "\"cycles_per_second\":%.0f,\"instructions_per_second\":%.0f,\"speed\":%.4f,"
+                      "\"clock_speed\":%.4f",
+                frames, warmup, trials, renderEvery, (threaded) ? "true" : "false", (unsigned long long) median->frames,
+                (unsigned long long) median->rendered, median->seconds,
+                results[0].seconds, results[trials - 1].seconds, framesPerSecond, cyclesPerSecond,
+                instructionsPerSecond, speed, cyclesPerSecond / BENCH_CLOCK_SPEED);
+        if (baselineFrames > 0) {
+            fprintf(file, ",\"baseline_frames_per_second\":%.3f,\"change_percent\":%.3f", baselineFrames, change);
+        }
+        fprintf(file, "}\n");
+        fclose(file);
+    }
+    return out;
+}
@@ -21,7 +21,7 @@ void startDisplay() {
     // Do nothing
 }
 
-void displayOnWindow(uint8 *frameBuffer) {
+void displayOnWindow(uint8 *shades, const bool *changedLines) {
     // Do nothing
 }
 
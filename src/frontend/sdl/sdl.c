@@ -7,6 +7,9 @@
 #include "../../display.h"
 #include "../../input.h"
 #include "../../gbe.h"
+#include "../../emulator.h"
+#include <stdlib.h>
+#include <string.h>
 
 #define WINDOW_HEIGHT 288
 #define WINDOW_WIDTH 320
@@ -16,6 +19,13 @@ SDL_Window* window = NULL;
 SDL_Texture* texture = NULL;
 SDL_Renderer* renderer = NULL;
 
+// Texture format the renderer handles natively, and the emulator's format with the same layout
+Uint32 texture_sdl_format = SDL_PIXELFORMAT_ARGB8888;
+PixelFormat texture_format = PIXEL_XRGB8888;
+// Whether the whole texture has been written, and the lines changed since it was last updated
+bool texture_filled = false;
+bool pending_lines[DISPLAY_HEIGHT];
+
 uint64_t last_frame_time = 0;
 double sdl_frame_time = (1000/60.0);
 
@@ -36,8 +46,42 @@ void frontend_get_window_size(windowSize *size) {
     size->height = height;
 }
 
-// Get texture ready to be displayed
-void displayOnWindow(uint8 *frameBuffer) {
+// Update the lines of the texture that changed since it was last updated. They're converted from shades straight
+// into the texture's memory, so no surface or copy of the frame is made.
+static void updateTexture(uint8 *shades) {
+    int first = 0;
+    int last = DISPLAY_HEIGHT - 1;
+    if (texture_filled) {
+        while (first < DISPLAY_HEIGHT && !pending_lines[first]) {
+            first++;
+        }
+        if (first == DISPLAY_HEIGHT) {
+            return;
+        }
+        while (!pending_lines[last]) {
+            last--;
+        }
+    }
+    // Only the locked rectangle is written, which is all that's guaranteed to be kept
+    SDL_Rect rect = {0, first, DISPLAY_WIDTH, last - first + 1};
+    void *pixels;
+    int pitch;
+    if (SDL_LockTexture(texture, &rect, &pixels, &pitch)) {
+        printf("SDL: failure to lock texture: %s\n", SDL_GetError());
+        return;
+    }
+    convertEmulatorShades(shades + first * DISPLAY_WIDTH, rect.h, texture_format, (uint8 *) pixels, pitch);
+    SDL_UnlockTexture(texture);
+    memset(pending_lines, 0, sizeof(pending_lines));
+    texture_filled = true;
+}
+
+// Get texture ready to be displayed. Only the lines that changed are converted into it.
+void displayOnWindow(uint8 *shades, const bool *changedLines) {
+    // Frames in between may not be shown, so collect the lines changed since the texture was updated
+    for (int line = 0; line < DISPLAY_HEIGHT; line++) {
+        pending_lines[line] |= changedLines[line];
+    }
     // Get current time
     uint64_t frame_time = SDL_GetPerformanceCounter();
     // Get difference in time
@@ -53,15 +97,7 @@ void displayOnWindow(uint8 *frameBuffer) {
         }
         // Update last frame time
         last_frame_time = frame_time;
-        // Convert framebuffer to texture to display
-        SDL_Surface* frame = SDL_CreateRGBSurfaceFrom(frameBuffer, DISPLAY_WIDTH, DISPLAY_HEIGHT, 32, DISPLAY_WIDTH * 4, 0, 0, 0, 0);
-        // If texture isn't loaded yet, create one; else update existing texture.
-        if (texture == NULL) {
-            texture = SDL_CreateTextureFromSurface(renderer, frame);
-        } else {
-            SDL_UpdateTexture(texture, NULL, frame->pixels, frame->pitch);
-        }
-        SDL_FreeSurface(frame);
+        updateTexture(shades);
         frontend_swap_buffers();
     }
 }
@@ -79,6 +115,29 @@ void getInput(input *current_input) {
     current_input->right    = local_input.right;
 }
 
+// Pick the first texture format the renderer prefers that the emulator can convert to. Anything else is
+// converted again by SDL on upload.
+static void chooseTextureFormat() {
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer, &info)) {
+        return;
+    }
+    for (Uint32 i = 0; i < info.num_texture_formats; i++) {
+        Uint32 format = info.texture_formats[i];
+        if (format == SDL_PIXELFORMAT_ARGB8888 || format == SDL_PIXELFORMAT_RGB888) {
+            texture_format = PIXEL_XRGB8888;
+        } else if (format == SDL_PIXELFORMAT_RGBA32) {
+            texture_format = PIXEL_RGBA8888;
+        } else if (format == SDL_PIXELFORMAT_RGB565) {
+            texture_format = PIXEL_RGB565;
+        } else {
+            continue;
+        }
+        texture_sdl_format = format;
+        return;
+    }
+}
+
 // Start SDL window
 void startDisplay() {
     SDL_Init(SDL_INIT_EVERYTHING);
@@ -86,6 +145,14 @@ void startDisplay() {
     renderer = SDL_CreateRenderer(window, -1, 0);
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
     SDL_RenderSetLogicalSize(renderer, WINDOW_WIDTH, WINDOW_HEIGHT);
+    // Frames are streamed into one texture for the whole run
+    chooseTextureFormat();
+    texture = SDL_CreateTexture(renderer, texture_sdl_format, SDL_TEXTUREACCESS_STREAMING, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    if (texture == NULL) {
+        printf("SDL: failure to create texture: %s\n", SDL_GetError());
+        exit(12);
+    }
+    texture_filled = false;
 }
 
 // Stop SDL window and free up resources.
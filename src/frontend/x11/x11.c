@@ -83,9 +83,9 @@ void frontend_get_window_size(windowSize *size) {
     size->height = windowAttributes.height;
 }
 
-// Display frameBuffer on screen
-void displayOnWindow(uint8 *frameBuffer) {
-    gl_display_framebuffer_on_window(frameBuffer);
+// Display the frame's shades on screen. GL colours them.
+void displayOnWindow(uint8 *shades, const bool *changedLines) {
+    gl_display_frame_on_window(shades, changedLines);
 }
 
 // Start display
@@ -118,11 +118,13 @@ void startDisplay() {
 
     glContext = glXCreateContext(display, visualInfo, NULL, GL_TRUE);
     glXMakeCurrent(display, window, glContext);
+    gl_init();
     gl_clear_window();
 }
 
 // CLose display.
 void stopDisplay() {
+    gl_destroy();
     glXMakeCurrent(display, None, NULL);
     glXDestroyContext(display, glContext);
     XDestroyWindow(display, window);
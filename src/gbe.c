@@ -2,66 +2,66 @@
 #include "types.h"
 #include "gbe.h"
 #include "cpu.h"
-#include "screen.h"
-#include "interrupts.h"
-#include "cartridge.h"
+#include "emulator.h"
+#include "input.h"
+#include "window.h"
 #include "file.c"
-#include "opcodes/opcodes.h"
-#include "display.h"
-#include "joypad.h"
+#include "debug/profiler.h"
 #include <stdlib.h>
+#include <string.h>
 
 Cpu *cpu;
 
+// Pass frames to the frontend, as shades for it to convert into its own format
+static void frontendVideo(uint8 *frameBuffer, void *data) {
+    bool lines[DISPLAY_HEIGHT];
+    getEmulatorFrameChanges(lines, cpu);
+    displayOnWindow(frameBuffer, lines);
+}
+
+// Read inputs from the frontend
+static void frontendInput(input *inputs, void *data) {
+    getInput(inputs);
+}
+
 int startEmulator(int argc, char *argv[]) {
     // Catch case when no file provided
     if (argc < 2) {
-        fprintf(stderr, "Error: Usage: %s [file name]\n", argv[0]);
+        fprintf(stderr, "Error: Usage: %s [file name] [--profile report] [--threaded]\n", argv[0]);
         exit(1);
     }
 
     // Open rom
     FILE *rom = romLoad(argv[1]);
 
-    // Set up cpu
-    cpu = createCPU();
-
-    // Read and print cartridge info and setup memory banks
-    cartridgeInfo(cpu, rom);
+    // Set up the emulator, passing frames and inputs to the frontend
+    cpu = createEmulator(rom);
+    setEmulatorCallbacks(frontendVideo, frontendInput, NULL, cpu);
+    setEmulatorPixelFormat(PIXEL_SHADES, cpu);
 
     // Close the rom now that all data has been read
     romClose(rom);
 
+    // Optional arguments
+    for (int i = 2; i < argc; i++) {
+        if (!strcmp(argv[i], "--profile") && i + 1 < argc) {
+            // Count every instruction and write a report when stopping
+            cpu->profiler = createProfiler(argv[++i], cpu);
+        } else if (!strcmp(argv[i], "--threaded")) {
+            // Draw frames on a second thread
+            setEmulatorThreadedRendering(true, cpu);
+        } else {
+            fprintf(stderr, "Error: Unknown argument %s\n", argv[i]);
+            exit(1);
+        }
+    }
+
     return 0;
 }
 
 // Step the emulator one instruction.
 int cycleEmulator() {
-    // Check interrupts
-    uint8 interrupts = availableInterrupts(cpu);
-    // Clear halt if there are interrupts
-    if (interrupts) {
-        cpu->halt = false;
-    }
-    // Update the screen
-    updateScreen(cpu);
-    // Update the IME (Interrupt Master Enable). This allows it to be set at the correct offset.
-    bool active_ime = updateIME(cpu);
-    // Check interrupts
-    handleInterrupts(cpu, active_ime, interrupts);
-    // Run single instruction loop
-    if (!cpu->halt) {
-        if (cpu->wait == 0) {
-            // Execute instruction
-            int errNum = executeCPU(cpu);
-            if (errNum) {
-                return errNum;
-            }
-        } else {
-            cycleCPU(cpu);
-        }
-    }
-    return 0;
+    return stepEmulator(cpu);
 }
 
 // Pass interface interrupts to emulator. Multiple flags can be sent via logical OR.
@@ -69,15 +69,11 @@ int cycleEmulator() {
 void emulatorInterrupt(uint32 interruptFlag) {
     // Pass on interrupt for joypad input
     if (interruptFlag & EMULATOR_INTER_JOYPAD) {
-        setInterruptFlag(INTR_JOYPAD, cpu);
+        joypadPressed(cpu);
     }
 }
 
 void stopEmulator() {
-    //free cpu, cartridge at end
-    free(cpu->memory.rom);
-    free(cpu->memory.ram);
-    free(cpu->memory.wram);
-    free(cpu->memory.vram);
-    free(cpu);
+    destroyEmulator(cpu);
+    cpu = NULL;
 }
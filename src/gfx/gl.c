@@ -1,10 +1,57 @@
-#include <GL/glu.h>
+// Needs OpenGL 2.1, for shaders and pixel buffer objects
+#define GL_GLEXT_PROTOTYPES
 #include <GL/gl.h>
+#include <GL/glext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "../types.h"
 #include "../display.h"
 #include "../frontend/frontend.h"
 
+#define GL_FRAME_SIZE (DISPLAY_WIDTH * DISPLAY_HEIGHT)
+#define GL_ATTRIBUTE_POSITION 0
+#define GL_ATTRIBUTE_TEXCOORD 1
+
+// Frames are uploaded as one byte of shade per pixel, and coloured by looking the shade up in the palette
+static const char *vertexShader =
+    "#version 110\n"
+    "attribute vec2 position;\n"
+    "attribute vec2 texcoord;\n"
+    "varying vec2 uv;\n"
+    "void main() {\n"
+    "    uv = texcoord;\n"
+    "    gl_Position = vec4(position, 0.0, 1.0);\n"
+    "}\n";
+static const char *fragmentShader =
+    "#version 110\n"
+    "uniform sampler2D shades;\n"
+    "uniform vec4 palette[4];\n"
+    "varying vec2 uv;\n"
+    "void main() {\n"
+    "    float shade = texture2D(shades, uv).r * 255.0;\n"
+    "    vec4 colour = mix(palette[0], palette[1], step(0.5, shade));\n"
+    "    colour = mix(colour, palette[2], step(1.5, shade));\n"
+    "    gl_FragColor = mix(colour, palette[3], step(2.5, shade));\n"
+    "}\n";
+
+// Screen corners and the texture coordinates drawn at them, with line 0 at the top
+static const GLfloat quad[] = {
+    -1, -1, 0, 1,
+    1, -1, 1, 1,
+    -1, 1, 0, 0,
+    1, 1, 1, 0,
+};
+
+static GLuint program;
+static GLuint texture;
+static GLuint vertexBuffer;
+// Each frame is written into one pixel buffer while the texture may still be copying the last from the other
+static GLuint pixelBuffers[2];
+static uint8 pixelBuffer;
+static bool textureFilled;
+
 // Update viewport size
 void gl_update_viewport() {
     windowSize window = {};
@@ -12,34 +59,136 @@ void gl_update_viewport() {
     glViewport(0, 0, window.width, window.height);
 }
 
-// Draw the framebuffer to the window
-void gl_display_framebuffer_on_window(uint8 *frameBuffer) {
-    gl_update_viewport();
-    //XGetWindowAttributes(display, window, &windowAttributes);
-    //glViewport(0, 0, windowAttributes.width, windowAttributes.height);
-    glClear(GL_COLOR_BUFFER_BIT);
-    glEnable(GL_TEXTURE_2D);
+static GLuint compileShader(GLenum type, const char *source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+    GLint compiled;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (!compiled) {
+        char log[1024];
+        glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+        printf("GL: Failure to compile shader: %s\n", log);
+        exit(32);
+    }
+    return shader;
+}
+
+// Set up the shader, texture and buffers frames are drawn with. Call once the context is current.
+void gl_init() {
+    GLuint vertex = compileShader(GL_VERTEX_SHADER, vertexShader);
+    GLuint fragment = compileShader(GL_FRAGMENT_SHADER, fragmentShader);
+    program = glCreateProgram();
+    glAttachShader(program, vertex);
+    glAttachShader(program, fragment);
+    glBindAttribLocation(program, GL_ATTRIBUTE_POSITION, "position");
+    glBindAttribLocation(program, GL_ATTRIBUTE_TEXCOORD, "texcoord");
+    glLinkProgram(program);
+    glDeleteShader(vertex);
+    glDeleteShader(fragment);
+    GLint linked;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        char log[1024];
+        glGetProgramInfoLog(program, sizeof(log), NULL, log);
+        printf("GL: Failure to link shader: %s\n", log);
+        exit(32);
+    }
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "shades"), 0);
+    // The same colours frames are converted to on the cpu
+    GLfloat palette[4][4];
+    for (uint8 shade = 0; shade < 4; shade++) {
+        uint32 colour = shadeColour(shade, PIXEL_RGBA8888);
+        uint8 bytes[4];
+        memcpy(bytes, &colour, 4);
+        for (uint8 channel = 0; channel < 4; channel++) {
+            palette[shade][channel] = bytes[channel] / 255.0f;
+        }
+    }
+    glUniform4fv(glGetUniformLocation(program, "palette"), 4, &palette[0][0]);
+
+    glGenBuffers(1, &vertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+    glVertexAttribPointer(GL_ATTRIBUTE_POSITION, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), (void *) 0);
+    glVertexAttribPointer(GL_ATTRIBUTE_TEXCOORD, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat),
+                          (void *) (2 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(GL_ATTRIBUTE_POSITION);
+    glEnableVertexAttribArray(GL_ATTRIBUTE_TEXCOORD);
+
+    // Allocated once, then only ever updated
+    glGenTextures(1, &texture);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
-    //TODO: switch to non-deprecated method of drawing
-    gluBuild2DMipmaps(GL_TEXTURE_2D, 4, 160, 144, GL_RGBA, GL_UNSIGNED_BYTE, frameBuffer);
-    glColor3f(1, 1, 1);
-    glBegin(GL_QUADS);
-    glTexCoord2i(0, 1); glVertex2i(-1, -1);
-    glTexCoord2i(0, 0); glVertex2i(-1, 1);
-    glTexCoord2i(1, 0); glVertex2i(1, 1);
-    glTexCoord2i(1, 1); glVertex2i(1, -1);
-    glEnd();
-    /*glRasterPos2f(-1, 1);
-    glPixelZoom(2, -2);
-    glDrawPixels(DISPLAY_WIDTH, DISPLAY_HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, frameBuffer);*/
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE8, DISPLAY_WIDTH, DISPLAY_HEIGHT, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE,
+                 NULL);
+
+    glGenBuffers(2, pixelBuffers);
+    for (uint8 i = 0; i < 2; i++) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffers[i]);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, GL_FRAME_SIZE, NULL, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    pixelBuffer = 0;
+    textureFilled = false;
+}
+
+// Free what gl_init set up
+void gl_destroy() {
+    glDeleteBuffers(2, pixelBuffers);
+    glDeleteBuffers(1, &vertexBuffer);
+    glDeleteTextures(1, &texture);
+    glDeleteProgram(program);
+}
+
+// Copy the lines of the frame that changed into the texture, through the next pixel buffer
+static void gl_update_texture(const uint8 *shades, const bool *changedLines) {
+    int first = 0;
+    int last = DISPLAY_HEIGHT - 1;
+    if (textureFilled) {
+        while (first < DISPLAY_HEIGHT && !changedLines[first]) {
+            first++;
+        }
+        if (first == DISPLAY_HEIGHT) {
+            return;
+        }
+        while (!changedLines[last]) {
+            last--;
+        }
+    }
+    int lines = last - first + 1;
+    // This buffer was last copied from a frame ago, so mapping it doesn't wait on the copy
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffers[pixelBuffer]);
+    void *pixels = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+    if (pixels) {
+        memcpy(pixels, shades + first * DISPLAY_WIDTH, lines * DISPLAY_WIDTH);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        // Copied from the pixel buffer, so this returns without waiting for it
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, first, DISPLAY_WIDTH, lines, GL_LUMINANCE, GL_UNSIGNED_BYTE, (void *) 0);
+        textureFilled = true;
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    pixelBuffer ^= 1;
+}
+
+// Draw a frame of shades to the window. Only the lines that changed are uploaded.
+void gl_display_frame_on_window(const uint8 *shades, const bool *changedLines) {
+    gl_update_viewport();
+    glClear(GL_COLOR_BUFFER_BIT);
+    gl_update_texture(shades, changedLines);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
     frontend_swap_buffers();
 }
 
-// Clear the window 
+// Clear the window
 void gl_clear_window() {
     glClearColor(1, 1, 1, 1);
     glClear(GL_COLOR_BUFFER_BIT);
     frontend_swap_buffers();
-}
\ No newline at end of file
+}
@@ -3,7 +3,9 @@
 
 #include "../types.h"
 
-extern void gl_display_framebuffer_on_window(uint8 *frameBuffer);
+extern void gl_init();
+extern void gl_destroy();
+extern void gl_display_frame_on_window(const uint8 *shades, const bool *changedLines);
 extern void gl_clear_window();
 
 #endif /* GL_H */
\ No newline at end of file
@@ -0,0 +1,142 @@
+/* -*-mode:c; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+// Checks the GL presenter against the cpu's colour conversion. Runs under a software GL such as Mesa's
+// llvmpipe, with no window or GPU.
+//
+// Usage: gbe-gl-test [rom] [frames]
+//
+// Each rom is run twice, drawing frames on the cpu thread then on a second thread. Every frame is drawn
+// with gl_display_frame_on_window into an offscreen EGL surface the size of the screen, read back, and
+// compared with the frame converted to RGBA on the cpu. Exits 1 on the first difference or GL error, and
+// 77 (skipped) if no GL context can be made.
+#define GL_GLEXT_PROTOTYPES
+#include <EGL/egl.h>
+#include <GL/gl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../types.h"
+#include "../cpu.h"
+#include "../display.h"
+#include "../emulator.h"
+#include "../frontend/frontend.h"
+#include "gl.h"
+
+#define GL_TEST_SKIP 77
+#define GL_TEST_PITCH (DISPLAY_WIDTH * 4)
+
+typedef struct {
+    Cpu *cpu;
+    uint32 frames;
+    uint32 failures;
+} Session;
+
+// The offscreen surface has nothing to swap
+void frontend_swap_buffers() {
+}
+
+void frontend_get_window_size(windowSize *size) {
+    size->width = DISPLAY_WIDTH;
+    size->height = DISPLAY_HEIGHT;
+}
+
+// Draw the frame with GL and compare what was drawn with the cpu's conversion
+static void testVideo(uint8 *frameBuffer, void *data) {
+    Session *session = (Session *) data;
+    bool lines[DISPLAY_HEIGHT];
+    getEmulatorFrameChanges(lines, session->cpu);
+    gl_display_frame_on_window(frameBuffer, lines);
+    static uint8 expected[DISPLAY_HEIGHT * GL_TEST_PITCH];
+    static uint8 drawn[DISPLAY_HEIGHT * GL_TEST_PITCH];
+    convertEmulatorShades(frameBuffer, DISPLAY_HEIGHT, PIXEL_RGBA8888, expected, GL_TEST_PITCH);
+    glReadPixels(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, drawn);
+    // GL reads back from the bottom line up
+    for (uint8 line = 0; line < DISPLAY_HEIGHT; line++) {
+        if (memcmp(expected + line * GL_TEST_PITCH, drawn + (DISPLAY_HEIGHT - 1 - line) * GL_TEST_PITCH,
+                   GL_TEST_PITCH)) {
+            if (!session->failures) {
+                fprintf(stderr, "Frame %u differs from line %u\n", session->frames, line);
+            }
+            session->failures++;
+            break;
+        }
+    }
+    session->frames++;
+}
+
+// Make an offscreen desktop GL context current. Returns false if there's no way to.
+static bool createContext() {
+    EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, NULL, NULL)) {
+        return false;
+    }
+    EGLint configAttributes[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configs;
+    if (!eglChooseConfig(display, configAttributes, &config, 1, &configs) || !configs) {
+        return false;
+    }
+    EGLint surfaceAttributes[] = { EGL_WIDTH, DISPLAY_WIDTH, EGL_HEIGHT, DISPLAY_HEIGHT, EGL_NONE };
+    EGLSurface surface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+    if (surface == EGL_NO_SURFACE || !eglBindAPI(EGL_OPENGL_API)) {
+        return false;
+    }
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, NULL);
+    return context != EGL_NO_CONTEXT && eglMakeCurrent(display, surface, surface, context);
+}
+
+// Run the rom for the given number of frames. Returns the number that differed.
+static uint32 runRom(const char *path, uint32 frames, bool threaded) {
+    FILE *rom = fopen(path, "rb");
+    if (!rom) {
+        fprintf(stderr, "Error: could not open rom %s\n", path);
+        exit(2);
+    }
+    const char *error;
+    Session session = { 0 };
+    session.cpu = loadEmulator(rom, &error);
+    fclose(rom);
+    if (!session.cpu) {
+        fprintf(stderr, "Error: %s: %s\n", path, error);
+        exit(2);
+    }
+    setEmulatorCallbacks(testVideo, NULL, &session, session.cpu);
+    setEmulatorPixelFormat(PIXEL_SHADES, session.cpu);
+    setEmulatorThreadedRendering(threaded, session.cpu);
+    // Each test starts from an empty texture
+    gl_init();
+    while (session.frames < frames) {
+        if (stepEmulator(session.cpu)) {
+            fprintf(stderr, "Error: emulator stopped\n");
+            exit(4);
+        }
+    }
+    GLenum glError = glGetError();
+    if (glError != GL_NO_ERROR) {
+        fprintf(stderr, "GL error 0x%X\n", glError);
+        session.failures++;
+    }
+    gl_destroy();
+    destroyEmulator(session.cpu);
+    fprintf(stderr, "%s, %s: %u frames, %u differ\n", path, (threaded) ? "threaded" : "cpu thread", session.frames,
+            session.failures);
+    return session.failures;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "Error: Usage: %s [rom] [frames]\n", argv[0]);
+        exit(1);
+    }
+    if (!createContext()) {
+        fprintf(stderr, "No offscreen GL context, skipping\n");
+        return GL_TEST_SKIP;
+    }
+    fprintf(stderr, "GL: %s, %s\n", glGetString(GL_RENDERER), glGetString(GL_VERSION));
+    uint32 frames = atoi(argv[2]);
+    uint32 failures = runRom(argv[1], frames, false) + runRom(argv[1], frames, true);
+    return (failures) ? 1 : 0;
+}
@@ -4,9 +4,8 @@
 #include "common.h"
 #include "memory.h"
 #include "interrupts.h"
+#include "scheduler.h"
 
-uint8 cycles_timer = 0;
-uint16 timer_counter = 0;
 const uint16 TIMER_DURATION[] = {1024, 16, 64, 256};
 
 //set the ime (interrupt master enable)
@@ -72,32 +71,77 @@ static void interruptJoypad(Cpu *cpu) {
     cpu->wait = 12;
 }
 
-// Run timer
-static void cycleTimer(Cpu *cpu) {
+// Bring TIMA up to date with the master clock. TIMA counts each time the internal divider
+// passes a multiple of the timer duration, and is reloaded from TMA when it overflows.
+static void syncTimer(Cpu *cpu) {
+    uint64 now = cpu->clock;
     // Run timer if enabled
     if (readBit(2, &cpu->memory.io[TAC - IO_BASE])) {
-        if (timer_counter >= TIMER_DURATION[cpu->memory.io[TAC - IO_BASE] & 0b11]) {
-            timer_counter = 0;
-            if (cpu->memory.io[TIMA - IO_BASE] == 255) {
-                // Load value from TMA register into TIMA register
-                cpu->memory.io[TIMA - IO_BASE] = cpu->memory.io[TMA - IO_BASE];
-                // Set interrupt
-                setInterruptFlag(INTR_TIMER, cpu);
-            } else {
+        uint16 duration = TIMER_DURATION[cpu->memory.io[TAC - IO_BASE] & 0b11];
+        uint64 ticks = (now - cpu->divider_reset) / duration - (cpu->timer_synced - cpu->divider_reset) / duration;
+        while (ticks) {
+            uint16 untilOverflow = 256 - cpu->memory.io[TIMA - IO_BASE];
+            if (ticks < untilOverflow) {
                 // Increment the TIMA register
-                cpu->memory.io[TIMA - IO_BASE]++;
+                cpu->memory.io[TIMA - IO_BASE] += ticks;
+                break;
             }
+            ticks -= untilOverflow;
+            // Load value from TMA register into TIMA register
+            cpu->memory.io[TIMA - IO_BASE] = cpu->memory.io[TMA - IO_BASE];
+            // Set interrupt
+            setInterruptFlag(INTR_TIMER, cpu);
         }
-        timer_counter++;
     }
+    cpu->timer_synced = now;
 }
 
-// Cycle the clock for DIV
-static void cycleClock(Cpu *cpu) {
-    if (cycles_timer == 255) {
-        cpu->memory.io[DIV - IO_BASE]++;
+// Schedule the timer event for when TIMA next overflows
+static void scheduleTimer(Cpu *cpu) {
+    if (!readBit(2, &cpu->memory.io[TAC - IO_BASE])) {
+        cancelEvent(EVENT_TIMER, cpu);
+        return;
     }
-    cycles_timer++;
+    uint16 duration = TIMER_DURATION[cpu->memory.io[TAC - IO_BASE] & 0b11];
+    uint64 ticks = ((cpu->timer_synced - cpu->divider_reset) / duration) + 256 - cpu->memory.io[TIMA - IO_BASE];
+    scheduleEvent(EVENT_TIMER, cpu->divider_reset + ticks * duration, cpu);
+}
+
+// Reset the divider and timer to the current time
+void resetTimer(Cpu *cpu) {
+    cpu->divider_reset = cpu->clock;
+    cpu->timer_synced = cpu->clock;
+    scheduleTimer(cpu);
+}
+
+// Run the timer when TIMA overflows
+void timerEvent(uint64 time, Cpu *cpu) {
+    syncTimer(cpu);
+    scheduleTimer(cpu);
+}
+
+// Read a timer register (TIMA, TMA or TAC)
+uint8 readTimer(uint16 address, Cpu *cpu) {
+    syncTimer(cpu);
+    return cpu->memory.io[address - IO_BASE];
+}
+
+// Write a timer register (TIMA, TMA or TAC) and update when it will next overflow
+void writeTimer(uint16 address, uint8 value, Cpu *cpu) {
+    syncTimer(cpu);
+    cpu->memory.io[address - IO_BASE] = value;
+    scheduleTimer(cpu);
+}
+
+// DIV is the upper byte of the internal divider, which counts every cycle
+uint8 readDivider(Cpu *cpu) {
+    return (uint8) ((cpu->clock - cpu->divider_reset) >> 8);
+}
+
+// Writing to DIV resets the internal divider, which also restarts the timer's count
+void resetDivider(Cpu *cpu) {
+    syncTimer(cpu);
+    resetTimer(cpu);
 }
 
 // Return all servicable interrupts (enabled and set)
@@ -107,26 +151,18 @@ uint8 availableInterrupts(Cpu *cpu) {
 
 // Check interrupts and act on them
 void handleInterrupts(Cpu *cpu, bool active_ime, uint8 interrupts) {
-    cycleTimer(cpu);
-    cycleClock(cpu);
     //printByte(readByte(INTERRUPT_FLAGS, cpu));
     if (active_ime && interrupts) {
         if (interrupts & INTR_V_BLANK) {
             interruptVBlank(cpu);
         }
         if (interrupts & INTR_STAT) {
-            printf("interrupt STAT\n");
             interruptSTAT(cpu);
         }
         if (interrupts & INTR_TIMER) {
-            printf("interrupt timer\n");
             interruptTimer(cpu);
         }
-        if (interrupts & INTR_SERIAL) {
-            printf("interrupt serial\n");
-        }
         if (interrupts & INTR_JOYPAD) {
-            printf("interrupt joypad\n");
             interruptJoypad(cpu);
         }
     }
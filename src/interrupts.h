@@ -9,6 +9,12 @@ extern void setInterruptFlag(uint8 flag, Cpu *cpu);
 extern void clearInterruptFlag(uint8 flag, Cpu *cpu);
 extern uint8 availableInterrupts(Cpu *cpu);
 extern void handleInterrupts(Cpu *cpu, bool active_ime, uint8 interrupts);
+extern void resetTimer(Cpu *cpu);
+extern void timerEvent(uint64 time, Cpu *cpu);
+extern uint8 readTimer(uint16 address, Cpu *cpu);
+extern void writeTimer(uint16 address, uint8 value, Cpu *cpu);
+extern uint8 readDivider(Cpu *cpu);
+extern void resetDivider(Cpu *cpu);
 
 //interrupt bit offsets
 #define INTR_V_BLANK 0b1
@@ -0,0 +1,464 @@
+/* -*-mode:c; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+#ifdef JIT
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "../types.h"
+#include "../cpu.h"
+#include "../interrupts.h"
+#include "../scheduler.h"
+#include "../opcodes/opcodes.h"
+#include "../opcodes/block.h"
+#include "jit.h"
+
+#if !defined(__x86_64__) || defined(_WIN32)
+    #error "The JIT only supports x86-64 with the System V calling convention"
+#endif
+
+// Number of translated blocks held in the cache. Must be a power of two.
+#define JIT_CACHE_SIZE 1024
+// Times a block runs from the block cache before it is translated
+#define JIT_HOT_COUNT 16
+// Size of the buffer holding native code. The whole cache is dropped when it fills.
+#define JIT_CODE_SIZE (4 * 1024 * 1024)
+// Largest amount of native code a single block can translate to
+#define JIT_MAX_BLOCK_CODE 4096
+// Key used for empty slots in the cache
+#define JIT_INVALID 0xFFFFFFFF
+
+typedef int (*translation)(Cpu *cpu);
+
+typedef struct {
+    uint32 key;
+    uint16 runs;
+    translation code;
+} JitBlock;
+
+struct JitCache {
+    JitBlock blocks[JIT_CACHE_SIZE];
+    uint8 *code; // mmap'ed
+    uint32 used;
+#ifdef JIT_LOCKSTEP
+    // Registers before the native run being checked
+    struct Registers lockstepRegisters;
+    uint16 lockstepSP;
+    uint64 lockstepClock;
+#endif
+};
+
+// Native code being written for a block
+typedef struct {
+    uint8 *start;
+    uint8 *pos;
+    // Offsets of rel32 jumps to the exits
+    uint32 errorJumps[BLOCK_MAX_INSTRUCTIONS];
+    uint32 leaveJumps[BLOCK_MAX_INSTRUCTIONS];
+    uint32 bailJumps[BLOCK_MAX_INSTRUCTIONS];
+    uint8 errors;
+    uint8 leaves;
+    uint8 bails;
+} Emitter;
+
+// Offset of each register in the cpu, by its index in an opcode (B, C, D, E, H, L, (HL), A)
+static const uint32 REGISTER_8[8] = {
+    offsetof(Cpu, registers.B),
+    offsetof(Cpu, registers.C),
+    offsetof(Cpu, registers.D),
+    offsetof(Cpu, registers.E),
+    offsetof(Cpu, registers.H),
+    offsetof(Cpu, registers.L),
+    0,
+    offsetof(Cpu, registers.A)
+};
+
+// Offset of each register pair in the cpu, by its index in an opcode (BC, DE, HL, SP)
+static const uint32 REGISTER_16[4] = {
+    offsetof(Cpu, registers.BC),
+    offsetof(Cpu, registers.DE),
+    offsetof(Cpu, registers.HL),
+    offsetof(Cpu, SP)
+};
+
+#define OFFSET_ZERO offsetof(Cpu, registers.zero)
+#define OFFSET_NEGATIVE offsetof(Cpu, registers.negative)
+#define OFFSET_HALF offsetof(Cpu, registers.half)
+#define OFFSET_CARRY offsetof(Cpu, registers.carry)
+#define OFFSET_A offsetof(Cpu, registers.A)
+#define OFFSET_PC offsetof(Cpu, PC)
+#define OFFSET_CLOCK offsetof(Cpu, clock)
+#define OFFSET_NEXT_EVENT offsetof(Cpu, nextEvent)
+#define OFFSET_INSTRUCTIONS offsetof(Cpu, instructions)
+
+static void emitByte(uint8 byte, Emitter *e) {
+    *e->pos++ = byte;
+}
+
+static void emit16(uint16 value, Emitter *e) {
+    memcpy(e->pos, &value, 2);
+    e->pos += 2;
+}
+
+static void emit32(uint32 value, Emitter *e) {
+    memcpy(e->pos, &value, 4);
+    e->pos += 4;
+}
+
+static void emit64(uint64 value, Emitter *e) {
+    memcpy(e->pos, &value, 8);
+    e->pos += 8;
+}
+
+// ModRM byte and displacement addressing [rbx + offset]. The cpu pointer lives in rbx.
+static void emitCpuOperand(uint8 reg, uint32 offset, Emitter *e) {
+    emitByte(0x80 | (reg << 3) | 0x3, e);
+    emit32(offset, e);
+}
+
+// Emit a rel32 jump with the given opcode and return the offset of its displacement for patching
+static uint32 emitJump(uint8 opcode, Emitter *e) {
+    if (opcode == 0xE9) {
+        emitByte(0xE9, e);
+    } else {
+        emitByte(0x0F, e);
+        emitByte(opcode, e);
+    }
+    uint32 at = e->pos - e->start;
+    emit32(0, e);
+    return at;
+}
+
+// Point the rel32 jump at the given offset to the current position
+static void patchJump(uint32 at, Emitter *e) {
+    int32_t rel = (int32_t) ((e->pos - e->start) - (at + 4));
+    memcpy(e->start + at, &rel, 4);
+}
+
+// call to an absolute address through rax
+static void emitCall(void *function, Emitter *e) {
+    emitByte(0x48, e); emitByte(0xB8, e); emit64((uint64) (uintptr_t) function, e); // mov rax, imm64
+    emitByte(0xFF, e); emitByte(0xD0, e);                                          // call rax
+}
+
+// mov word [PC], value
+static void emitSetPC(uint16 value, Emitter *e) {
+    emitByte(0x66, e); emitByte(0xC7, e); emitCpuOperand(0, OFFSET_PC, e); emit16(value, e);
+}
+
+// Set the zero and negative flags from the result in al
+static void emitResultFlags(bool negative, Emitter *e) {
+    emitByte(0x88, e); emitCpuOperand(0, OFFSET_ZERO, e);                     // mov [zero], al
+    emitByte(0xC6, e); emitCpuOperand(0, OFFSET_NEGATIVE, e); emitByte(negative, e); // mov byte [negative], negative
+}
+
+// Translate an instruction that only touches registers into native code. Returns false if the
+// instruction has to be run by its handler.
+static bool emitNative(uint8 opcode, uint16 operand, Emitter *e) {
+    uint8 dst = (opcode >> 3) & 0x7;
+    uint8 src = opcode & 0x7;
+    if (opcode == 0x00) {
+        // NOP
+        return true;
+    } else if (opcode >= 0x40 && opcode < 0x80 && opcode != 0x76 && dst != 6 && src != 6) {
+        // LD r, r
+        emitByte(0x8A, e); emitCpuOperand(0, REGISTER_8[src], e); // mov al, [src]
+        emitByte(0x88, e); emitCpuOperand(0, REGISTER_8[dst], e); // mov [dst], al
+        return true;
+    } else if (opcode < 0x40 && src == 6 && dst != 6) {
+        // LD r, d8
+        emitByte(0xC6, e); emitCpuOperand(0, REGISTER_8[dst], e); emitByte(operand, e);
+        return true;
+    } else if (opcode < 0x40 && (opcode & 0xF) == 0x1) {
+        // LD rr, d16
+        emitByte(0x66, e); emitByte(0xC7, e); emitCpuOperand(0, REGISTER_16[opcode >> 4], e); emit16(operand, e);
+        return true;
+    } else if (opcode < 0x40 && (opcode & 0xF) == 0x3) {
+        // INC rr
+        emitByte(0x66, e); emitByte(0xFF, e); emitCpuOperand(0, REGISTER_16[opcode >> 4], e);
+        return true;
+    } else if (opcode < 0x40 && (opcode & 0xF) == 0xB) {
+        // DEC rr
+        emitByte(0x66, e); emitByte(0xFF, e); emitCpuOperand(1, REGISTER_16[opcode >> 4], e);
+        return true;
+    } else if (opcode < 0x40 && (src == 4 || src == 5) && dst != 6) {
+        // INC r / DEC r. The half-carry comes from the old value xor the result, carry isn't touched.
+        emitByte(0x8A, e); emitCpuOperand(0, REGISTER_8[dst], e);    // mov al, [r]
+        emitByte(0x88, e); emitByte(0xC1, e);                        // mov cl, al
+        emitByte(0xFE, e); emitByte(src == 4 ? 0xC0 : 0xC8, e);      // inc al / dec al
+        emitByte(0x88, e); emitCpuOperand(0, REGISTER_8[dst], e);    // mov [r], al
+        emitResultFlags(src == 5, e);
+        emitByte(0x30, e); emitByte(0xC1, e);                        // xor cl, al
+        emitByte(0x0F, e); emitByte(0xB6, e); emitByte(0xC9, e);     // movzx ecx, cl
+        emitByte(0x66, e); emitByte(0x89, e); emitCpuOperand(1, OFFSET_HALF, e); // mov [half], cx
+        return true;
+    } else if ((opcode >= 0xA0 && opcode < 0xB8 && src != 6) || opcode == 0xE6 || opcode == 0xEE || opcode == 0xF6) {
+        // AND / XOR / OR with a register or d8
+        uint8 op = (opcode & 0x38) >> 3;
+        emitByte(0x8A, e); emitCpuOperand(0, OFFSET_A, e); // mov al, [A]
+        if (opcode < 0xC0) {
+            // and al, [r] / xor al, [r] / or al, [r]
+            emitByte(op == 4 ? 0x22 : op == 5 ? 0x32 : 0x0A, e); emitCpuOperand(0, REGISTER_8[src], e);
+        } else {
+            // and al, d8 / xor al, d8 / or al, d8
+            emitByte(op == 4 ? 0x24 : op == 5 ? 0x34 : 0x0C, e); emitByte(operand, e);
+        }
+        emitByte(0x88, e); emitCpuOperand(0, OFFSET_A, e); // mov [A], al
+        emitResultFlags(false, e);
+        // Half-carry is only set by AND, carry is always reset
+        emitByte(0x66, e); emitByte(0xC7, e); emitCpuOperand(0, OFFSET_HALF, e); emit16(op == 4 ? 0x10 : 0, e);
+        emitByte(0x66, e); emitByte(0xC7, e); emitCpuOperand(0, OFFSET_CARRY, e); emit16(0, e);
+        return true;
+    }
+    return false;
+}
+
+#ifdef JIT_LOCKSTEP
+// Save the registers before a run of native code
+static void lockstepSnapshot(Cpu *cpu) {
+    cpu->jit->lockstepRegisters = cpu->registers;
+    cpu->jit->lockstepSP = cpu->SP;
+    cpu->jit->lockstepClock = cpu->clock;
+}
+
+// Re-run the instructions the native code just ran through the interpreter, and check they agree
+static void lockstepCheck(uint16 start, uint8 count, Cpu *cpu) {
+    struct Registers native = cpu->registers;
+    uint16 nativeSP = cpu->SP;
+    uint64 nativeClock = cpu->clock;
+    uint64 nativeInstructions = cpu->instructions;
+    cpu->registers = cpu->jit->lockstepRegisters;
+    cpu->SP = cpu->jit->lockstepSP;
+    cpu->clock = cpu->jit->lockstepClock;
+    cpu->PC = start;
+    for (uint8 i = 0; i < count; i++) {
+        executeNextInstruction(cpu);
+        cpu->clock += cpu->wait;
+        cpu->wait = 0;
+    }
+    cpu->instructions = nativeInstructions;
+    if (memcmp(&native, &cpu->registers, sizeof(native)) || nativeSP != cpu->SP || nativeClock != cpu->clock) {
+        printf("JIT lockstep mismatch in run at 0x%04X (bank %d) of %d instructions\n", start, cpu->currentRomBank, count);
+        printf("native:      AF=%04X BC=%04X DE=%04X HL=%04X SP=%04X clock=%llu\n", native.AF, native.BC, native.DE,
+               native.HL, nativeSP, (unsigned long long) nativeClock);
+        printf("interpreter: AF=%04X BC=%04X DE=%04X HL=%04X SP=%04X clock=%llu\n", cpu->registers.AF,
+               cpu->registers.BC, cpu->registers.DE, cpu->registers.HL, cpu->SP, (unsigned long long) cpu->clock);
+        exit(525);
+    }
+}
+#endif
+
+// Called by translated code after an instruction run by its handler. Moves the clock on and returns
+// true if execution has to leave the block, in the same cases as the block cache.
+static int afterInstruction(uint16 expected, Cpu *cpu) {
+    cpu->instructions++;
+    advanceClock(cpu->wait, cpu);
+    cpu->wait = 0;
+    return cpu->PC != expected || cpu->blockExit || cpu->halt || cpu->ime_enable || availableInterrupts(cpu);
+}
+
+// Finish a run of native instructions. The run may only go ahead if no event falls due before it
+// ends, otherwise the block bails out to the block cache from the start of the run.
+static void endRun(uint16 start, uint8 count, uint32 cycles, uint8 *runStart, Emitter *e) {
+    if (!count) {
+        e->pos = runStart;
+        return;
+    }
+    // Move the code for the run along to make room for the check in front of it
+    uint32 length = e->pos - runStart;
+    uint8 body[JIT_MAX_BLOCK_CODE];
+    memcpy(body, runStart, length);
+    e->pos = runStart;
+    emitByte(0x48, e); emitByte(0x8B, e); emitCpuOperand(0, OFFSET_CLOCK, e);      // mov rax, [clock]
+    emitByte(0x48, e); emitByte(0x05, e); emit32(cycles, e);                        // add rax, cycles
+    emitByte(0x48, e); emitByte(0x3B, e); emitCpuOperand(0, OFFSET_NEXT_EVENT, e); // cmp rax, [nextEvent]
+    // jae bail, with the PC set to the start of the run
+    emitByte(0x72, e); emitByte(14, e);                                             // jb run
+    emitSetPC(start, e);                                                            // 9 bytes
+    e->bailJumps[e->bails++] = emitJump(0xE9, e);                                   // 5 bytes
+    #ifdef JIT_LOCKSTEP
+        emitByte(0x48, e); emitByte(0x89, e); emitByte(0xDF, e); // mov rdi, rbx
+        emitCall(lockstepSnapshot, e);
+    #endif
+    memcpy(e->pos, body, length);
+    e->pos += length;
+    emitByte(0x48, e); emitByte(0x81, e); emitCpuOperand(0, OFFSET_CLOCK, e); emit32(cycles, e); // add [clock], cycles
+    emitByte(0x48, e); emitByte(0x81, e); emitCpuOperand(0, OFFSET_INSTRUCTIONS, e); emit32(count, e); // add [instructions], count
+    #ifdef JIT_LOCKSTEP
+        emitByte(0xBF, e); emit32(start, e);                     // mov edi, start
+        emitByte(0xBE, e); emit32(count, e);                     // mov esi, count
+        emitByte(0x48, e); emitByte(0x89, e); emitByte(0xDA, e); // mov rdx, rbx
+        emitCall(lockstepCheck, e);
+    #endif
+}
+
+// Translate the block at the given address into native code. Returns NULL if it's out of space.
+static translation translateBlock(uint8 *memory, uint16 start, uint16 end, Cpu *cpu) {
+    struct JitCache *jit = cpu->jit;
+    if (jit->used + JIT_MAX_BLOCK_CODE > JIT_CODE_SIZE) {
+        return NULL;
+    }
+    Emitter e = {0};
+    e.start = e.pos = jit->code + jit->used;
+
+    emitByte(0x53, &e);                                  // push rbx
+    emitByte(0x48, &e); emitByte(0x89, &e); emitByte(0xFB, &e); // mov rbx, rdi
+
+    uint16 address = start;
+    uint16 runAddress = start;
+    uint8 runCount = 0;
+    uint32 runCycles = 0;
+    uint8 *runStart = e.pos;
+    for (uint8 count = 0; count < BLOCK_MAX_INSTRUCTIONS; count++) {
+        uint8 opcode = memory[address];
+        uint8 length = opcode_length[opcode];
+        if (address + length > end) {
+            break;
+        }
+        uint16 operand = 0;
+        if (length > 1) {
+            operand = memory[address + 1];
+            if (length > 2) {
+                operand |= ((uint16) memory[address + 2]) << 8;
+            }
+        }
+        address += length;
+        if (emitNative(opcode, operand, &e)) {
+            runCount++;
+            runCycles += opcode_cycles[opcode];
+            continue;
+        }
+        endRun(runAddress, runCount, runCycles, runStart, &e);
+        // Call the handler, as the interpreter would
+        emitSetPC(address, &e);
+        emitByte(0xBF, &e); emit32(operand, &e);                         // mov edi, operand
+        emitByte(0x48, &e); emitByte(0x89, &e); emitByte(0xDE, &e);      // mov rsi, rbx
+        emitCall(instructions[opcode], &e);
+        emitByte(0x85, &e); emitByte(0xC0, &e);                          // test eax, eax
+        e.errorJumps[e.errors++] = emitJump(0x85, &e);                   // jnz error
+        emitByte(0xBF, &e); emit32(address, &e);                         // mov edi, address
+        emitByte(0x48, &e); emitByte(0x89, &e); emitByte(0xDE, &e);      // mov rsi, rbx
+        emitCall(afterInstruction, &e);
+        emitByte(0x85, &e); emitByte(0xC0, &e);                          // test eax, eax
+        e.leaveJumps[e.leaves++] = emitJump(0x85, &e);                   // jnz leave
+        runAddress = address;
+        runCount = 0;
+        runCycles = 0;
+        runStart = e.pos;
+        if (endsBlock(opcode)) {
+            break;
+        }
+    }
+    endRun(runAddress, runCount, runCycles, runStart, &e);
+    if (address == start) {
+        return NULL;
+    }
+    emitSetPC(address, &e);
+
+    // leave: return 0
+    for (uint8 i = 0; i < e.leaves; i++) {
+        patchJump(e.leaveJumps[i], &e);
+    }
+    emitByte(0x31, &e); emitByte(0xC0, &e); // xor eax, eax
+    uint32 done = emitJump(0xE9, &e);
+    // bail: return JIT_BAIL
+    for (uint8 i = 0; i < e.bails; i++) {
+        patchJump(e.bailJumps[i], &e);
+    }
+    emitByte(0xB8, &e); emit32((uint32) JIT_BAIL, &e); // mov eax, JIT_BAIL
+    // error: return the handler's error in eax
+    for (uint8 i = 0; i < e.errors; i++) {
+        patchJump(e.errorJumps[i], &e);
+    }
+    patchJump(done, &e);
+    emitByte(0x5B, &e); // pop rbx
+    emitByte(0xC3, &e); // ret
+
+    jit->used += e.pos - e.start;
+    // Keep each block aligned
+    jit->used = (jit->used + 15) & ~15;
+    return (translation) e.start;
+}
+
+// Create an empty JIT cache, along with the executable buffer for native code
+struct JitCache *createJitCache() {
+    struct JitCache *jit = (struct JitCache *) malloc(sizeof(struct JitCache));
+    if (!jit) {
+        printf("Failed to malloc JIT cache\n");
+        exit(526);
+    }
+    jit->code = mmap(NULL, JIT_CODE_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (jit->code == MAP_FAILED) {
+        printf("Failed to mmap JIT code buffer\n");
+        exit(527);
+    }
+    return jit;
+}
+
+// Free the JIT cache and its code buffer
+void freeJitCache(Cpu *cpu) {
+    munmap(cpu->jit->code, JIT_CODE_SIZE);
+    free(cpu->jit);
+}
+
+// Drop every translated block
+void resetJitCache(Cpu *cpu) {
+    for (uint16 i = 0; i < JIT_CACHE_SIZE; i++) {
+        cpu->jit->blocks[i].key = JIT_INVALID;
+        cpu->jit->blocks[i].runs = 0;
+        cpu->jit->blocks[i].code = NULL;
+    }
+    cpu->jit->used = 0;
+}
+
+// Run the block at the PC as native code once it's hot. Only rom is translated, so code in ram,
+// which may modify itself, stays with the block cache and interpreter.
+int executeJit(Cpu *cpu) {
+    uint16 start = cpu->PC;
+    uint16 bank;
+    uint8 *memory;
+    uint16 end;
+    if (cpu->halt_bug) {
+        return executeBlock(cpu);
+    } else if (start < ROM_FIXED_BASE + ROM_FIXED_BOUND) {
+        bank = 0;
+        memory = cpu->memory.rom;
+        end = ROM_FIXED_BASE + ROM_FIXED_BOUND;
+    } else if (start < ROM_SWITCHABLE_BASE + ROM_SWITCHABLE_BOUND) {
+        bank = cpu->currentRomBank;
+        memory = cpu->memory.romBank - ROM_SWITCHABLE_BASE;
+        end = ROM_SWITCHABLE_BASE + ROM_SWITCHABLE_BOUND;
+    } else {
+        return executeBlock(cpu);
+    }
+
+    uint32 key = (((uint32) bank) << 16) | start;
+    JitBlock *block = &cpu->jit->blocks[(start ^ (bank << 7)) & (JIT_CACHE_SIZE - 1)];
+    if (block->key != key) {
+        block->key = key;
+        block->runs = 0;
+        block->code = NULL;
+    }
+    if (!block->code) {
+        // Idle loops stay with the block cache, which can skip them
+        if (++block->runs < JIT_HOT_COUNT || idleBlock(bank, start, cpu)) {
+            return executeBlock(cpu);
+        }
+        block->code = translateBlock(memory, start, end, cpu);
+        if (!block->code) {
+            if (cpu->jit->used + JIT_MAX_BLOCK_CODE > JIT_CODE_SIZE) {
+                // Out of space, start again
+                resetJitCache(cpu);
+            }
+            return executeBlock(cpu);
+        }
+    }
+
+    cpu->blockExit = false;
+    int result = block->code(cpu);
+    if (result == JIT_BAIL) {
+        return executeBlock(cpu);
+    }
+    return result;
+}
+#endif
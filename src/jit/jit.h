@@ -0,0 +1,15 @@
+#ifndef JIT_H
+#define JIT_H
+#include "../types.h"
+#include "../cpu.h"
+
+// Returned by translated code when it can't run its block without an event falling due. The
+// block is then run by the block cache instead.
+#define JIT_BAIL -1
+
+extern struct JitCache *createJitCache();
+extern void resetJitCache(Cpu *cpu);
+extern void freeJitCache(Cpu *cpu);
+extern int executeJit(Cpu *cpu);
+
+#endif /* JIT_H */
@@ -5,7 +5,12 @@
 #include "interrupts.h"
 #include <stdio.h>
 
-input current_inputs = {};
+// Ask the frontend for the current inputs
+static void updateInputs(Cpu *cpu) {
+    if (cpu->inputCallback) {
+        cpu->inputCallback(&cpu->inputs, cpu->callbackData);
+    }
+}
 
 // Return the hardware representation of the input state.
 // 0 is used to indicate value, thus 0xF means no buttons pressed.
@@ -29,31 +34,31 @@ uint8 getJoypadState(Cpu *cpu) {
     //printf("Status: 0x%X\n", cpu->memory.io[JOYPAD - IO_BASE]);
     // Select the column
     if (readBit(4, &cpu->memory.io[JOYPAD - IO_BASE])) {
-        getInput(&current_inputs);
-        if (current_inputs.a) {
+        updateInputs(cpu);
+        if (cpu->inputs.a) {
             cpu->memory.io[JOYPAD - IO_BASE] &= 0xFE;
         }
-        if (current_inputs.b) {
+        if (cpu->inputs.b) {
             cpu->memory.io[JOYPAD - IO_BASE] &= 0xFD;
         }
-        if (current_inputs.start) {
+        if (cpu->inputs.start) {
             cpu->memory.io[JOYPAD - IO_BASE] &= 0xF7;
         }
-        if (current_inputs.select) {
+        if (cpu->inputs.select) {
             cpu->memory.io[JOYPAD - IO_BASE] &= 0xFB;
         }
     } else if (readBit(5, &cpu->memory.io[JOYPAD - IO_BASE])) {
-        getInput(&current_inputs);
-        if (current_inputs.up) {
+        updateInputs(cpu);
+        if (cpu->inputs.up) {
             cpu->memory.io[JOYPAD - IO_BASE] &= 0xFB;
         }
-        if (current_inputs.down) {
+        if (cpu->inputs.down) {
             cpu->memory.io[JOYPAD - IO_BASE] &= 0xF7;
         }
-        if (current_inputs.left) {
+        if (cpu->inputs.left) {
             cpu->memory.io[JOYPAD - IO_BASE] &= 0xFD;
         }
-        if (current_inputs.right) {
+        if (cpu->inputs.right) {
             cpu->memory.io[JOYPAD - IO_BASE] &= 0xFE;
         }
     }
@@ -3,6 +3,7 @@
 #include "mbc.h"
 #include "types.h"
 #include "cpu.h"
+#include "memory.h"
 
 static uint8 readBasic(uint16 address, Cpu *cpu);
 static void writeNone(uint16 address, uint8 value, Cpu *cpu);
@@ -21,6 +22,7 @@ static void switchRomBank(uint16 bank, Cpu *cpu) {
     }
     cpu->currentRomBank = bank;
     cpu->memory.romBank = cpu->memory.rom + (ROM_BANK_SIZE * bank);
+    mapRomBank(cpu);
 }
 
 static void switchRamBank(uint8 bank, Cpu *cpu) {
@@ -30,6 +32,7 @@ static void switchRamBank(uint8 bank, Cpu *cpu) {
     }
     cpu->currentRamBank = bank;
     cpu->memory.ramBank = cpu->memory.ram + (RAM_BANK_SIZE * bank);
+    mapRamBank(cpu);
 }
 
 // Setup read/write callbacks to the correct function to handle the given mbc number
@@ -81,6 +84,7 @@ static void writeMBC1(uint16 address, uint8 value, Cpu *cpu) {
 
     if (address < 0x2000) {
         cpu->RAM_enable = (value == 0x0A);
+        mapRamBank(cpu);
     } else if (address < 0x4000) {
         uint8 bank = value & 0x1F;
         if (!bank) bank = 0x01;
@@ -113,6 +117,7 @@ static void writeMBC3(uint16 address, uint8 value, Cpu *cpu) {
 
     if (address < 0x2000) {
         cpu->RAM_enable = (value == 0x0A);
+        mapRamBank(cpu);
     } else if (address < 0x4000) {
         uint8 bank = value & 0x7F;
         if (!bank) bank = 0x01;
@@ -138,6 +143,7 @@ static void writeMBC5(uint16 address, uint8 value, Cpu *cpu) {
 
     if (address < 0x2000) {
         cpu->RAM_enable = (value == 0x0A);
+        mapRamBank(cpu);
     } else if (address < 0x3000) {
         uint16 bank = (cpu->currentRomBank & 0x100) | value;
         switchRomBank(bank, cpu);
@@ -4,8 +4,10 @@
 #include "mbc.h"
 #include "screen.h"
 #include "display.h"
+#include "renderer.h"
 #include "joypad.h"
 #include "interrupts.h"
+#include "opcodes/block.h"
 #include <stdio.h>
 
 // Handle reads from IO registers
@@ -15,8 +17,9 @@ static uint8 readIORegisters(uint16 address, Cpu *cpu) {
         printf("Error: readIORegisters passed incorrect address: %X\n", address);
     }
     switch (address) {
-        // Redirected reads
+        // Redirected reads. The buttons can change without an event.
         case JOYPAD:
+            cpu->volatileRead = true;
             return getJoypadState(cpu);
         // Masked reads
         case STAT:
@@ -24,7 +27,17 @@ static uint8 readIORegisters(uint16 address, Cpu *cpu) {
         case INTERRUPT_FLAGS:
             return cpu->memory.io[index] | 0xE0;
         case TAC:
-            return cpu->memory.io[index] | 0xF8;
+            return readTimer(address, cpu) | 0xF8;
+        // Timer reads
+        case TMA:
+            return readTimer(address, cpu);
+        // Clock dependent reads
+        case TIMA:
+            cpu->volatileRead = true;
+            return readTimer(address, cpu);
+        case DIV:
+            cpu->volatileRead = true;
+            return readDivider(cpu);
         // Pass through reads
         case WINDOW_X:
         case WINDOW_Y:
@@ -36,9 +49,6 @@ static uint8 readIORegisters(uint16 address, Cpu *cpu) {
         case SCROLL_X:
         case SCROLL_Y:
         case LCDC:
-        case TMA:
-        case TIMA:
-        case DIV:
             return cpu->memory.io[index];
         // Everything else
         default:
@@ -47,8 +57,8 @@ static uint8 readIORegisters(uint16 address, Cpu *cpu) {
     }
 }
 
-// Read a byte from a given memory address
-uint8 readByte(uint16 address, Cpu *cpu) {
+// Read a byte from memory that isn't mapped into the page table
+static uint8 readSlow(uint16 address, Cpu *cpu) {
     if (address < ROM_FIXED_BASE + ROM_FIXED_BOUND) {
         // Cartridge base
         return cpu->memory.rom[address - ROM_FIXED_BASE];
@@ -70,7 +80,7 @@ uint8 readByte(uint16 address, Cpu *cpu) {
         } else if (address < WRAM_ECHO_BASE + WRAM_FIXED_BOUND) {
             return cpu->memory.wram[address - WRAM_ECHO_BASE];
         } else {
-            return cpu->memory.wramBank[address - WRAM_ECHO_BASE];
+            return cpu->memory.wramBank[address - WRAM_ECHO_BASE - WRAM_FIXED_BOUND];
         }
     } else if (address < OAM_BASE + OAM_BOUND) {
         // Oam (only readable in STAT modes 0 and 1)
@@ -91,23 +101,94 @@ uint8 readByte(uint16 address, Cpu *cpu) {
     }
 }
 
+// Read a byte from a given memory address
+uint8 readByte(uint16 address, Cpu *cpu) {
+    uint8 *page = cpu->memory.readMap[address >> 8];
+    if (page) {
+        return page[address & 0xFF];
+    }
+    return readSlow(address, cpu);
+}
+
+// Point the fetch region at the block of memory holding the PC. Regions with side effects on read
+// are left empty so fetches go through readByte.
+static void updateFetchRegion(Cpu *cpu) {
+    uint16 address = cpu->PC;
+    uint8 *memory = NULL;
+    uint16 base = 0;
+    uint16 bound = 0;
+    if (address < ROM_FIXED_BASE + ROM_FIXED_BOUND) {
+        memory = cpu->memory.rom;
+        base = ROM_FIXED_BASE;
+        bound = ROM_FIXED_BOUND;
+    } else if (address < ROM_SWITCHABLE_BASE + ROM_SWITCHABLE_BOUND) {
+        memory = cpu->memory.romBank;
+        base = ROM_SWITCHABLE_BASE;
+        bound = ROM_SWITCHABLE_BOUND;
+    } else if (address < VRAM_BASE + VRAM_BOUND) {
+        memory = cpu->memory.vramBank;
+        base = VRAM_BASE;
+        bound = VRAM_BOUND;
+    } else if (address < EXTERNAL_RAM_BASE + EXTERNAL_RAM_BOUND) {
+        if (cpu->memory.readMap[address >> 8]) {
+            memory = cpu->memory.ramBank;
+            base = EXTERNAL_RAM_BASE;
+            bound = EXTERNAL_RAM_BOUND;
+        }
+    } else if (address < WRAM_FIXED_BASE + WRAM_FIXED_BOUND) {
+        memory = cpu->memory.wram;
+        base = WRAM_FIXED_BASE;
+        bound = WRAM_FIXED_BOUND;
+    } else if (address < WRAM_SWITCHABLE_BASE + WRAM_SWITCHABLE_BOUND) {
+        memory = cpu->memory.wramBank;
+        base = WRAM_SWITCHABLE_BASE;
+        bound = WRAM_SWITCHABLE_BOUND;
+    } else if (address >= HRAM_BASE && address < HRAM_BASE + HRAM_BOUND) {
+        memory = cpu->memory.hram;
+        base = HRAM_BASE;
+        bound = HRAM_BOUND;
+    }
+    cpu->fetch = memory;
+    cpu->fetchBase = base;
+    cpu->fetchBound = (memory) ? bound : 0;
+}
+
+// Drop the fetch region, so it's found again on the next fetch. Used when banks are switched.
+void resetFetchRegion(Cpu *cpu) {
+    cpu->fetchBound = 0;
+}
+
 // Read next byte from the instruction pointer, then increment it
 uint8 readNextByte(Cpu *cpu) {
-    uint8 byte = readByte(cpu->PC, cpu);
-    if (cpu->halt_bug) {
-        cpu->halt_bug = false;
-    } else {
-        cpu->PC++;
+    uint16 offset = cpu->PC - cpu->fetchBase;
+    if (offset >= cpu->fetchBound) {
+        updateFetchRegion(cpu);
+        offset = cpu->PC - cpu->fetchBase;
+        if (offset >= cpu->fetchBound) {
+            return readByte(cpu->PC++, cpu);
+        }
     }
-    return byte;
+    cpu->PC++;
+    return cpu->fetch[offset];
 }
 
 void transferOAM(uint8 value, Cpu *cpu) {
     //printf("DMA\n");
     uint16 address = ((uint16) value) << 8;
     //printf("address: 0x%X\n", address);
+    bool changed = false;
     for (uint8 i = 0; i < 160; i++) {
-        cpu->memory.oam[i] = readByte(address + i, cpu);
+        uint8 byte = readByte(address + i, cpu);
+        if (cpu->memory.oam[i] != byte) {
+            cpu->memory.oam[i] = byte;
+            changed = true;
+            if (cpu->renderer) {
+                logRendererWrite(OAM_BASE + i, byte, cpu);
+            }
+        }
+    }
+    if (changed) {
+        markSpritesDirty(cpu);
     }
     // Transfer OAM takes 160 cycles.
     cpu->wait += 160;
@@ -125,15 +206,15 @@ static void writeIORegisters(uint16 address, uint8 value, Cpu *cpu) {
             transferOAM(value, cpu);
             break;
         case BG_PALETTE:
-            updateBackgroundColour(value);
+            updateBackgroundColour(value, cpu);
             cpu->memory.io[index] = value;
             break;
         case SP_PALETTE_0:
-            updateSpritePalette(0, value);
+            updateSpritePalette(0, value, cpu);
             cpu->memory.io[index] = value;
             break;
         case SP_PALETTE_1:
-            updateSpritePalette(1, value);
+            updateSpritePalette(1, value, cpu);
             cpu->memory.io[index] = value;
             break;
         // Masked writes
@@ -153,7 +234,17 @@ static void writeIORegisters(uint16 address, uint8 value, Cpu *cpu) {
             }
             break;
         case DIV:
-            cpu->memory.io[index] = 0;
+            resetDivider(cpu);
+            break;
+        case LCDC:
+            cpu->memory.io[index] = value;
+            updateScreenControl(cpu);
+            break;
+        // Timer writes
+        case TAC:
+        case TMA:
+        case TIMA:
+            writeTimer(address, value, cpu);
             break;
         // Pass through writes
         case WINDOW_X:
@@ -162,10 +253,6 @@ static void writeIORegisters(uint16 address, uint8 value, Cpu *cpu) {
         case SCANLINE:
         case SCROLL_X:
         case SCROLL_Y:
-        case LCDC:
-        case TAC:
-        case TMA:
-        case TIMA:
         case SB:
         case INTERRUPT_FLAGS:
             cpu->memory.io[index] = value;
@@ -174,16 +261,46 @@ static void writeIORegisters(uint16 address, uint8 value, Cpu *cpu) {
         default:
             return;
     }
+    // Pass on the registers the display reads to a renderer thread
+    if (cpu->renderer) {
+        switch (address) {
+            case LCDC:
+            case SCROLL_X:
+            case SCROLL_Y:
+            case WINDOW_X:
+            case WINDOW_Y:
+            case BG_PALETTE:
+            case SP_PALETTE_0:
+            case SP_PALETTE_1:
+                logRendererWrite(address, value, cpu);
+                break;
+            default:
+                break;
+        }
+    }
 }
 
-//write a byte to the given memory address
-void writeByte(uint16 address, uint8 value, Cpu *cpu) {
+// Write a byte to memory that isn't mapped into the page table
+static void writeSlow(uint16 address, uint8 value, Cpu *cpu) {
     if (address < ROM_SWITCHABLE_BASE + ROM_SWITCHABLE_BOUND) {
-        // Cartridge and cartridge bank
+        // Cartridge and cartridge bank. The bank may change under the running block.
+        cpu->blockExit = true;
         return cpu->writeMBC(address, value, cpu);
     } else if (address < VRAM_BASE + VRAM_BOUND) {
-        // Vram
-        cpu->memory.vramBank[address - VRAM_BASE] = value;
+        // Vram. Changed tiles are decoded again before the next scanline, and changed map entries drawn again
+        // into the map images.
+        uint16 offset = address - VRAM_BASE;
+        if (cpu->memory.vramBank[offset] != value) {
+            cpu->memory.vramBank[offset] = value;
+            if (address < BG_MAP_DATA1_BASE) {
+                markTileDirty(offset >> 4, cpu);
+            } else {
+                markMapDirty(cpu);
+            }
+            if (cpu->renderer) {
+                logRendererWrite(address, value, cpu);
+            }
+        }
     } else if (address < EXTERNAL_RAM_BASE + EXTERNAL_RAM_BOUND) {
         // Cartridge ram
         if (cpu->RAM_enable) {
@@ -198,12 +315,18 @@ void writeByte(uint16 address, uint8 value, Cpu *cpu) {
         } else if (address < WRAM_ECHO_BASE + WRAM_FIXED_BOUND) {
             cpu->memory.wram[address - WRAM_ECHO_BASE] = value;
         } else {
-            cpu->memory.wramBank[address - WRAM_ECHO_BASE] = value;
+            cpu->memory.wramBank[address - WRAM_ECHO_BASE - WRAM_FIXED_BOUND] = value;
         }
     } else if (address < OAM_BASE + OAM_BOUND) {
         // Oam (only writable in STAT modes 0 and 1)
         // TODO: limit writing to those modes
-        cpu->memory.oam[address - OAM_BASE] = value;
+        if (cpu->memory.oam[address - OAM_BASE] != value) {
+            cpu->memory.oam[address - OAM_BASE] = value;
+            markSpritesDirty(cpu);
+            if (cpu->renderer) {
+                logRendererWrite(address, value, cpu);
+            }
+        }
     } else if (address < UNUSABLE_BASE + UNUSABLE_BOUND) {
         // Unusable
         printf("Error: write to unusable memory!\n");
@@ -213,12 +336,72 @@ void writeByte(uint16 address, uint8 value, Cpu *cpu) {
         writeIORegisters(address, value, cpu);
     } else if (address < HRAM_BASE + HRAM_BOUND) {
         cpu->memory.hram[address - HRAM_BASE] = value;
+        // Code such as OAM DMA routines run from hram
+        if (cpu->blocks->hramCode[address - HRAM_BASE]) {
+            invalidateHramBlocks(cpu);
+        }
     } else {
         // 0xFFFF IE
         cpu->memory.ie = value;
     }
 }
 
+//write a byte to the given memory address
+void writeByte(uint16 address, uint8 value, Cpu *cpu) {
+    uint8 *page = cpu->memory.writeMap[address >> 8];
+    if (page) {
+        page[address & 0xFF] = value;
+        return;
+    }
+    writeSlow(address, value, cpu);
+}
+
+// Point the pages of a region at the matching pages of host memory. NULL sends them to the slow path.
+static void mapPages(uint8 **map, uint16 base, uint16 bound, uint8 *memory) {
+    for (uint16 page = 0; page < (bound >> 8); page++) {
+        map[(base >> 8) + page] = (memory) ? memory + (page << 8) : NULL;
+    }
+}
+
+// Update the page table after the rom bank is switched
+void mapRomBank(Cpu *cpu) {
+    mapPages(cpu->memory.readMap, ROM_SWITCHABLE_BASE, ROM_SWITCHABLE_BOUND, cpu->memory.romBank);
+    resetFetchRegion(cpu);
+}
+
+// Update the page table after the ram bank is switched, or ram is enabled or disabled
+void mapRamBank(Cpu *cpu) {
+    // Disabled ram is left to the MBC
+    uint8 *ram = (cpu->RAM_enable) ? cpu->memory.ramBank : NULL;
+    mapPages(cpu->memory.readMap, EXTERNAL_RAM_BASE, EXTERNAL_RAM_BOUND, ram);
+    mapPages(cpu->memory.writeMap, EXTERNAL_RAM_BASE, EXTERNAL_RAM_BOUND, ram);
+    resetFetchRegion(cpu);
+}
+
+// Build the page table used by readByte and writeByte. Pages for rom writes (MBC registers),
+// vram writes, OAM and IO are always left to the slow path.
+void mapMemory(Cpu *cpu) {
+    for (uint16 page = 0; page < 0x100; page++) {
+        cpu->memory.readMap[page] = NULL;
+        cpu->memory.writeMap[page] = NULL;
+    }
+    resetFetchRegion(cpu);
+    mapPages(cpu->memory.readMap, ROM_FIXED_BASE, ROM_FIXED_BOUND, cpu->memory.rom);
+    mapRomBank(cpu);
+    mapPages(cpu->memory.readMap, VRAM_BASE, VRAM_BOUND, cpu->memory.vramBank);
+    // Vram writes go through writeSlow so the display knows which tiles and map entries have changed
+    mapRamBank(cpu);
+    mapPages(cpu->memory.readMap, WRAM_FIXED_BASE, WRAM_FIXED_BOUND, cpu->memory.wram);
+    mapPages(cpu->memory.writeMap, WRAM_FIXED_BASE, WRAM_FIXED_BOUND, cpu->memory.wram);
+    mapPages(cpu->memory.readMap, WRAM_SWITCHABLE_BASE, WRAM_SWITCHABLE_BOUND, cpu->memory.wramBank);
+    mapPages(cpu->memory.writeMap, WRAM_SWITCHABLE_BASE, WRAM_SWITCHABLE_BOUND, cpu->memory.wramBank);
+    // Echo of working ram, up to OAM
+    mapPages(cpu->memory.readMap, WRAM_ECHO_BASE, WRAM_FIXED_BOUND, cpu->memory.wram);
+    mapPages(cpu->memory.writeMap, WRAM_ECHO_BASE, WRAM_FIXED_BOUND, cpu->memory.wram);
+    mapPages(cpu->memory.readMap, WRAM_ECHO_BASE + WRAM_FIXED_BOUND, WRAM_ECHO_BOUND - WRAM_FIXED_BOUND, cpu->memory.wramBank);
+    mapPages(cpu->memory.writeMap, WRAM_ECHO_BASE + WRAM_FIXED_BOUND, WRAM_ECHO_BOUND - WRAM_FIXED_BOUND, cpu->memory.wramBank);
+}
+
 //read a short from a given memory address
 uint16 readShort(uint16 address, Cpu *cpu) {
     return (((uint16) readByte(address + 1, cpu)) << 8) + readByte(address, cpu);
@@ -245,21 +428,67 @@ uint16 readShortFromStack(Cpu *cpu) {
 
 //set a flag
 void setFlag(uint8 flag, Cpu *cpu) {
-    //create a mask for the flag, then OR it to set the flag to one
-    cpu->registers.F |= (0b1 << flag);
+    switch (flag) {
+        case ZF:
+            cpu->registers.zero = 0;
+            break;
+        case NF:
+            cpu->registers.negative = true;
+            break;
+        case HF:
+            cpu->registers.half = 0x10;
+            break;
+        case CF:
+            cpu->registers.carry = 0x100;
+            break;
+    }
 }
 
 //clear a flag
 void clearFlag(uint8 flag, Cpu *cpu) {
-    /* Reset Flag */
-    //create a mask for the flag, inverse it, then AND it to set the flag to zero
-    cpu->registers.F &= ~(0b1 << flag);
+    switch (flag) {
+        case ZF:
+            cpu->registers.zero = 1;
+            break;
+        case NF:
+            cpu->registers.negative = false;
+            break;
+        case HF:
+            cpu->registers.half = 0;
+            break;
+        case CF:
+            cpu->registers.carry = 0;
+            break;
+    }
 }
 
 //return true if a flag is set. Return false otherwise.
 bool readFlag(uint8 flag, Cpu *cpu) {
-    //get flags register, shift down to correct flag offset and compare
-    return ((cpu->registers.F >> flag) & 0b1) == 0b1;
+    switch (flag) {
+        case ZF:
+            return !cpu->registers.zero;
+        case NF:
+            return cpu->registers.negative;
+        case HF:
+            return (cpu->registers.half >> 4) & 0b1;
+        case CF:
+            return (cpu->registers.carry >> 8) & 0b1;
+        default:
+            return false;
+    }
+}
+
+//build the F register from the unpacked flags
+uint8 readFlagsRegister(Cpu *cpu) {
+    return (readFlag(ZF, cpu) << ZF) | (readFlag(NF, cpu) << NF) | (readFlag(HF, cpu) << HF) | (readFlag(CF, cpu) << CF);
+}
+
+//unpack the flags from a value written to the F register
+void writeFlagsRegister(uint8 value, Cpu *cpu) {
+    cpu->registers.zero = !((value >> ZF) & 0b1);
+    cpu->registers.negative = (value >> NF) & 0b1;
+    cpu->registers.half = ((value >> HF) & 0b1) << 4;
+    cpu->registers.carry = ((value >> CF) & 0b1) << 8;
 }
 
 //return true if a bit in a register is set. Return false otherwise.
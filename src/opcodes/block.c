@@ -0,0 +1,293 @@
+/* -*-mode:c; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../types.h"
+#include "../cpu.h"
+#include "../interrupts.h"
+#include "../scheduler.h"
+#include "../memory.h"
+#include "opcodes.h"
+#include "block.h"
+
+// Key used for empty slots in the cache
+#define BLOCK_INVALID 0xFFFFFFFF
+// Bank used in the key of blocks decoded from hram
+#define BLOCK_HRAM_BANK 0xFFFF
+// Most cycles an idle loop is skipped by at once, about a frame
+#define IDLE_SKIP_LIMIT 70224
+
+// Build the key for a block from the bank and address it starts at
+static inline uint32 blockKey(uint16 bank, uint16 address) {
+    return (((uint32) bank) << 16) | address;
+}
+
+// Find the slot in the cache used by a given bank and address
+static inline Block *blockSlot(uint16 bank, uint16 address, Cpu *cpu) {
+    return &cpu->blocks->blocks[(address ^ (bank << 7)) & (BLOCK_CACHE_SIZE - 1)];
+}
+
+// Return true if the opcode always leaves the block, or changes state that is only checked between
+// instructions (IME, halt). Conditional jumps don't end a block, execution leaves it when taken.
+bool endsBlock(uint8 opcode) {
+    switch (opcode) {
+        case 0x10: // STOP
+        case 0x18: // JR r8
+        case 0x76: // HALT
+        case 0xC3: // JP a16
+        case 0xC7: // RST 0x00
+        case 0xC9: // RET
+        case 0xCD: // CALL a16
+        case 0xCF: // RST 0x08
+        case 0xD7: // RST 0x10
+        case 0xD9: // RETI
+        case 0xDF: // RST 0x18
+        case 0xE7: // RST 0x20
+        case 0xE9: // JP (HL)
+        case 0xEF: // RST 0x28
+        case 0xF3: // DI
+        case 0xF7: // RST 0x30
+        case 0xFB: // EI
+        case 0xFF: // RST 0x38
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Return true if running the instruction again, with the same registers and memory, does the same
+// thing. It mustn't write memory, use the stack, or change IME or halt.
+static bool idleSafe(uint8 opcode, uint16 operand) {
+    if (opcode >= 0x40 && opcode < 0x80) {
+        // LD r,r' and LD r,(HL), but not LD (HL),r or HALT
+        return opcode < 0x70 || opcode > 0x77;
+    } else if (opcode >= 0x80 && opcode < 0xC0) {
+        // ALU ops on A, including CP
+        return true;
+    }
+    switch (opcode) {
+        case 0xCB:
+            // BIT reads (HL), the other prefixed ops write it back
+            return (operand >= 0x40 && operand < 0x80) || (operand & 0x07) != 0x06;
+        case 0x00: // NOP
+        case 0x01: case 0x11: case 0x21: // LD rr,d16
+        case 0x03: case 0x13: case 0x23: // INC rr
+        case 0x0B: case 0x1B: case 0x2B: // DEC rr
+        case 0x04: case 0x0C: case 0x14: case 0x1C: case 0x24: case 0x2C: case 0x3C: // INC r
+        case 0x05: case 0x0D: case 0x15: case 0x1D: case 0x25: case 0x2D: case 0x3D: // DEC r
+        case 0x06: case 0x0E: case 0x16: case 0x1E: case 0x26: case 0x2E: case 0x3E: // LD r,d8
+        case 0x07: case 0x0F: case 0x17: case 0x1F: // Rotate A
+        case 0x27: case 0x2F: case 0x37: case 0x3F: // DAA, CPL, SCF, CCF
+        case 0x0A: case 0x1A: case 0x2A: case 0x3A: // LD A,(rr)
+        case 0xF0: case 0xF2: case 0xFA: // LD A,(a8), LD A,(C), LD A,(a16)
+        case 0xC6: case 0xCE: case 0xD6: case 0xDE: case 0xE6: case 0xEE: case 0xF6: case 0xFE: // ALU d8
+        case 0x18: case 0x20: case 0x28: case 0x30: case 0x38: // JR
+        case 0xC2: case 0xC3: case 0xCA: case 0xD2: case 0xDA: // JP
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Return true if the instruction is a jump to the target address
+static bool jumpsTo(uint8 opcode, uint16 operand, uint16 address, uint16 target) {
+    switch (opcode) {
+        case 0x18: case 0x20: case 0x28: case 0x30: case 0x38: // JR
+            return (uint16) (address + 2 + (int8) operand) == target;
+        case 0xC2: case 0xC3: case 0xCA: case 0xD2: case 0xDA: // JP
+            return operand == target;
+        default:
+            return false;
+    }
+}
+
+// Decode instructions from memory into the block until one ends it, or the end of the region is reached.
+// Memory points to where address 0 would be for the region. A jump back to the start also ends the
+// block, as the block is then a loop.
+static void decodeBlock(Block *block, uint8 *memory, uint16 start, uint16 end, bool hram, Cpu *cpu) {
+    uint16 address = start;
+    bool safe = true;
+    block->count = 0;
+    block->idle = false;
+    while (block->count < BLOCK_MAX_INSTRUCTIONS) {
+        uint8 opcode = memory[address];
+        uint8 length = opcode_length[opcode];
+        // Leave instructions that run over the end of the region to the interpreter
+        if (address + length > end) {
+            break;
+        }
+        BlockEntry *entry = &block->entries[block->count++];
+        entry->handler = instructions[opcode];
+        entry->length = length;
+        entry->operand = 0;
+        if (length > 1) {
+            entry->operand = memory[address + 1];
+            if (length > 2) {
+                entry->operand |= ((uint16) memory[address + 2]) << 8;
+            }
+        }
+        if (hram) {
+            for (uint8 i = 0; i < length; i++) {
+                cpu->blocks->hramCode[address + i - HRAM_BASE] = true;
+            }
+        }
+        safe &= idleSafe(opcode, entry->operand);
+        if (jumpsTo(opcode, entry->operand, address, start)) {
+            block->idle = safe;
+            break;
+        }
+        address += length;
+        if (endsBlock(opcode)) {
+            break;
+        }
+    }
+}
+
+// Create an empty block cache
+struct BlockCache *createBlockCache() {
+    struct BlockCache *cache = (struct BlockCache *) malloc(sizeof(struct BlockCache));
+    if (!cache) {
+        printf("Failed to malloc block cache\n");
+        exit(524);
+    }
+    return cache;
+}
+
+// Empty the block cache
+void resetBlockCache(Cpu *cpu) {
+    for (uint16 i = 0; i < BLOCK_CACHE_SIZE; i++) {
+        cpu->blocks->blocks[i].key = BLOCK_INVALID;
+    }
+    for (uint8 i = 0; i < HRAM_BOUND; i++) {
+        cpu->blocks->hramCode[i] = false;
+    }
+    cpu->blockExit = false;
+}
+
+// Code in hram has been overwritten. Drop every block decoded from hram and leave the current block.
+void invalidateHramBlocks(Cpu *cpu) {
+    for (uint16 i = 0; i < BLOCK_CACHE_SIZE; i++) {
+        if ((cpu->blocks->blocks[i].key >> 16) == BLOCK_HRAM_BANK) {
+            cpu->blocks->blocks[i].key = BLOCK_INVALID;
+        }
+    }
+    for (uint8 i = 0; i < HRAM_BOUND; i++) {
+        cpu->blocks->hramCode[i] = false;
+    }
+    cpu->blockExit = true;
+}
+
+// Return true if the cached block at the given bank and address is an idle loop candidate
+bool idleBlock(uint16 bank, uint16 address, Cpu *cpu) {
+    Block *block = blockSlot(bank, address, cpu);
+    return block->key == blockKey(bank, address) && block->idle;
+}
+
+// Registers compared between passes of an idle loop
+typedef struct {
+    uint16 AF;
+    uint16 BC;
+    uint16 DE;
+    uint16 HL;
+    uint16 SP;
+} IdleState;
+
+static inline IdleState idleState(Cpu *cpu) {
+    IdleState state = {
+        .AF = (cpu->registers.A << 8) | readFlagsRegister(cpu),
+        .BC = cpu->registers.BC,
+        .DE = cpu->registers.DE,
+        .HL = cpu->registers.HL,
+        .SP = cpu->SP
+    };
+    return state;
+}
+
+// An idle loop pass that ended back at its start with the registers it began with, and no write, event
+// or read of a register that changes without one, will repeat exactly until the next event. Move the clock
+// on by as many whole passes as fit before it, up to IDLE_SKIP_LIMIT cycles, so the last passes run normally
+// and see the event at the right time. With no event scheduled nothing can end the loop, so it isn't skipped.
+static void skipIdleLoop(uint16 start, IdleState before, uint64 startClock, Cpu *cpu) {
+    IdleState after = idleState(cpu);
+    uint64 pass = cpu->clock - startClock;
+    if (cpu->PC != start || cpu->volatileRead || cpu->blockExit || cpu->halt || cpu->ime_enable
+        || cpu->nextEvent == EVENT_NEVER || availableInterrupts(cpu) || !pass
+        || memcmp(&before, &after, sizeof(IdleState))) {
+        return;
+    }
+    uint64 passes = (cpu->nextEvent - 1 - cpu->clock) / pass;
+    if (passes > IDLE_SKIP_LIMIT / pass) {
+        passes = IDLE_SKIP_LIMIT / pass;
+    }
+    advanceClock((uint32) (passes * pass), cpu);
+}
+
+// Execute the block starting at the PC, decoding it first if it isn't cached. Execution stops early
+// when a jump is taken, or an interrupt, halt, IME change or bank switch needs the main loop.
+// Code outside rom and hram is run by the interpreter.
+int executeBlock(Cpu *cpu) {
+    uint16 start = cpu->PC;
+    uint16 bank;
+    uint8 *memory;
+    uint16 end;
+    bool hram = false;
+    if (cpu->halt_bug) {
+        // The PC doesn't move on the next fetch
+        return executeNextInstruction(cpu);
+    } else if (start < ROM_FIXED_BASE + ROM_FIXED_BOUND) {
+        bank = 0;
+        memory = cpu->memory.rom;
+        end = ROM_FIXED_BASE + ROM_FIXED_BOUND;
+    } else if (start < ROM_SWITCHABLE_BASE + ROM_SWITCHABLE_BOUND) {
+        bank = cpu->currentRomBank;
+        memory = cpu->memory.romBank - ROM_SWITCHABLE_BASE;
+        end = ROM_SWITCHABLE_BASE + ROM_SWITCHABLE_BOUND;
+    } else if (start >= HRAM_BASE && start < HRAM_BASE + HRAM_BOUND) {
+        bank = BLOCK_HRAM_BANK;
+        memory = cpu->memory.hram - HRAM_BASE;
+        end = HRAM_BASE + HRAM_BOUND;
+        hram = true;
+    } else {
+        return executeNextInstruction(cpu);
+    }
+
+    uint32 key = blockKey(bank, start);
+    Block *block = blockSlot(bank, start, cpu);
+    if (block->key != key) {
+        decodeBlock(block, memory, start, end, hram, cpu);
+        block->key = key;
+        if (!block->count) {
+            return executeNextInstruction(cpu);
+        }
+    }
+
+    IdleState before;
+    uint64 startClock = cpu->clock;
+    uint64 due = cpu->nextEvent;
+    if (block->idle) {
+        before = idleState(cpu);
+        cpu->volatileRead = false;
+    }
+
+    cpu->blockExit = false;
+    uint16 expected = start;
+    for (uint8 i = 0; i < block->count; i++) {
+        BlockEntry *entry = &block->entries[i];
+        expected += entry->length;
+        cpu->PC = expected;
+        cpu->instructions++;
+        int errNum = entry->handler(entry->operand, cpu);
+        if (errNum) {
+            return errNum;
+        }
+        advanceClock(cpu->wait, cpu);
+        cpu->wait = 0;
+        if (cpu->PC != expected || cpu->blockExit || cpu->halt || cpu->ime_enable || availableInterrupts(cpu)) {
+            break;
+        }
+    }
+    if (block->idle && cpu->nextEvent == due) {
+        skipIdleLoop(start, before, startClock, cpu);
+    }
+    return 0;
+}
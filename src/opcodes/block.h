@@ -0,0 +1,41 @@
+#ifndef BLOCK_H
+#define BLOCK_H
+#include "../types.h"
+#include "../cpu.h"
+#include "opcodes.h"
+
+// Number of blocks held in the cache. Must be a power of two.
+#define BLOCK_CACHE_SIZE 1024
+// Longest run of instructions decoded into a single block
+#define BLOCK_MAX_INSTRUCTIONS 24
+
+// A decoded instruction
+typedef struct {
+    instruction handler;
+    uint16 operand;
+    uint8 length;
+} BlockEntry;
+
+// A run of straight-line code starting at a given bank and address
+typedef struct {
+    uint32 key;
+    uint8 count;
+    // Loops back to its start without writing memory, so may be an idle loop polling for a change
+    bool idle;
+    BlockEntry entries[BLOCK_MAX_INSTRUCTIONS];
+} Block;
+
+struct BlockCache {
+    Block blocks[BLOCK_CACHE_SIZE];
+    // Marks the bytes of hram that have been decoded into a block
+    bool hramCode[HRAM_BOUND];
+};
+
+extern bool endsBlock(uint8 opcode);
+extern struct BlockCache *createBlockCache();
+extern void resetBlockCache(Cpu *cpu);
+extern void invalidateHramBlocks(Cpu *cpu);
+extern bool idleBlock(uint16 bank, uint16 address, Cpu *cpu);
+extern int executeBlock(Cpu *cpu);
+
+#endif /* BLOCK_H */
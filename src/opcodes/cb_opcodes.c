@@ -1,1348 +1,1861 @@
-#include "../types.h"
-#include "../memory.h"
-#include "../common.h"
-#include "../cpu.h"
-#include "opcodes.h"
-#include <stdio.h>
-
-// Rotate given register left, old bit 7 to carry bit and bit 0
-static void rlc(uint8 *reg, uint8 opcode, Cpu *cpu) {
-    //set carry flag based on bit 7
-    (*reg >> 7) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    //shift left and use carry flag/bit 7 as new bit 0
-    *reg = (*reg << 1) | readFlag(CF, cpu);
-    //zero flag
-    (*reg) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    clearFlag(HF, cpu);
-    clearFlag(NF, cpu);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Rotate left byte at memory location held in HL, old bit 7 to carry bit and bit 0
-static void rlc_m(uint8 opcode, Cpu *cpu) {
-    uint8 value = readByte(cpu->registers.HL, cpu);
-    // Set carry flag based on bit 7
-    (value >> 7) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    // Shift left and use carry flag/bit 7 as new bit 0
-    value = (value << 1) | readFlag(CF, cpu);
-    // Zero flag
-    (value) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    clearFlag(HF, cpu);
-    clearFlag(NF, cpu);
-    // Write updated value to memory address held in HL
-    writeByte(cpu->registers.HL, value, cpu);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Rotate a given register left, old bit 7 to carry bit and old carry bit to bit 0
-static void rl(uint8 *reg, uint8 opcode, Cpu *cpu) {
-    // Read carry flag state into temp variable
-    bool flagState = readFlag(CF, cpu);
-    // Update the carry flag
-    (*reg >> 7) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    // Shift right
-    *reg <<= 1;
-    // Insert previous flag state into bit 0
-    *reg |= flagState;
-    // Set or reset zero flag based on whether result is zero
-    (*reg) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    clearFlag(HF, cpu);
-    clearFlag(NF, cpu);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Rotate left a byte at address held in HL, old bit 7 to carry bit and old carry bit to bit 0
-static void rl_m(uint8 opcode, Cpu *cpu) {
-    uint8 value = readByte(cpu->registers.HL, cpu);
-    // Read carry flag state into temp variable
-    bool flagState = readFlag(CF, cpu);
-    // Update the carry flag
-    (value >> 7) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    // Shift right
-    value <<= 1;
-    // Insert previous flag state into bit 0
-    value |= flagState;
-    // Set or reset zero flag based on whether result is zero
-    (value) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    clearFlag(HF, cpu);
-    clearFlag(NF, cpu);
-    // Write updated value to memory address held in HL
-    writeByte(cpu->registers.HL, value, cpu);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Rotate a given register right, old bit 0 to carry bit and bit 7
-static void rrc(uint8* reg, uint8 opcode, Cpu *cpu) {
-    // Set carry flag based on bit 7
-    (*reg & 0b1) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    // Shift left and use carry flag/bit 7 as new bit 0
-    *reg = (*reg >> 1) | (((uint8) readFlag(CF, cpu)) << 7);
-    // Set or reset zero flag based on whether result is zero
-    (*reg) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    clearFlag(HF, cpu);
-    clearFlag(NF, cpu);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Rotate right a byte at the address held in HL , old bit 0 to carry bit and bit 7
-static void rrc_m(uint8 opcode, Cpu *cpu) {
-    uint8 value = readByte(cpu->registers.HL, cpu);
-    // Set carry flag based on bit 7
-    (value & 0b1) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    // Shift left and use carry flag/bit 7 as new bit 0
-    value = (value >> 1) | (((uint8) readFlag(CF, cpu)) << 7);
-    // Set or reset zero flag based on whether result is zero
-    (value) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    clearFlag(HF, cpu);
-    clearFlag(NF, cpu);
-    // Write updated value to memory address held in HL
-    writeByte(cpu->registers.HL, value, cpu);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Right rotate a given register. New 7th bit is set by the carry flag and the carry flag is set by old 1st bit.
-static void rr(uint8 *reg, uint8 opcode, Cpu *cpu) {
-    // Read carry flag state into temp variable
-    bool flagState = readFlag(CF, cpu);
-    // Update the carry flag
-    (*reg & 0b1) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    // Shift right
-    *reg >>= 1;
-    // Insert previous flag state into bit 7
-    *reg |= flagState << 7;
-    // Set or reset zero flag based on whether result is zero
-    (*reg) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    clearFlag(HF, cpu);
-    clearFlag(NF, cpu);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Right rotate a byte at address held in HL. New 7th bit is set by the carry flag and the carry flag is set by old 1st bit.
-static void rr_m(uint8 opcode, Cpu *cpu) {
-    uint8 value = readByte(cpu->registers.HL, cpu);
-    // Read carry flag state into temp variable
-    bool flagState = readFlag(CF, cpu);
-    // Update the carry flag
-    (value & 0b1) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    // Shift right
-    value >>= 1;
-    // Insert previous flag state into bit 7
-    value |= flagState << 7;
-    // Set or reset zero flag based on whether result is zero
-    (value) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    clearFlag(HF, cpu);
-    clearFlag(NF, cpu);
-    // Write updated value to memory address held in HL
-    writeByte(cpu->registers.HL, value, cpu);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Arithmetic left shift a given register. Set new bit 0 to 0 and put the old bit 7 into the carry flag
-static void sla(uint8 *reg, uint8 opcode, Cpu *cpu) {
-    // Set carry flag based on bit 7
-    (*reg >> 7) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    //shift left
-    *reg <<= 1;
-    // Set or reset zero flag based on whether result is zero
-    (*reg) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    clearFlag(HF, cpu);
-    clearFlag(NF, cpu);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Arithmetic left shift a byte at location held in HL. Set new bit 0 to 0 and put the old bit 7 into the carry flag
-static void sla_m(uint8 opcode, Cpu *cpu) {
-    uint8 value = readByte(cpu->registers.HL, cpu);
-    // Set carry flag based on bit 7
-    (value >> 7) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    //shift left
-    value <<= 1;
-    // Set or reset zero flag based on whether result is zero
-    (value) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    clearFlag(HF, cpu);
-    clearFlag(NF, cpu);
-    // Write updated value to memory address held in HL
-    writeByte(cpu->registers.HL, value, cpu);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Arithmetic right shift a given register. Set new bit 7 to the previus bit 7 and put the old bit 0 into the carry flag
-static void sra(uint8 *reg, uint8 opcode, Cpu *cpu) {
-    uint8 bit7 = *reg & 0x80; //0x80 = 0b10000000
-    // Set carry flag based on bit 0
-    (*reg & 0b1) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    // Shift right
-    *reg >>= 1;
-    // Set new bit seven to old bit 7
-    *reg |= bit7;
-    // Set or reset zero flag based on whether result is zero
-    (*reg) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    clearFlag(HF, cpu);
-    clearFlag(NF, cpu);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Arithmetic right shift a byte at address in HL. Set new bit 7 to the previus bit 7 and put the old bit 0 into the carry flag
-static void sra_m(uint8 opcode, Cpu *cpu) {
-    uint8 value = readByte(cpu->registers.HL, cpu);
-    uint8 bit7 = value & 0x80; //0x80 = 0b10000000
-    // Set carry flag based on bit 0
-    (value & 0b1) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    // Shift right
-    value >>= 1;
-    // Set new bit seven to old bit 7
-    value |= bit7;
-    // Set or reset zero flag based on whether result is zero
-    (value) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    clearFlag(HF, cpu);
-    clearFlag(NF, cpu);
-    // Write updated value to memory address held in HL
-    writeByte(cpu->registers.HL, value, cpu);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Logical right shift of given register. Set new bit 7 to 0 and put the old bit 0 into carry flag
-static void srl(uint8 *reg, uint8 opcode, Cpu *cpu) {
-    // Set carry bit based on bit 0
-    (*reg & 0b1) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    // Shift right
-    *reg >>= 1;
-    // Set or reset zero flag based on whether result is zero
-    (*reg) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    clearFlag(HF, cpu);
-    clearFlag(NF, cpu);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Logical right shift of given register. Set new bit 7 to 0 and put the old bit 0 into carry flag
-static void srl_m(uint8 opcode, Cpu *cpu) {
-    uint8 value = readByte(cpu->registers.HL, cpu);
-    // Set carry bit based on bit 0
-    (value & 0b1) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    // Shift right
-    value >>= 1;
-    // Set or reset zero flag based on whether result is zero
-    (value) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    clearFlag(HF, cpu);
-    clearFlag(NF, cpu);
-    // Write updated value to memory address held in HL
-    writeByte(cpu->registers.HL, value, cpu);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Swap the upper and lower nibbles of some register
-static void swap(uint8 *reg, uint8 opcode, Cpu *cpu) {
-    clearFlag(NF, cpu);
-    clearFlag(HF, cpu);
-    clearFlag(CF, cpu);
-    // Swap the upper and lower nibbles by masking and shifting
-    *reg = ((*reg & 0xF) << 4) | ((*reg & 0xF0) >> 4);
-    // Set or reset zero flag based on whether result is zero
-    (*reg) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Swap the upper and lower nibbles of some register
-static void swap_m(uint8 opcode, Cpu *cpu) {
-    uint8 value = readByte(cpu->registers.HL, cpu);
-    clearFlag(NF, cpu);
-    clearFlag(HF, cpu);
-    clearFlag(CF, cpu);
-    // Swap the upper and lower nibbles by masking and shifting
-    value = ((value & 0xF) << 4) | ((value & 0xF0) >> 4);
-    // Set or reset zero flag based on whether result is zero
-    (value) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    // Write updated value to memory address held in HL
-    writeByte(cpu->registers.HL, value, cpu);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Set flags based on the status of a bit in a register
-static void bit(uint8 bit, uint8 *reg, uint8 opcode, Cpu *cpu) {
-    //set or reset zero flag based on whether the bit is zero
-    (readBit(bit, reg)) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    clearFlag(NF, cpu);
-    setFlag(HF, cpu);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Set flags based on the status of a bit in memory
-static void bit_m(uint8 bit, uint8 opcode, Cpu *cpu) {
-    //set or reset zero flag based on whether the bit is zero
-    (readBitMem(bit, cpu)) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    clearFlag(NF, cpu);
-    setFlag(HF, cpu);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Set 1 bit
-static void set(uint8 bit, uint8 *reg, uint8 opcode, Cpu *cpu) {
-    *reg |= (0b1 << bit);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Set 1 bit in memory location stored in HL
-static void set_m(uint8 bit, uint8 opcode, Cpu *cpu) {
-    writeByte(cpu->registers.HL, readByte(cpu->registers.HL, cpu) | (0b1 << bit), cpu);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Reset 1 bit
-void res(uint8 bit, uint8 *reg, uint8 opcode, Cpu *cpu) {
-    *reg &= ~(0b1 << bit);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Reset 1 bit in memory location stored in HL
-static void res_m(uint8 bit, uint8 opcode, Cpu *cpu) {
-    writeByte(cpu->registers.HL, readByte(cpu->registers.HL, cpu) & ~(0b1 << bit), cpu);
-    cpu->wait = get_cb_opcode(opcode).cycles;
-}
-
-// Execute instruction with a 0xCB pefix
-int executeNextExtendedInstruction(Cpu *cpu) {
-    //grab instruction
-    uint8 opcode = readNextByte(cpu);
-    switch(opcode) {
-        case 0x00: //RLC B
-            rlc(&cpu->registers.B, opcode, cpu);
-            break;
-        case 0x01: //RLC C
-            rlc(&cpu->registers.C, opcode, cpu);
-            break;
-        case 0x02: //RLC D
-            rlc(&cpu->registers.D, opcode, cpu);
-            break;
-        case 0x03: //RLC E
-            rlc(&cpu->registers.E, opcode, cpu);
-            break;
-        case 0x04: //RLC H
-            rlc(&cpu->registers.H, opcode, cpu);
-            break;
-        case 0x05: //RLC L
-            rlc(&cpu->registers.L, opcode, cpu);
-            break;
-        case 0x06: //RLC (HL)
-            rlc_m(opcode, cpu);
-            break;
-        case 0x07: //RLC A
-            rlc(&cpu->registers.A, opcode, cpu);
-            break;
-        case 0x08: //RRC B
-            rrc(&cpu->registers.B, opcode, cpu);
-            break;
-        case 0x09: //RRC C
-            rrc(&cpu->registers.C, opcode, cpu);
-            break;
-        case 0x0A: //RRC D
-            rrc(&cpu->registers.D, opcode, cpu);
-            break;
-        case 0x0B: //RRC E
-            rrc(&cpu->registers.E, opcode, cpu);
-            break;
-        case 0x0C: //RRC H
-            rrc(&cpu->registers.H, opcode, cpu);
-            break;
-        case 0x0D: //RRC L
-            rrc(&cpu->registers.L, opcode, cpu);
-            break;
-        case 0x0E: //RRC (HL)
-            rrc_m(opcode, cpu);
-            break;
-        case 0x0F: //RRC A
-            rrc(&cpu->registers.A, opcode, cpu);
-            break;
-        case 0x10: //RL B
-            rl(&cpu->registers.B, opcode, cpu);
-            break;
-        case 0x11: //RL C
-            rl(&cpu->registers.C, opcode, cpu);
-            break;
-        case 0x12: //RL D
-            rl(&cpu->registers.D, opcode, cpu);
-            break;
-        case 0x13: //RL E
-            rl(&cpu->registers.E, opcode, cpu);
-            break;
-        case 0x14: //RL H
-            rl(&cpu->registers.H, opcode, cpu);
-            break;
-        case 0x15: //RL L
-            rl(&cpu->registers.L, opcode, cpu);
-            break;
-        case 0x16: //RL (HL)
-            rl_m(opcode, cpu);
-            break;
-        case 0x17: //RL A
-            rl(&cpu->registers.A, opcode, cpu);
-            break;
-        case 0x18: //RR B
-            rr(&cpu->registers.B, opcode, cpu);
-            break;
-        case 0x19: //RR C
-            rr(&cpu->registers.C, opcode, cpu);
-            break;
-        case 0x1A: //RR D
-            rr(&cpu->registers.D, opcode, cpu);
-            break;
-        case 0x1B: //RR E
-            rr(&cpu->registers.E, opcode, cpu);
-            break;
-        case 0x1C: //RR H
-            rr(&cpu->registers.H, opcode, cpu);
-            break;
-        case 0x1D: //RR L
-            rr(&cpu->registers.L, opcode, cpu);
-            break;
-        case 0x1E: //RR (HL)
-            rr_m(opcode, cpu);
-            break;
-        case 0x1F: //RR A
-            rr(&cpu->registers.A, opcode, cpu);
-            break;
-        case 0x20: //SLA B
-            sla(&cpu->registers.B, opcode, cpu);
-            break;
-        case 0x21: //SLA C
-            sla(&cpu->registers.C, opcode, cpu);
-            break;
-        case 0x22: //SLA D
-            sla(&cpu->registers.D, opcode, cpu);
-            break;
-        case 0x23: //SLA E
-            sla(&cpu->registers.E, opcode, cpu);
-            break;
-        case 0x24: //SLA H
-            sla(&cpu->registers.H, opcode, cpu);
-            break;
-        case 0x25: //SLA L
-            sla(&cpu->registers.L, opcode, cpu);
-            break;
-        case 0x26: //SLA (HL)
-            sla_m(opcode, cpu);
-            break;
-        case 0x27: //SLA A
-            sla(&cpu->registers.A, opcode, cpu);
-            break;
-        case 0x28: //SRA B
-            sra(&cpu->registers.B, opcode, cpu);
-            break;
-        case 0x29: //SRA C
-            sra(&cpu->registers.C, opcode, cpu);
-            break;
-        case 0x2A: //SRA D
-            sra(&cpu->registers.D, opcode, cpu);
-            break;
-        case 0x2B: //SRA E
-            sra(&cpu->registers.E, opcode, cpu);
-            break;
-        case 0x2C: //SRA H
-            sra(&cpu->registers.H, opcode, cpu);
-            break;
-        case 0x2D: //SRA L
-            sra(&cpu->registers.L, opcode, cpu);
-            break;
-        case 0x2E: //SRA (HL)
-            sra_m(opcode, cpu);
-            break;
-        case 0x2F: //SRA A
-            sra(&cpu->registers.A, opcode, cpu);
-            break;
-        case 0x30: //SWAP B
-            swap(&cpu->registers.B, opcode, cpu);
-            break;
-        case 0x31: //SWAP C
-            swap(&cpu->registers.C, opcode, cpu);
-            break;
-        case 0x32: //SWAP D
-            swap(&cpu->registers.D, opcode, cpu);
-            break;
-        case 0x33: //SWAP E
-            swap(&cpu->registers.E, opcode, cpu);
-            break;
-        case 0x34: //SWAP H
-            swap(&cpu->registers.H, opcode, cpu);
-            break;
-        case 0x35: //SWAP L
-            swap(&cpu->registers.L, opcode, cpu);
-            break;
-        case 0x36: //SWAP (HL)
-            swap_m(opcode, cpu);
-            break;
-        case 0x37: //SWAP A
-            swap(&cpu->registers.A, opcode, cpu);
-            break;
-        case 0x38: //SRL B
-            srl(&cpu->registers.B, opcode, cpu);
-            break;
-        case 0x39: //SRL C
-            srl(&cpu->registers.C, opcode, cpu);
-            break;
-        case 0x3A: //SRL D
-            srl(&cpu->registers.D, opcode, cpu);
-            break;
-        case 0x3B: //SRL E
-            srl(&cpu->registers.E, opcode, cpu);
-            break;
-        case 0x3C: //SRL H
-            srl(&cpu->registers.H, opcode, cpu);
-            break;
-        case 0x3D: //SRL L
-            srl(&cpu->registers.L, opcode, cpu);
-            break;
-        case 0x3E: //SRL (HL)
-            srl_m(opcode, cpu);
-            break;
-        case 0x3F: //SRL A
-            srl(&cpu->registers.A, opcode, cpu);
-            break;
-        case 0x40: //BIT 0, B
-            bit(0, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x41: //BIT 0, C
-            bit(0, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x42: //BIT 0, D
-            bit(0, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x43: //BIT 0, E
-            bit(0, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x44: //BIT 0, H
-            bit(0, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x45: //BIT 0, L
-            bit(0, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x46: //BIT 0, (HL)
-            bit_m(0, opcode, cpu);
-            break;
-        case 0x47: //BIT 0, A
-            bit(0, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x48: //BIT 1, B
-            bit(1, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x49: //BIT 1, C
-            bit(1, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x4A: //BIT 1, D
-            bit(1, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x4B: //BIT 1, E
-            bit(1, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x4C: //BIT 1, H
-            bit(1, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x4D: //BIT 1, L
-            bit(1, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x4E: //BIT 1, (HL)
-            bit_m(1, opcode, cpu);
-            break;
-        case 0x4F: //BIT 1, A
-            bit(1, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x50: //BIT 2, B
-            bit(2, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x51: //BIT 2, C
-            bit(2, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x52: //BIT 2, D
-            bit(2, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x53: //BIT 2, E
-            bit(2, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x54: //BIT 2, H
-            bit(2, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x55: //BIT 2, L
-            bit(2, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x56: //BIT 2, (HL)
-            bit_m(2, opcode, cpu);
-            break;
-        case 0x57: //BIT 2, A
-            bit(2, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x58: //BIT 3, B
-            bit(3, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x59: //BIT 3, C
-            bit(3, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x5A: //BIT 3, D
-            bit(3, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x5B: //BIT 3, E
-            bit(3, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x5C: //BIT 3, H
-            bit(3, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x5D: //BIT 3, L
-            bit(3, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x5E: //BIT 3, (HL)
-            bit_m(3, opcode, cpu);
-            break;
-        case 0x5F: //BIT 3, A
-            bit(3, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x60: //BIT 4, B
-            bit(4, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x61: //BIT 4, C
-            bit(4, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x62: //BIT 4, D
-            bit(4, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x63: //BIT 4, E
-            bit(4, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x64: //BIT 4, H
-            bit(4, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x65: //BIT 4, L
-            bit(4, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x66: //BIT 4, (HL)
-            bit_m(4, opcode, cpu);
-            break;
-        case 0x67: //BIT 4, A
-            bit(4, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x68: //BIT 5, B
-            bit(5, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x69: //BIT 5, C
-            bit(5, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x6A: //BIT 5, D
-            bit(5, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x6B: //BIT 5, E
-            bit(5, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x6C: //BIT 5, H
-            bit(5, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x6D: //BIT 5, L
-            bit(5, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x6E: //BIT 5, (HL)
-            bit_m(5, opcode, cpu);
-            break;
-        case 0x6F: //BIT 5, A
-            bit(5, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x70: //BIT 6, B
-            bit(6, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x71: //BIT 6, C
-            bit(6, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x72: //BIT 6, D
-            bit(6, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x73: //BIT 6, E
-            bit(6, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x74: //BIT 6, H
-            bit(6, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x75: //BIT 6, L
-            bit(6, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x76: //BIT 6, (HL)
-            bit_m(6, opcode, cpu);
-            break;
-        case 0x77: //BIT 6, A
-            bit(6, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x78: //BIT 7, B
-            bit(7, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x79: //BIT 7, C
-            bit(7, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x7A: //BIT 7, D
-            bit(7, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x7B: //BIT 7, E
-            bit(7, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x7C: //BIT 7, H
-            bit(7, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x7D: //BIT 7, L
-            bit(7, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x7E: //BIT 7, (HL)
-            bit_m(7, opcode, cpu);
-            break;
-        case 0x7F: //BIT 7, A
-            bit(7, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x80: //RES 0, B
-            res(0, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x81: //RES 0, C
-            res(0, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x82: //RES 0, D
-            res(0, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x83: //RES 0, E
-            res(0, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x84: //RES 0, H
-            res(0, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x85: //RES 0, L
-            res(0, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x86: //RES 0, (HL)
-            res_m(0, opcode, cpu);
-            break;
-        case 0x87: //RES 0, A
-            res(0, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x88: //RES 1, B
-            res(1, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x89: //RES 1, C
-            res(1, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x8A: //RES 1, D
-            res(1, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x8B: //RES 1, E
-            res(1, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x8C: //RES 1, H
-            res(1, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x8D: //RES 1, L
-            res(1, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x8E: //RES 1, (HL)
-            res_m(1, opcode, cpu);
-            break;
-        case 0x8F: //RES 1, A
-            res(1, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x90: //RES 2, B
-            res(2, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x91: //RES 2, C
-            res(2, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x92: //RES 2, D
-            res(2, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x93: //RES 2, E
-            res(2, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x94: //RES 2, H
-            res(2, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x95: //RES 2, L
-            res(2, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x96: //RES 2, (HL)
-            res_m(2, opcode, cpu);
-            break;
-        case 0x97: //RES 2, A
-            res(2, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x98: //RES 3, B
-            res(3, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x99: //RES 3, C
-            res(3, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x9A: //RES 3, D
-            res(3, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x9B: //RES 3, E
-            res(3, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x9C: //RES 3, H
-            res(3, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x9D: //RES 3, L
-            res(3, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x9E: //RES 3, (HL)
-            res_m(3, opcode, cpu);
-            break;
-        case 0x9F: //RES 3, A
-            res(3, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0xA0: //RES 4, B
-            res(4, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0xA1: //RES 4, C
-            res(4, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0xA2: //RES 4, D
-            res(4, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0xA3: //RES 4, E
-            res(4, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0xA4: //RES 4, H
-            res(4, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0xA5: //RES 4, L
-            res(4, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0xA6: //RES 4, (HL)
-            res_m(4, opcode, cpu);
-            break;
-        case 0xA7: //RES 4, A
-            res(4, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0xA8: //RES 5, B
-            res(5, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0xA9: //RES 5, C
-            res(5, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0xAA: //RES 5, D
-            res(5, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0xAB: //RES 5, E
-            res(5, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0xAC: //RES 5, H
-            res(5, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0xAD: //RES 5, L
-            res(5, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0xAE: //RES 5, (HL)
-            res_m(5, opcode, cpu);
-            break;
-        case 0xAF: //RES 5, A
-            res(5, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0xB0: //RES 6, B
-            res(6, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0xB1: //RES 6, C
-            res(6, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0xB2: //RES 6, D
-            res(6, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0xB3: //RES 6, E
-            res(6, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0xB4: //RES 6, H
-            res(6, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0xB5: //RES 6, L
-            res(6, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0xB6: //RES 6, (HL)
-            res_m(6, opcode, cpu);
-            break;
-        case 0xB7: //RES 6, A
-            res(6, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0xB8: //RES 7, B
-            res(7, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0xB9: //RES 7, C
-            res(7, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0xBA: //RES 7, D
-            res(7, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0xBB: //RES 7, E
-            res(7, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0xBC: //RES 7, H
-            res(7, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0xBD: //RES 7, L
-            res(7, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0xBE: //RES 7, (HL)
-            res_m(7, opcode, cpu);
-            break;
-        case 0xBF: //RES 7, A
-            res(7, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0xC0: //SET 0, B
-            set(0, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0xC1: //SET 0, C
-            set(0, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0xC2: //SET 0, D
-            set(0, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0xC3: //SET 0, E
-            set(0, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0xC4: //SET 0, H
-            set(0, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0xC5: //SET 0, L
-            set(0, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0xC6: //SET 0, (HL)
-            set_m(0, opcode, cpu);
-            break;
-        case 0xC7: //SET 0, A
-            set(0, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0xC8: //SET 1, B
-            set(1, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0xC9: //SET 1, C
-            set(1, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0xCA: //SET 1, D
-            set(1, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0xCB: //SET 1, E
-            set(1, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0xCC: //SET 1, H
-            set(1, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0xCD: //SET 1, L
-            set(1, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0xCE: //SET 1, (HL)
-            set_m(1, opcode, cpu);
-            break;
-        case 0xCF: //SET 1, A
-        	set(1, &cpu->registers.A, opcode, cpu);
-        	break;
-        case 0xD0: //SET 2, B
-            set(2, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0xD1: //SET 2, C
-            set(2, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0xD2: //SET 2, D
-            set(2, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0xD3: //SET 2, E
-            set(2, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0xD4: //SET 2, H
-            set(2, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0xD5: //SET 2, L
-            set(2, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0xD6: //SET 2, (HL)
-            set_m(2, opcode, cpu);
-            break;
-        case 0xD7: //SET 2, A
-            set(2, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0xD8: //SET 3, B
-            set(3, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0xD9: //SET 3, C
-            set(3, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0xDA: //SET 3, D
-            set(3, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0xDB: //SET 3, E
-            set(3, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0xDC: //SET 3, H
-            set(3, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0xDD: //SET 3, L
-            set(3, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0xDE: //SET 3, (HL)
-            set_m(3, opcode, cpu);
-            break;
-        case 0xDF: //SET 3, A
-        	set(3, &cpu->registers.A, opcode, cpu);
-        	break;
-        case 0xE0: //SET 4, B
-            set(4, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0xE1: //SET 4, C
-            set(4, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0xE2: //SET 4, D
-            set(4, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0xE3: //SET 4, E
-            set(4, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0xE4: //SET 4, H
-            set(4, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0xE5: //SET 4, L
-            set(4, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0xE6: //SET 4, (HL)
-            set_m(4, opcode, cpu);
-            break;
-        case 0xE7: //SET 4, A
-            set(4, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0xE8: //SET 5, B
-            set(5, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0xE9: //SET 5, C
-            set(5, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0xEA: //SET 5, D
-            set(5, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0xEB: //SET 5, E
-            set(5, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0xEC: //SET 5, H
-            set(5, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0xED: //SET 5, L
-            set(5, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0xEE: //SET 5, (HL)
-            set_m(5, opcode, cpu);
-            break;
-        case 0xEF: //SET 5, A
-        	set(5, &cpu->registers.A, opcode, cpu);
-        	break;
-        case 0xF0: //SET 6, B
-            set(6, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0xF1: //SET 6, C
-            set(6, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0xF2: //SET 6, D
-            set(6, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0xF3: //SET 6, E
-            set(6, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0xF4: //SET 6, H
-            set(6, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0xF5: //SET 6, L
-            set(6, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0xF6: //SET 6, (HL)
-            set_m(6, opcode, cpu);
-            break;
-        case 0xF7: //SET 6, A
-            set(6, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0xF8: //SET 7, B
-            set(7, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0xF9: //SET 7, C
-            set(7, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0xFA: //SET 7, D
-            set(7, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0xFB: //SET 7, E
-            set(7, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0xFC: //SET 7, H
-            set(7, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0xFD: //SET 7, L
-            set(7, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0xFE: //SET 7, (HL)
-            set_m(7, opcode, cpu);
-            break;
-        case 0xFF: //SET 7,A
-            set(7, &cpu->registers.A, opcode, cpu);
-            break;
-        default: //instruction not implemented
-            printf("Error prefix 0xCB instruction not found: ");
-            printInstruction(false, cpu->PC - 2, cpu);
-            return 1;
-    }
-    return 0;
-}
-
-const cb_opcode cb_opcodes[256];
-
-// Return information about requested opcode
-cb_opcode get_cb_opcode(uint8 value) {
-    return cb_opcodes[value];
-}
-
-// Store format to printf each instruction, its number of cycles, and how many bytes the instruction is in memory.
-const cb_opcode cb_opcodes[256] = {
-    { "0xCB00 RLC B", 8 },
-    { "0xCB01 RLC C", 8 },
-    { "0xCB02 RLC D", 8 },
-    { "0xCB03 RLC E", 8 },
-    { "0xCB04 RLC H", 8 },
-    { "0xCB05 RLC L", 8 },
-    { "0xCB06 RLC (HL)", 16 },
-    { "0xCB07 RLC A", 8 },
-    { "0xCB08 RRC B", 8 },
-    { "0xCB09 RRC C", 8 },
-    { "0xCB0A RRC D", 8 },
-    { "0xCB0B RRC E", 8 },
-    { "0xCB0C RRC H", 8 },
-    { "0xCB0D RRC L", 8 },
-    { "0xCB0E RRC (HL)", 16 },
-    { "0xCB0F RRC A", 8 },
-    { "0xCB10 RL B", 8 },
-    { "0xCB11 RL C", 8 },
-    { "0xCB12 RL D", 8 },
-    { "0xCB13 RL E", 8 },
-    { "0xCB14 RL H", 8 },
-    { "0xCB15 RL L", 8 },
-    { "0xCB16 RL (HL)", 16 },
-    { "0xCB17 RL A", 8 },
-    { "0xCB18 RR B", 8 },
-    { "0xCB19 RR C", 8 },
-    { "0xCB1A RR D", 8 },
-    { "0xCB1B RR E", 8 },
-    { "0xCB1C RR H", 8 },
-    { "0xCB1D RR L", 8 },
-    { "0xCB1E RR (HL)", 16 },
-    { "0xCB1F RR A", 8 },
-    { "0xCB20 SLA B", 8 },
-    { "0xCB21 SLA C", 8 },
-    { "0xCB22 SLA D", 8 },
-    { "0xCB23 SLA E", 8 },
-    { "0xCB24 SLA H", 8 },
-    { "0xCB25 SLA L", 8 },
-    { "0xCB26 SLA (HL)", 16 },
-    { "0xCB27 SLA A", 8 },
-    { "0xCB28 SRA B", 8 },
-    { "0xCB29 SRA C", 8 },
-    { "0xCB2A SRA D", 8 },
-    { "0xCB2B SRA E", 8 },
-    { "0xCB2C SRA H", 8 },
-    { "0xCB2D SRA L", 8 },
-    { "0xCB2E SRA (HL)", 16 },
-    { "0xCB2F SRA A", 8 },
-    { "0xCB30 SWAP B", 8 },
-    { "0xCB31 SWAP C", 8 },
-    { "0xCB32 SWAP D", 8 },
-    { "0xCB33 SWAP E", 8 },
-    { "0xCB34 SWAP H", 8 },
-    { "0xCB35 SWAP L", 8 },
-    { "0xCB36 SWAP (HL)", 16 },
-    { "0xCB37 SWAP A", 8 },
-    { "0xCB38 SRL B", 8 },
-    { "0xCB39 SRL C", 8 },
-    { "0xCB3A SRL D", 8 },
-    { "0xCB3B SRL E", 8 },
-    { "0xCB3C SRL H", 8 },
-    { "0xCB3D SRL L", 8 },
-    { "0xCB3E SRL (HL)", 16 },
-    { "0xCB3F SRL A", 8 },
-    { "0xCB40 BIT 0, B", 8 },
-    { "0xCB41 BIT 0, C", 8 },
-    { "0xCB42 BIT 0, D", 8 },
-    { "0xCB43 BIT 0, E", 8 },
-    { "0xCB44 BIT 0, H", 8 },
-    { "0xCB45 BIT 0, L", 8 },
-    { "0xCB46 BIT 0, (HL)", 12 },
-    { "0xCB47 BIT 0, A", 8 },
-    { "0xCB48 BIT 1, B", 8 },
-    { "0xCB49 BIT 1, C", 8 },
-    { "0xCB4A BIT 1, D", 8 },
-    { "0xCB4B BIT 1, E", 8 },
-    { "0xCB4C BIT 1, H", 8 },
-    { "0xCB4D BIT 1, L", 8 },
-    { "0xCB4E BIT 1, (HL)", 12 },
-    { "0xCB4F BIT 1, A", 8 },
-    { "0xCB50 BIT 2, B", 8 },
-    { "0xCB51 BIT 2, C", 8 },
-    { "0xCB52 BIT 2, D", 8 },
-    { "0xCB53 BIT 2, E", 8 },
-    { "0xCB54 BIT 2, H", 8 },
-    { "0xCB55 BIT 2, L", 8 },
-    { "0xCB56 BIT 2, (HL)", 12 },
-    { "0xCB57 BIT 2, A", 8 },
-    { "0xCB58 BIT 3, B", 8 },
-    { "0xCB59 BIT 3, C", 8 },
-    { "0xCB5A BIT 3, D", 8 },
-    { "0xCB5B BIT 3, E", 8 },
-    { "0xCB5C BIT 3, H", 8 },
-    { "0xCB5D BIT 3, L", 8 },
-    { "0xCB5E BIT 3, (HL)", 12 },
-    { "0xCB5F BIT 3, A", 8 },
-    { "0xCB60 BIT 4, B", 8 },
-    { "0xCB61 BIT 4, C", 8 },
-    { "0xCB62 BIT 4, D", 8 },
-    { "0xCB63 BIT 4, E", 8 },
-    { "0xCB64 BIT 4, H", 8 },
-    { "0xCB65 BIT 4, L", 8 },
-    { "0xCB66 BIT 4, (HL)", 12 },
-    { "0xCB67 BIT 4, A", 8 },
-    { "0xCB68 BIT 5, B", 8 },
-    { "0xCB69 BIT 5, C", 8 },
-    { "0xCB6A BIT 5, D", 8 },
-    { "0xCB6B BIT 5, E", 8 },
-    { "0xCB6C BIT 5, H", 8 },
-    { "0xCB6D BIT 5, L", 8 },
-    { "0xCB6E BIT 5, (HL)", 12 },
-    { "0xCB6F BIT 5, A", 8 },
-    { "0xCB70 BIT 6, B", 8 },
-    { "0xCB71 BIT 6, C", 8 },
-    { "0xCB72 BIT 6, D", 8 },
-    { "0xCB73 BIT 6, E", 8 },
-    { "0xCB74 BIT 6, H", 8 },
-    { "0xCB75 BIT 6, L", 8 },
-    { "0xCB76 BIT 6, (HL)", 12 },
-    { "0xCB77 BIT 6, A", 8 },
-    { "0xCB78 BIT 7, B", 8 },
-    { "0xCB79 BIT 7, C", 8 },
-    { "0xCB7A BIT 7, D", 8 },
-    { "0xCB7B BIT 7, E", 8 },
-    { "0xCB7C BIT 7, H", 8 },
-    { "0xCB7D BIT 7, L", 8 },
-    { "0xCB7E BIT 7, (HL)", 12 },
-    { "0xCB7F BIT 7, A", 8 },
-    { "0xCB80 RES 0, B", 8 },
-    { "0xCB81 RES 0, C", 8 },
-    { "0xCB82 RES 0, D", 8 },
-    { "0xCB83 RES 0, E", 8 },
-    { "0xCB84 RES 0, H", 8 },
-    { "0xCB85 RES 0, L", 8 },
-    { "0xCB86 RES 0, (HL)", 16 },
-    { "0xCB87 RES 0, A", 8 },
-    { "0xCB88 RES 1, B", 8 },
-    { "0xCB89 RES 1, C", 8 },
-    { "0xCB8A RES 1, D", 8 },
-    { "0xCB8B RES 1, E", 8 },
-    { "0xCB8C RES 1, H", 8 },
-    { "0xCB8D RES 1, L", 8 },
-    { "0xCB8E RES 1, (HL)", 16 },
-    { "0xCB8F RES 1, A", 8 },
-    { "0xCB90 RES 2, B", 8 },
-    { "0xCB91 RES 2, C", 8 },
-    { "0xCB92 RES 2, D", 8 },
-    { "0xCB93 RES 2, E", 8 },
-    { "0xCB94 RES 2, H", 8 },
-    { "0xCB95 RES 2, L", 8 },
-    { "0xCB96 RES 2, (HL)", 16 },
-    { "0xCB97 RES 2, A", 8 },
-    { "0xCB98 RES 3, B", 8 },
-    { "0xCB99 RES 3, C", 8 },
-    { "0xCB9A RES 3, D", 8 },
-    { "0xCB9B RES 3, E", 8 },
-    { "0xCB9C RES 3, H", 8 },
-    { "0xCB9D RES 3, L", 8 },
-    { "0xCB9E RES 3, (HL)", 16 },
-    { "0xCB9F RES 3, A", 8 },
-    { "0xCBA0 RES 4, B", 8 },
-    { "0xCBA1 RES 4, C", 8 },
-    { "0xCBA2 RES 4, D", 8 },
-    { "0xCBA3 RES 4, E", 8 },
-    { "0xCBA4 RES 4, H", 8 },
-    { "0xCBA5 RES 4, L", 8 },
-    { "0xCBA6 RES 4, (HL)", 16 },
-    { "0xCBA7 RES 4, A", 8 },
-    { "0xCBA8 RES 5, B", 8 },
-    { "0xCBA9 RES 5, C", 8 },
-    { "0xCBAA RES 5, D", 8 },
-    { "0xCBAB RES 5, E", 8 },
-    { "0xCBAC RES 5, H", 8 },
-    { "0xCBAD RES 5, L", 8 },
-    { "0xCBAE RES 5, (HL)", 16 },
-    { "0xCBAF RES 5, A", 8 },
-    { "0xCBB0 RES 6, B", 8 },
-    { "0xCBB1 RES 6, C", 8 },
-    { "0xCBB2 RES 6, D", 8 },
-    { "0xCBB3 RES 6, E", 8 },
-    { "0xCBB4 RES 6, H", 8 },
-    { "0xCBB5 RES 6, L", 8 },
-    { "0xCBB6 RES 6, (HL)", 16 },
-    { "0xCBB7 RES 6, A", 8 },
-    { "0xCBB8 RES 7, B", 8 },
-    { "0xCBB9 RES 7, C", 8 },
-    { "0xCBBA RES 7, D", 8 },
-    { "0xCBBB RES 7, E", 8 },
-    { "0xCBBC RES 7, H", 8 },
-    { "0xCBBD RES 7, L", 8 },
-    { "0xCBBE RES 7, (HL)", 16 },
-    { "0xCBBF RES 7, A", 8 },
-    { "0xCBC0 SET 0, B", 8 },
-    { "0xCBC1 SET 0, C", 8 },
-    { "0xCBC2 SET 0, D", 8 },
-    { "0xCBC3 SET 0, E", 8 },
-    { "0xCBC4 SET 0, H", 8 },
-    { "0xCBC5 SET 0, L", 8 },
-    { "0xCBC6 SET 0, (HL)", 16 },
-    { "0xCBC7 SET 0, A", 8 },
-    { "0xCBC8 SET 1, B", 8 },
-    { "0xCBC9 SET 1, C", 8 },
-    { "0xCBCA SET 1, D", 8 },
-    { "0xCBCB SET 1, E", 8 },
-    { "0xCBCC SET 1, H", 8 },
-    { "0xCBCD SET 1, L", 8 },
-    { "0xCBCE SET 1, (HL)", 16 },
-    { "0xCBCF SET 1, A", 8 },
-    { "0xCBD0 SET 2, B", 8 },
-    { "0xCBD1 SET 2, C", 8 },
-    { "0xCBD2 SET 2, D", 8 },
-    { "0xCBD3 SET 2, E", 8 },
-    { "0xCBD4 SET 2, H", 8 },
-    { "0xCBD5 SET 2, L", 8 },
-    { "0xCBD6 SET 2, (HL)", 16 },
-    { "0xCBD7 SET 2, A", 8 },
-    { "0xCBD8 SET 3, B", 8 },
-    { "0xCBD9 SET 3, C", 8 },
-    { "0xCBDA SET 3, D", 8 },
-    { "0xCBDB SET 3, E", 8 },
-    { "0xCBDC SET 3, H", 8 },
-    { "0xCBDD SET 3, L", 8 },
-    { "0xCBDE SET 3, (HL)", 16 },
-    { "0xCBDF SET 3, A", 8 },
-    { "0xCBE0 SET 4, B", 8 },
-    { "0xCBE1 SET 4, C", 8 },
-    { "0xCBE2 SET 4, D", 8 },
-    { "0xCBE3 SET 4, E", 8 },
-    { "0xCBE4 SET 4, H", 8 },
-    { "0xCBE5 SET 4, L", 8 },
-    { "0xCBE6 SET 4, (HL)", 16 },
-    { "0xCBE7 SET 4, A", 8 },
-    { "0xCBE8 SET 5, B", 8 },
-    { "0xCBE9 SET 5, C", 8 },
-    { "0xCBEA SET 5, D", 8 },
-    { "0xCBEB SET 5, E", 8 },
-    { "0xCBEC SET 5, H", 8 },
-    { "0xCBED SET 5, L", 8 },
-    { "0xCBEE SET 5, (HL)", 16 },
-    { "0xCBEF SET 5, A", 8 },
-    { "0xCBF0 SET 6, B", 8 },
-    { "0xCBF1 SET 6, C", 8 },
-    { "0xCBF2 SET 6, D", 8 },
-    { "0xCBF3 SET 6, E", 8 },
-    { "0xCBF4 SET 6, H", 8 },
-    { "0xCBF5 SET 6, L", 8 },
-    { "0xCBF6 SET 6, (HL)", 16 },
-    { "0xCBF7 SET 6, A", 8 },
-    { "0xCBF8 SET 7, B", 8 },
-    { "0xCBF9 SET 7, C", 8 },
-    { "0xCBFA SET 7, D", 8 },
-    { "0xCBFB SET 7, E", 8 },
-    { "0xCBFC SET 7, H", 8 },
-    { "0xCBFD SET 7, L", 8 },
-    { "0xCBFE SET 7, (HL)", 16 },
-    { "0xCBFF SET 7, A", 8 }
-};
+#include "../types.h"
+#include "../memory.h"
+#include "../common.h"
+#include "../cpu.h"
+#include "opcodes.h"
+#include <stdio.h>
+
+// Rotate given register left, old bit 7 to carry bit and bit 0
+static void rlc(uint8 *reg, uint8 opcode, Cpu *cpu) {
+    // Old bit 7 goes to the carry flag and the new bit 0
+    cpu->registers.carry = *reg << 1;
+    *reg = (*reg << 1) | (*reg >> 7);
+    // Zero flag from the result, reset half-carry and negative flags
+    cpu->registers.zero = *reg;
+    cpu->registers.half = 0;
+    cpu->registers.negative = false;
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Rotate left byte at memory location held in HL, old bit 7 to carry bit and bit 0
+static void rlc_m(uint8 opcode, Cpu *cpu) {
+    uint8 value = readByte(cpu->registers.HL, cpu);
+    // Old bit 7 goes to the carry flag and the new bit 0
+    cpu->registers.carry = value << 1;
+    value = (value << 1) | (value >> 7);
+    // Zero flag from the result, reset half-carry and negative flags
+    cpu->registers.zero = value;
+    cpu->registers.half = 0;
+    cpu->registers.negative = false;
+    // Write updated value to memory address held in HL
+    writeByte(cpu->registers.HL, value, cpu);
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Rotate a given register left, old bit 7 to carry bit and old carry bit to bit 0
+static void rl(uint8 *reg, uint8 opcode, Cpu *cpu) {
+    // Old carry flag goes to bit 0 and old bit 7 to the carry flag
+    bool flagState = readFlag(CF, cpu);
+    cpu->registers.carry = *reg << 1;
+    *reg = (*reg << 1) | flagState;
+    // Zero flag from the result, reset half-carry and negative flags
+    cpu->registers.zero = *reg;
+    cpu->registers.half = 0;
+    cpu->registers.negative = false;
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Rotate left a byte at address held in HL, old bit 7 to carry bit and old carry bit to bit 0
+static void rl_m(uint8 opcode, Cpu *cpu) {
+    uint8 value = readByte(cpu->registers.HL, cpu);
+    // Old carry flag goes to bit 0 and old bit 7 to the carry flag
+    bool flagState = readFlag(CF, cpu);
+    cpu->registers.carry = value << 1;
+    value = (value << 1) | flagState;
+    // Zero flag from the result, reset half-carry and negative flags
+    cpu->registers.zero = value;
+    cpu->registers.half = 0;
+    cpu->registers.negative = false;
+    // Write updated value to memory address held in HL
+    writeByte(cpu->registers.HL, value, cpu);
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Rotate a given register right, old bit 0 to carry bit and bit 7
+static void rrc(uint8 *reg, uint8 opcode, Cpu *cpu) {
+    // Old bit 0 goes to the carry flag and the new bit 7
+    cpu->registers.carry = (*reg & 0b1) << 8;
+    *reg = (*reg >> 1) | (*reg << 7);
+    // Zero flag from the result, reset half-carry and negative flags
+    cpu->registers.zero = *reg;
+    cpu->registers.half = 0;
+    cpu->registers.negative = false;
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Rotate right a byte at the address held in HL , old bit 0 to carry bit and bit 7
+static void rrc_m(uint8 opcode, Cpu *cpu) {
+    uint8 value = readByte(cpu->registers.HL, cpu);
+    // Old bit 0 goes to the carry flag and the new bit 7
+    cpu->registers.carry = (value & 0b1) << 8;
+    value = (value >> 1) | (value << 7);
+    // Zero flag from the result, reset half-carry and negative flags
+    cpu->registers.zero = value;
+    cpu->registers.half = 0;
+    cpu->registers.negative = false;
+    // Write updated value to memory address held in HL
+    writeByte(cpu->registers.HL, value, cpu);
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Right rotate a given register. New 7th bit is set by the carry flag and the carry flag is set by old 1st bit.
+static void rr(uint8 *reg, uint8 opcode, Cpu *cpu) {
+    // Old carry flag goes to bit 7 and old bit 0 to the carry flag
+    bool flagState = readFlag(CF, cpu);
+    cpu->registers.carry = (*reg & 0b1) << 8;
+    *reg = (*reg >> 1) | (flagState << 7);
+    // Zero flag from the result, reset half-carry and negative flags
+    cpu->registers.zero = *reg;
+    cpu->registers.half = 0;
+    cpu->registers.negative = false;
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Right rotate a byte at address held in HL. New 7th bit is set by the carry flag and the carry flag is set by old 1st bit.
+static void rr_m(uint8 opcode, Cpu *cpu) {
+    uint8 value = readByte(cpu->registers.HL, cpu);
+    // Old carry flag goes to bit 7 and old bit 0 to the carry flag
+    bool flagState = readFlag(CF, cpu);
+    cpu->registers.carry = (value & 0b1) << 8;
+    value = (value >> 1) | (flagState << 7);
+    // Zero flag from the result, reset half-carry and negative flags
+    cpu->registers.zero = value;
+    cpu->registers.half = 0;
+    cpu->registers.negative = false;
+    // Write updated value to memory address held in HL
+    writeByte(cpu->registers.HL, value, cpu);
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Arithmetic left shift a given register. Set new bit 0 to 0 and put the old bit 7 into the carry flag
+static void sla(uint8 *reg, uint8 opcode, Cpu *cpu) {
+    // Old bit 7 goes to the carry flag and the new bit 0 is 0
+    cpu->registers.carry = *reg << 1;
+    *reg = *reg << 1;
+    // Zero flag from the result, reset half-carry and negative flags
+    cpu->registers.zero = *reg;
+    cpu->registers.half = 0;
+    cpu->registers.negative = false;
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Arithmetic left shift a byte at location held in HL. Set new bit 0 to 0 and put the old bit 7 into the carry flag
+static void sla_m(uint8 opcode, Cpu *cpu) {
+    uint8 value = readByte(cpu->registers.HL, cpu);
+    // Old bit 7 goes to the carry flag and the new bit 0 is 0
+    cpu->registers.carry = value << 1;
+    value = value << 1;
+    // Zero flag from the result, reset half-carry and negative flags
+    cpu->registers.zero = value;
+    cpu->registers.half = 0;
+    cpu->registers.negative = false;
+    // Write updated value to memory address held in HL
+    writeByte(cpu->registers.HL, value, cpu);
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Arithmetic right shift a given register. Set new bit 7 to the previus bit 7 and put the old bit 0 into the carry flag
+static void sra(uint8 *reg, uint8 opcode, Cpu *cpu) {
+    // Old bit 0 goes to the carry flag and bit 7 is kept
+    cpu->registers.carry = (*reg & 0b1) << 8;
+    *reg = (*reg >> 1) | (*reg & 0x80);
+    // Zero flag from the result, reset half-carry and negative flags
+    cpu->registers.zero = *reg;
+    cpu->registers.half = 0;
+    cpu->registers.negative = false;
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Arithmetic right shift a byte at address in HL. Set new bit 7 to the previus bit 7 and put the old bit 0 into the carry flag
+static void sra_m(uint8 opcode, Cpu *cpu) {
+    uint8 value = readByte(cpu->registers.HL, cpu);
+    // Old bit 0 goes to the carry flag and bit 7 is kept
+    cpu->registers.carry = (value & 0b1) << 8;
+    value = (value >> 1) | (value & 0x80);
+    // Zero flag from the result, reset half-carry and negative flags
+    cpu->registers.zero = value;
+    cpu->registers.half = 0;
+    cpu->registers.negative = false;
+    // Write updated value to memory address held in HL
+    writeByte(cpu->registers.HL, value, cpu);
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Logical right shift of given register. Set new bit 7 to 0 and put the old bit 0 into carry flag
+static void srl(uint8 *reg, uint8 opcode, Cpu *cpu) {
+    // Old bit 0 goes to the carry flag and the new bit 7 is 0
+    cpu->registers.carry = (*reg & 0b1) << 8;
+    *reg = *reg >> 1;
+    // Zero flag from the result, reset half-carry and negative flags
+    cpu->registers.zero = *reg;
+    cpu->registers.half = 0;
+    cpu->registers.negative = false;
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Logical right shift of given register. Set new bit 7 to 0 and put the old bit 0 into carry flag
+static void srl_m(uint8 opcode, Cpu *cpu) {
+    uint8 value = readByte(cpu->registers.HL, cpu);
+    // Old bit 0 goes to the carry flag and the new bit 7 is 0
+    cpu->registers.carry = (value & 0b1) << 8;
+    value = value >> 1;
+    // Zero flag from the result, reset half-carry and negative flags
+    cpu->registers.zero = value;
+    cpu->registers.half = 0;
+    cpu->registers.negative = false;
+    // Write updated value to memory address held in HL
+    writeByte(cpu->registers.HL, value, cpu);
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Swap the upper and lower nibbles of some register
+static void swap(uint8 *reg, uint8 opcode, Cpu *cpu) {
+    // Swap the upper and lower nibbles by masking and shifting
+    *reg = ((*reg & 0xF) << 4) | ((*reg & 0xF0) >> 4);
+    // Zero flag from the result, reset the others
+    cpu->registers.zero = *reg;
+    cpu->registers.negative = false;
+    cpu->registers.half = 0;
+    cpu->registers.carry = 0;
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Swap the upper and lower nibbles of some register
+static void swap_m(uint8 opcode, Cpu *cpu) {
+    uint8 value = readByte(cpu->registers.HL, cpu);
+    // Swap the upper and lower nibbles by masking and shifting
+    value = ((value & 0xF) << 4) | ((value & 0xF0) >> 4);
+    // Zero flag from the result, reset the others
+    cpu->registers.zero = value;
+    cpu->registers.negative = false;
+    cpu->registers.half = 0;
+    cpu->registers.carry = 0;
+    // Write updated value to memory address held in HL
+    writeByte(cpu->registers.HL, value, cpu);
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Set flags based on the status of a bit in a register
+static void bit(uint8 bit, uint8 *reg, uint8 opcode, Cpu *cpu) {
+    //zero flag is set when the bit is zero
+    cpu->registers.zero = *reg & (0b1 << bit);
+    cpu->registers.negative = false;
+    cpu->registers.half = 0x10;
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Set flags based on the status of a bit in memory
+static void bit_m(uint8 bit, uint8 opcode, Cpu *cpu) {
+    //zero flag is set when the bit is zero
+    cpu->registers.zero = readByte(cpu->registers.HL, cpu) & (0b1 << bit);
+    cpu->registers.negative = false;
+    cpu->registers.half = 0x10;
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Set 1 bit
+static void set(uint8 bit, uint8 *reg, uint8 opcode, Cpu *cpu) {
+    *reg |= (0b1 << bit);
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Set 1 bit in memory location stored in HL
+static void set_m(uint8 bit, uint8 opcode, Cpu *cpu) {
+    writeByte(cpu->registers.HL, readByte(cpu->registers.HL, cpu) | (0b1 << bit), cpu);
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Reset 1 bit
+void res(uint8 bit, uint8 *reg, uint8 opcode, Cpu *cpu) {
+    *reg &= ~(0b1 << bit);
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// Reset 1 bit in memory location stored in HL
+static void res_m(uint8 bit, uint8 opcode, Cpu *cpu) {
+    writeByte(cpu->registers.HL, readByte(cpu->registers.HL, cpu) & ~(0b1 << bit), cpu);
+    cpu->wait = cb_opcode_cycles[opcode];
+}
+
+// RLC B
+static void cb_00(Cpu *cpu) {
+    rlc(&cpu->registers.B, 0x00, cpu);
+}
+
+// RLC C
+static void cb_01(Cpu *cpu) {
+    rlc(&cpu->registers.C, 0x01, cpu);
+}
+
+// RLC D
+static void cb_02(Cpu *cpu) {
+    rlc(&cpu->registers.D, 0x02, cpu);
+}
+
+// RLC E
+static void cb_03(Cpu *cpu) {
+    rlc(&cpu->registers.E, 0x03, cpu);
+}
+
+// RLC H
+static void cb_04(Cpu *cpu) {
+    rlc(&cpu->registers.H, 0x04, cpu);
+}
+
+// RLC L
+static void cb_05(Cpu *cpu) {
+    rlc(&cpu->registers.L, 0x05, cpu);
+}
+
+// RLC (HL)
+static void cb_06(Cpu *cpu) {
+    rlc_m(0x06, cpu);
+}
+
+// RLC A
+static void cb_07(Cpu *cpu) {
+    rlc(&cpu->registers.A, 0x07, cpu);
+}
+
+// RRC B
+static void cb_08(Cpu *cpu) {
+    rrc(&cpu->registers.B, 0x08, cpu);
+}
+
+// RRC C
+static void cb_09(Cpu *cpu) {
+    rrc(&cpu->registers.C, 0x09, cpu);
+}
+
+// RRC D
+static void cb_0A(Cpu *cpu) {
+    rrc(&cpu->registers.D, 0x0A, cpu);
+}
+
+// RRC E
+static void cb_0B(Cpu *cpu) {
+    rrc(&cpu->registers.E, 0x0B, cpu);
+}
+
+// RRC H
+static void cb_0C(Cpu *cpu) {
+    rrc(&cpu->registers.H, 0x0C, cpu);
+}
+
+// RRC L
+static void cb_0D(Cpu *cpu) {
+    rrc(&cpu->registers.L, 0x0D, cpu);
+}
+
+// RRC (HL)
+static void cb_0E(Cpu *cpu) {
+    rrc_m(0x0E, cpu);
+}
+
+// RRC A
+static void cb_0F(Cpu *cpu) {
+    rrc(&cpu->registers.A, 0x0F, cpu);
+}
+
+// RL B
+static void cb_10(Cpu *cpu) {
+    rl(&cpu->registers.B, 0x10, cpu);
+}
+
+// RL C
+static void cb_11(Cpu *cpu) {
+    rl(&cpu->registers.C, 0x11, cpu);
+}
+
+// RL D
+static void cb_12(Cpu *cpu) {
+    rl(&cpu->registers.D, 0x12, cpu);
+}
+
+// RL E
+static void cb_13(Cpu *cpu) {
+    rl(&cpu->registers.E, 0x13, cpu);
+}
+
+// RL H
+static void cb_14(Cpu *cpu) {
+    rl(&cpu->registers.H, 0x14, cpu);
+}
+
+// RL L
+static void cb_15(Cpu *cpu) {
+    rl(&cpu->registers.L, 0x15, cpu);
+}
+
+// RL (HL)
+static void cb_16(Cpu *cpu) {
+    rl_m(0x16, cpu);
+}
+
+// RL A
+static void cb_17(Cpu *cpu) {
+    rl(&cpu->registers.A, 0x17, cpu);
+}
+
+// RR B
+static void cb_18(Cpu *cpu) {
+    rr(&cpu->registers.B, 0x18, cpu);
+}
+
+// RR C
+static void cb_19(Cpu *cpu) {
+    rr(&cpu->registers.C, 0x19, cpu);
+}
+
+// RR D
+static void cb_1A(Cpu *cpu) {
+    rr(&cpu->registers.D, 0x1A, cpu);
+}
+
+// RR E
+static void cb_1B(Cpu *cpu) {
+    rr(&cpu->registers.E, 0x1B, cpu);
+}
+
+// RR H
+static void cb_1C(Cpu *cpu) {
+    rr(&cpu->registers.H, 0x1C, cpu);
+}
+
+// RR L
+static void cb_1D(Cpu *cpu) {
+    rr(&cpu->registers.L, 0x1D, cpu);
+}
+
+// RR (HL)
+static void cb_1E(Cpu *cpu) {
+    rr_m(0x1E, cpu);
+}
+
+// RR A
+static void cb_1F(Cpu *cpu) {
+    rr(&cpu->registers.A, 0x1F, cpu);
+}
+
+// SLA B
+static void cb_20(Cpu *cpu) {
+    sla(&cpu->registers.B, 0x20, cpu);
+}
+
+// SLA C
+static void cb_21(Cpu *cpu) {
+    sla(&cpu->registers.C, 0x21, cpu);
+}
+
+// SLA D
+static void cb_22(Cpu *cpu) {
+    sla(&cpu->registers.D, 0x22, cpu);
+}
+
+// SLA E
+static void cb_23(Cpu *cpu) {
+    sla(&cpu->registers.E, 0x23, cpu);
+}
+
+// SLA H
+static void cb_24(Cpu *cpu) {
+    sla(&cpu->registers.H, 0x24, cpu);
+}
+
+// SLA L
+static void cb_25(Cpu *cpu) {
+    sla(&cpu->registers.L, 0x25, cpu);
+}
+
+// SLA (HL)
+static void cb_26(Cpu *cpu) {
+    sla_m(0x26, cpu);
+}
+
+// SLA A
+static void cb_27(Cpu *cpu) {
+    sla(&cpu->registers.A, 0x27, cpu);
+}
+
+// SRA B
+static void cb_28(Cpu *cpu) {
+    sra(&cpu->registers.B, 0x28, cpu);
+}
+
+// SRA C
+static void cb_29(Cpu *cpu) {
+    sra(&cpu->registers.C, 0x29, cpu);
+}
+
+// SRA D
+static void cb_2A(Cpu *cpu) {
+    sra(&cpu->registers.D, 0x2A, cpu);
+}
+
+// SRA E
+static void cb_2B(Cpu *cpu) {
+    sra(&cpu->registers.E, 0x2B, cpu);
+}
+
+// SRA H
+static void cb_2C(Cpu *cpu) {
+    sra(&cpu->registers.H, 0x2C, cpu);
+}
+
+// SRA L
+static void cb_2D(Cpu *cpu) {
+    sra(&cpu->registers.L, 0x2D, cpu);
+}
+
+// SRA (HL)
+static void cb_2E(Cpu *cpu) {
+    sra_m(0x2E, cpu);
+}
+
+// SRA A
+static void cb_2F(Cpu *cpu) {
+    sra(&cpu->registers.A, 0x2F, cpu);
+}
+
+// SWAP B
+static void cb_30(Cpu *cpu) {
+    swap(&cpu->registers.B, 0x30, cpu);
+}
+
+// SWAP C
+static void cb_31(Cpu *cpu) {
+    swap(&cpu->registers.C, 0x31, cpu);
+}
+
+// SWAP D
+static void cb_32(Cpu *cpu) {
+    swap(&cpu->registers.D, 0x32, cpu);
+}
+
+// SWAP E
+static void cb_33(Cpu *cpu) {
+    swap(&cpu->registers.E, 0x33, cpu);
+}
+
+// SWAP H
+static void cb_34(Cpu *cpu) {
+    swap(&cpu->registers.H, 0x34, cpu);
+}
+
+// SWAP L
+static void cb_35(Cpu *cpu) {
+    swap(&cpu->registers.L, 0x35, cpu);
+}
+
+// SWAP (HL)
+static void cb_36(Cpu *cpu) {
+    swap_m(0x36, cpu);
+}
+
+// SWAP A
+static void cb_37(Cpu *cpu) {
+    swap(&cpu->registers.A, 0x37, cpu);
+}
+
+// SRL B
+static void cb_38(Cpu *cpu) {
+    srl(&cpu->registers.B, 0x38, cpu);
+}
+
+// SRL C
+static void cb_39(Cpu *cpu) {
+    srl(&cpu->registers.C, 0x39, cpu);
+}
+
+// SRL D
+static void cb_3A(Cpu *cpu) {
+    srl(&cpu->registers.D, 0x3A, cpu);
+}
+
+// SRL E
+static void cb_3B(Cpu *cpu) {
+    srl(&cpu->registers.E, 0x3B, cpu);
+}
+
+// SRL H
+static void cb_3C(Cpu *cpu) {
+    srl(&cpu->registers.H, 0x3C, cpu);
+}
+
+// SRL L
+static void cb_3D(Cpu *cpu) {
+    srl(&cpu->registers.L, 0x3D, cpu);
+}
+
+// SRL (HL)
+static void cb_3E(Cpu *cpu) {
+    srl_m(0x3E, cpu);
+}
+
+// SRL A
+static void cb_3F(Cpu *cpu) {
+    srl(&cpu->registers.A, 0x3F, cpu);
+}
+
+// BIT 0, B
+static void cb_40(Cpu *cpu) {
+    bit(0, &cpu->registers.B, 0x40, cpu);
+}
+
+// BIT 0, C
+static void cb_41(Cpu *cpu) {
+    bit(0, &cpu->registers.C, 0x41, cpu);
+}
+
+// BIT 0, D
+static void cb_42(Cpu *cpu) {
+    bit(0, &cpu->registers.D, 0x42, cpu);
+}
+
+// BIT 0, E
+static void cb_43(Cpu *cpu) {
+    bit(0, &cpu->registers.E, 0x43, cpu);
+}
+
+// BIT 0, H
+static void cb_44(Cpu *cpu) {
+    bit(0, &cpu->registers.H, 0x44, cpu);
+}
+
+// BIT 0, L
+static void cb_45(Cpu *cpu) {
+    bit(0, &cpu->registers.L, 0x45, cpu);
+}
+
+// BIT 0, (HL)
+static void cb_46(Cpu *cpu) {
+    bit_m(0, 0x46, cpu);
+}
+
+// BIT 0, A
+static void cb_47(Cpu *cpu) {
+    bit(0, &cpu->registers.A, 0x47, cpu);
+}
+
+// BIT 1, B
+static void cb_48(Cpu *cpu) {
+    bit(1, &cpu->registers.B, 0x48, cpu);
+}
+
+// BIT 1, C
+static void cb_49(Cpu *cpu) {
+    bit(1, &cpu->registers.C, 0x49, cpu);
+}
+
+// BIT 1, D
+static void cb_4A(Cpu *cpu) {
+    bit(1, &cpu->registers.D, 0x4A, cpu);
+}
+
+// BIT 1, E
+static void cb_4B(Cpu *cpu) {
+    bit(1, &cpu->registers.E, 0x4B, cpu);
+}
+
+// BIT 1, H
+static void cb_4C(Cpu *cpu) {
+    bit(1, &cpu->registers.H, 0x4C, cpu);
+}
+
+// BIT 1, L
+static void cb_4D(Cpu *cpu) {
+    bit(1, &cpu->registers.L, 0x4D, cpu);
+}
+
+// BIT 1, (HL)
+static void cb_4E(Cpu *cpu) {
+    bit_m(1, 0x4E, cpu);
+}
+
+// BIT 1, A
+static void cb_4F(Cpu *cpu) {
+    bit(1, &cpu->registers.A, 0x4F, cpu);
+}
+
+// BIT 2, B
+static void cb_50(Cpu *cpu) {
+    bit(2, &cpu->registers.B, 0x50, cpu);
+}
+
+// BIT 2, C
+static void cb_51(Cpu *cpu) {
+    bit(2, &cpu->registers.C, 0x51, cpu);
+}
+
+// BIT 2, D
+static void cb_52(Cpu *cpu) {
+    bit(2, &cpu->registers.D, 0x52, cpu);
+}
+
+// BIT 2, E
+static void cb_53(Cpu *cpu) {
+    bit(2, &cpu->registers.E, 0x53, cpu);
+}
+
+// BIT 2, H
+static void cb_54(Cpu *cpu) {
+    bit(2, &cpu->registers.H, 0x54, cpu);
+}
+
+// BIT 2, L
+static void cb_55(Cpu *cpu) {
+    bit(2, &cpu->registers.L, 0x55, cpu);
+}
+
+// BIT 2, (HL)
+static void cb_56(Cpu *cpu) {
+    bit_m(2, 0x56, cpu);
+}
+
+// BIT 2, A
+static void cb_57(Cpu *cpu) {
+    bit(2, &cpu->registers.A, 0x57, cpu);
+}
+
+// BIT 3, B
+static void cb_58(Cpu *cpu) {
+    bit(3, &cpu->registers.B, 0x58, cpu);
+}
+
+// BIT 3, C
+static void cb_59(Cpu *cpu) {
+    bit(3, &cpu->registers.C, 0x59, cpu);
+}
+
+// BIT 3, D
+static void cb_5A(Cpu *cpu) {
+    bit(3, &cpu->registers.D, 0x5A, cpu);
+}
+
+// BIT 3, E
+static void cb_5B(Cpu *cpu) {
+    bit(3, &cpu->registers.E, 0x5B, cpu);
+}
+
+// BIT 3, H
+static void cb_5C(Cpu *cpu) {
+    bit(3, &cpu->registers.H, 0x5C, cpu);
+}
+
+// BIT 3, L
+static void cb_5D(Cpu *cpu) {
+    bit(3, &cpu->registers.L, 0x5D, cpu);
+}
+
+// BIT 3, (HL)
+static void cb_5E(Cpu *cpu) {
+    bit_m(3, 0x5E, cpu);
+}
+
+// BIT 3, A
+static void cb_5F(Cpu *cpu) {
+    bit(3, &cpu->registers.A, 0x5F, cpu);
+}
+
+// BIT 4, B
+static void cb_60(Cpu *cpu) {
+    bit(4, &cpu->registers.B, 0x60, cpu);
+}
+
+// BIT 4, C
+static void cb_61(Cpu *cpu) {
+    bit(4, &cpu->registers.C, 0x61, cpu);
+}
+
+// BIT 4, D
+static void cb_62(Cpu *cpu) {
+    bit(4, &cpu->registers.D, 0x62, cpu);
+}
+
+// BIT 4, E
+static void cb_63(Cpu *cpu) {
+    bit(4, &cpu->registers.E, 0x63, cpu);
+}
+
+// BIT 4, H
+static void cb_64(Cpu *cpu) {
+    bit(4, &cpu->registers.H, 0x64, cpu);
+}
+
+// BIT 4, L
+static void cb_65(Cpu *cpu) {
+    bit(4, &cpu->registers.L, 0x65, cpu);
+}
+
+// BIT 4, (HL)
+static void cb_66(Cpu *cpu) {
+    bit_m(4, 0x66, cpu);
+}
+
+// BIT 4, A
+static void cb_67(Cpu *cpu) {
+    bit(4, &cpu->registers.A, 0x67, cpu);
+}
+
+// BIT 5, B
+static void cb_68(Cpu *cpu) {
+    bit(5, &cpu->registers.B, 0x68, cpu);
+}
+
+// BIT 5, C
+static void cb_69(Cpu *cpu) {
+    bit(5, &cpu->registers.C, 0x69, cpu);
+}
+
+// BIT 5, D
+static void cb_6A(Cpu *cpu) {
+    bit(5, &cpu->registers.D, 0x6A, cpu);
+}
+
+// BIT 5, E
+static void cb_6B(Cpu *cpu) {
+    bit(5, &cpu->registers.E, 0x6B, cpu);
+}
+
+// BIT 5, H
+static void cb_6C(Cpu *cpu) {
+    bit(5, &cpu->registers.H, 0x6C, cpu);
+}
+
+// BIT 5, L
+static void cb_6D(Cpu *cpu) {
+    bit(5, &cpu->registers.L, 0x6D, cpu);
+}
+
+// BIT 5, (HL)
+static void cb_6E(Cpu *cpu) {
+    bit_m(5, 0x6E, cpu);
+}
+
+// BIT 5, A
+static void cb_6F(Cpu *cpu) {
+    bit(5, &cpu->registers.A, 0x6F, cpu);
+}
+
+// BIT 6, B
+static void cb_70(Cpu *cpu) {
+    bit(6, &cpu->registers.B, 0x70, cpu);
+}
+
+// BIT 6, C
+static void cb_71(Cpu *cpu) {
+    bit(6, &cpu->registers.C, 0x71, cpu);
+}
+
+// BIT 6, D
+static void cb_72(Cpu *cpu) {
+    bit(6, &cpu->registers.D, 0x72, cpu);
+}
+
+// BIT 6, E
+static void cb_73(Cpu *cpu) {
+    bit(6, &cpu->registers.E, 0x73, cpu);
+}
+
+// BIT 6, H
+static void cb_74(Cpu *cpu) {
+    bit(6, &cpu->registers.H, 0x74, cpu);
+}
+
+// BIT 6, L
+static void cb_75(Cpu *cpu) {
+    bit(6, &cpu->registers.L, 0x75, cpu);
+}
+
+// BIT 6, (HL)
+static void cb_76(Cpu *cpu) {
+    bit_m(6, 0x76, cpu);
+}
+
+// BIT 6, A
+static void cb_77(Cpu *cpu) {
+    bit(6, &cpu->registers.A, 0x77, cpu);
+}
+
+// BIT 7, B
+static void cb_78(Cpu *cpu) {
+    bit(7, &cpu->registers.B, 0x78, cpu);
+}
+
+// BIT 7, C
+static void cb_79(Cpu *cpu) {
+    bit(7, &cpu->registers.C, 0x79, cpu);
+}
+
+// BIT 7, D
+static void cb_7A(Cpu *cpu) {
+    bit(7, &cpu->registers.D, 0x7A, cpu);
+}
+
+// BIT 7, E
+static void cb_7B(Cpu *cpu) {
+    bit(7, &cpu->registers.E, 0x7B, cpu);
+}
+
+// BIT 7, H
+static void cb_7C(Cpu *cpu) {
+    bit(7, &cpu->registers.H, 0x7C, cpu);
+}
+
+// BIT 7, L
+static void cb_7D(Cpu *cpu) {
+    bit(7, &cpu->registers.L, 0x7D, cpu);
+}
+
+// BIT 7, (HL)
+static void cb_7E(Cpu *cpu) {
+    bit_m(7, 0x7E, cpu);
+}
+
+// BIT 7, A
+static void cb_7F(Cpu *cpu) {
+    bit(7, &cpu->registers.A, 0x7F, cpu);
+}
+
+// RES 0, B
+static void cb_80(Cpu *cpu) {
+    res(0, &cpu->registers.B, 0x80, cpu);
+}
+
+// RES 0, C
+static void cb_81(Cpu *cpu) {
+    res(0, &cpu->registers.C, 0x81, cpu);
+}
+
+// RES 0, D
+static void cb_82(Cpu *cpu) {
+    res(0, &cpu->registers.D, 0x82, cpu);
+}
+
+// RES 0, E
+static void cb_83(Cpu *cpu) {
+    res(0, &cpu->registers.E, 0x83, cpu);
+}
+
+// RES 0, H
+static void cb_84(Cpu *cpu) {
+    res(0, &cpu->registers.H, 0x84, cpu);
+}
+
+// RES 0, L
+static void cb_85(Cpu *cpu) {
+    res(0, &cpu->registers.L, 0x85, cpu);
+}
+
+// RES 0, (HL)
+static void cb_86(Cpu *cpu) {
+    res_m(0, 0x86, cpu);
+}
+
+// RES 0, A
+static void cb_87(Cpu *cpu) {
+    res(0, &cpu->registers.A, 0x87, cpu);
+}
+
+// RES 1, B
+static void cb_88(Cpu *cpu) {
+    res(1, &cpu->registers.B, 0x88, cpu);
+}
+
+// RES 1, C
+static void cb_89(Cpu *cpu) {
+    res(1, &cpu->registers.C, 0x89, cpu);
+}
+
+// RES 1, D
+static void cb_8A(Cpu *cpu) {
+    res(1, &cpu->registers.D, 0x8A, cpu);
+}
+
+// RES 1, E
+static void cb_8B(Cpu *cpu) {
+    res(1, &cpu->registers.E, 0x8B, cpu);
+}
+
+// RES 1, H
+static void cb_8C(Cpu *cpu) {
+    res(1, &cpu->registers.H, 0x8C, cpu);
+}
+
+// RES 1, L
+static void cb_8D(Cpu *cpu) {
+    res(1, &cpu->registers.L, 0x8D, cpu);
+}
+
+// RES 1, (HL)
+static void cb_8E(Cpu *cpu) {
+    res_m(1, 0x8E, cpu);
+}
+
+// RES 1, A
+static void cb_8F(Cpu *cpu) {
+    res(1, &cpu->registers.A, 0x8F, cpu);
+}
+
+// RES 2, B
+static void cb_90(Cpu *cpu) {
+    res(2, &cpu->registers.B, 0x90, cpu);
+}
+
+// RES 2, C
+static void cb_91(Cpu *cpu) {
+    res(2, &cpu->registers.C, 0x91, cpu);
+}
+
+// RES 2, D
+static void cb_92(Cpu *cpu) {
+    res(2, &cpu->registers.D, 0x92, cpu);
+}
+
+// RES 2, E
+static void cb_93(Cpu *cpu) {
+    res(2, &cpu->registers.E, 0x93, cpu);
+}
+
+// RES 2, H
+static void cb_94(Cpu *cpu) {
+    res(2, &cpu->registers.H, 0x94, cpu);
+}
+
+// RES 2, L
+static void cb_95(Cpu *cpu) {
+    res(2, &cpu->registers.L, 0x95, cpu);
+}
+
+// RES 2, (HL)
+static void cb_96(Cpu *cpu) {
+    res_m(2, 0x96, cpu);
+}
+
+// RES 2, A
+static void cb_97(Cpu *cpu) {
+    res(2, &cpu->registers.A, 0x97, cpu);
+}
+
+// RES 3, B
+static void cb_98(Cpu *cpu) {
+    res(3, &cpu->registers.B, 0x98, cpu);
+}
+
+// RES 3, C
+static void cb_99(Cpu *cpu) {
+    res(3, &cpu->registers.C, 0x99, cpu);
+}
+
+// RES 3, D
+static void cb_9A(Cpu *cpu) {
+    res(3, &cpu->registers.D, 0x9A, cpu);
+}
+
+// RES 3, E
+static void cb_9B(Cpu *cpu) {
+    res(3, &cpu->registers.E, 0x9B, cpu);
+}
+
+// RES 3, H
+static void cb_9C(Cpu *cpu) {
+    res(3, &cpu->registers.H, 0x9C, cpu);
+}
+
+// RES 3, L
+static void cb_9D(Cpu *cpu) {
+    res(3, &cpu->registers.L, 0x9D, cpu);
+}
+
+// RES 3, (HL)
+static void cb_9E(Cpu *cpu) {
+    res_m(3, 0x9E, cpu);
+}
+
+// RES 3, A
+static void cb_9F(Cpu *cpu) {
+    res(3, &cpu->registers.A, 0x9F, cpu);
+}
+
+// RES 4, B
+static void cb_A0(Cpu *cpu) {
+    res(4, &cpu->registers.B, 0xA0, cpu);
+}
+
+// RES 4, C
+static void cb_A1(Cpu *cpu) {
+    res(4, &cpu->registers.C, 0xA1, cpu);
+}
+
+// RES 4, D
+static void cb_A2(Cpu *cpu) {
+    res(4, &cpu->registers.D, 0xA2, cpu);
+}
+
+// RES 4, E
+static void cb_A3(Cpu *cpu) {
+    res(4, &cpu->registers.E, 0xA3, cpu);
+}
+
+// RES 4, H
+static void cb_A4(Cpu *cpu) {
+    res(4, &cpu->registers.H, 0xA4, cpu);
+}
+
+// RES 4, L
+static void cb_A5(Cpu *cpu) {
+    res(4, &cpu->registers.L, 0xA5, cpu);
+}
+
+// RES 4, (HL)
+static void cb_A6(Cpu *cpu) {
+    res_m(4, 0xA6, cpu);
+}
+
+// RES 4, A
+static void cb_A7(Cpu *cpu) {
+    res(4, &cpu->registers.A, 0xA7, cpu);
+}
+
+// RES 5, B
+static void cb_A8(Cpu *cpu) {
+    res(5, &cpu->registers.B, 0xA8, cpu);
+}
+
+// RES 5, C
+static void cb_A9(Cpu *cpu) {
+    res(5, &cpu->registers.C, 0xA9, cpu);
+}
+
+// RES 5, D
+static void cb_AA(Cpu *cpu) {
+    res(5, &cpu->registers.D, 0xAA, cpu);
+}
+
+// RES 5, E
+static void cb_AB(Cpu *cpu) {
+    res(5, &cpu->registers.E, 0xAB, cpu);
+}
+
+// RES 5, H
+static void cb_AC(Cpu *cpu) {
+    res(5, &cpu->registers.H, 0xAC, cpu);
+}
+
+// RES 5, L
+static void cb_AD(Cpu *cpu) {
+    res(5, &cpu->registers.L, 0xAD, cpu);
+}
+
+// RES 5, (HL)
+static void cb_AE(Cpu *cpu) {
+    res_m(5, 0xAE, cpu);
+}
+
+// RES 5, A
+static void cb_AF(Cpu *cpu) {
+    res(5, &cpu->registers.A, 0xAF, cpu);
+}
+
+// RES 6, B
+static void cb_B0(Cpu *cpu) {
+    res(6, &cpu->registers.B, 0xB0, cpu);
+}
+
+// RES 6, C
+static void cb_B1(Cpu *cpu) {
+    res(6, &cpu->registers.C, 0xB1, cpu);
+}
+
+// RES 6, D
+static void cb_B2(Cpu *cpu) {
+    res(6, &cpu->registers.D, 0xB2, cpu);
+}
+
+// RES 6, E
+static void cb_B3(Cpu *cpu) {
+    res(6, &cpu->registers.E, 0xB3, cpu);
+}
+
+// RES 6, H
+static void cb_B4(Cpu *cpu) {
+    res(6, &cpu->registers.H, 0xB4, cpu);
+}
+
+// RES 6, L
+static void cb_B5(Cpu *cpu) {
+    res(6, &cpu->registers.L, 0xB5, cpu);
+}
+
+// RES 6, (HL)
+static void cb_B6(Cpu *cpu) {
+    res_m(6, 0xB6, cpu);
+}
+
+// RES 6, A
+static void cb_B7(Cpu *cpu) {
+    res(6, &cpu->registers.A, 0xB7, cpu);
+}
+
+// RES 7, B
+static void cb_B8(Cpu *cpu) {
+    res(7, &cpu->registers.B, 0xB8, cpu);
+}
+
+// RES 7, C
+static void cb_B9(Cpu *cpu) {
+    res(7, &cpu->registers.C, 0xB9, cpu);
+}
+
+// RES 7, D
+static void cb_BA(Cpu *cpu) {
+    res(7, &cpu->registers.D, 0xBA, cpu);
+}
+
+// RES 7, E
+static void cb_BB(Cpu *cpu) {
+    res(7, &cpu->registers.E, 0xBB, cpu);
+}
+
+// RES 7, H
+static void cb_BC(Cpu *cpu) {
+    res(7, &cpu->registers.H, 0xBC, cpu);
+}
+
+// RES 7, L
+static void cb_BD(Cpu *cpu) {
+    res(7, &cpu->registers.L, 0xBD, cpu);
+}
+
+// RES 7, (HL)
+static void cb_BE(Cpu *cpu) {
+    res_m(7, 0xBE, cpu);
+}
+
+// RES 7, A
+static void cb_BF(Cpu *cpu) {
+    res(7, &cpu->registers.A, 0xBF, cpu);
+}
+
+// SET 0, B
+static void cb_C0(Cpu *cpu) {
+    set(0, &cpu->registers.B, 0xC0, cpu);
+}
+
+// SET 0, C
+static void cb_C1(Cpu *cpu) {
+    set(0, &cpu->registers.C, 0xC1, cpu);
+}
+
+// SET 0, D
+static void cb_C2(Cpu *cpu) {
+    set(0, &cpu->registers.D, 0xC2, cpu);
+}
+
+// SET 0, E
+static void cb_C3(Cpu *cpu) {
+    set(0, &cpu->registers.E, 0xC3, cpu);
+}
+
+// SET 0, H
+static void cb_C4(Cpu *cpu) {
+    set(0, &cpu->registers.H, 0xC4, cpu);
+}
+
+// SET 0, L
+static void cb_C5(Cpu *cpu) {
+    set(0, &cpu->registers.L, 0xC5, cpu);
+}
+
+// SET 0, (HL)
+static void cb_C6(Cpu *cpu) {
+    set_m(0, 0xC6, cpu);
+}
+
+// SET 0, A
+static void cb_C7(Cpu *cpu) {
+    set(0, &cpu->registers.A, 0xC7, cpu);
+}
+
+// SET 1, B
+static void cb_C8(Cpu *cpu) {
+    set(1, &cpu->registers.B, 0xC8, cpu);
+}
+
+// SET 1, C
+static void cb_C9(Cpu *cpu) {
+    set(1, &cpu->registers.C, 0xC9, cpu);
+}
+
+// SET 1, D
+static void cb_CA(Cpu *cpu) {
+    set(1, &cpu->registers.D, 0xCA, cpu);
+}
+
+// SET 1, E
+static void cb_CB(Cpu *cpu) {
+    set(1, &cpu->registers.E, 0xCB, cpu);
+}
+
+// SET 1, H
+static void cb_CC(Cpu *cpu) {
+    set(1, &cpu->registers.H, 0xCC, cpu);
+}
+
+// SET 1, L
+static void cb_CD(Cpu *cpu) {
+    set(1, &cpu->registers.L, 0xCD, cpu);
+}
+
+// SET 1, (HL)
+static void cb_CE(Cpu *cpu) {
+    set_m(1, 0xCE, cpu);
+}
+
+// SET 1, A
+static void cb_CF(Cpu *cpu) {
+    set(1, &cpu->registers.A, 0xCF, cpu);
+}
+
+// SET 2, B
+static void cb_D0(Cpu *cpu) {
+    set(2, &cpu->registers.B, 0xD0, cpu);
+}
+
+// SET 2, C
+static void cb_D1(Cpu *cpu) {
+    set(2, &cpu->registers.C, 0xD1, cpu);
+}
+
+// SET 2, D
+static void cb_D2(Cpu *cpu) {
+    set(2, &cpu->registers.D, 0xD2, cpu);
+}
+
+// SET 2, E
+static void cb_D3(Cpu *cpu) {
+    set(2, &cpu->registers.E, 0xD3, cpu);
+}
+
+// SET 2, H
+static void cb_D4(Cpu *cpu) {
+    set(2, &cpu->registers.H, 0xD4, cpu);
+}
+
+// SET 2, L
+static void cb_D5(Cpu *cpu) {
+    set(2, &cpu->registers.L, 0xD5, cpu);
+}
+
+// SET 2, (HL)
+static void cb_D6(Cpu *cpu) {
+    set_m(2, 0xD6, cpu);
+}
+
+// SET 2, A
+static void cb_D7(Cpu *cpu) {
+    set(2, &cpu->registers.A, 0xD7, cpu);
+}
+
+// SET 3, B
+static void cb_D8(Cpu *cpu) {
+    set(3, &cpu->registers.B, 0xD8, cpu);
+}
+
+// SET 3, C
+static void cb_D9(Cpu *cpu) {
+    set(3, &cpu->registers.C, 0xD9, cpu);
+}
+
+// SET 3, D
+static void cb_DA(Cpu *cpu) {
+    set(3, &cpu->registers.D, 0xDA, cpu);
+}
+
+// SET 3, E
+static void cb_DB(Cpu *cpu) {
+    set(3, &cpu->registers.E, 0xDB, cpu);
+}
+
+// SET 3, H
+static void cb_DC(Cpu *cpu) {
+    set(3, &cpu->registers.H, 0xDC, cpu);
+}
+
+// SET 3, L
+static void cb_DD(Cpu *cpu) {
+    set(3, &cpu->registers.L, 0xDD, cpu);
+}
+
+// SET 3, (HL)
+static void cb_DE(Cpu *cpu) {
+    set_m(3, 0xDE, cpu);
+}
+
+// SET 3, A
+static void cb_DF(Cpu *cpu) {
+    set(3, &cpu->registers.A, 0xDF, cpu);
+}
+
+// SET 4, B
+static void cb_E0(Cpu *cpu) {
+    set(4, &cpu->registers.B, 0xE0, cpu);
+}
+
+// SET 4, C
+static void cb_E1(Cpu *cpu) {
+    set(4, &cpu->registers.C, 0xE1, cpu);
+}
+
+// SET 4, D
+static void cb_E2(Cpu *cpu) {
+    set(4, &cpu->registers.D, 0xE2, cpu);
+}
+
+// SET 4, E
+static void cb_E3(Cpu *cpu) {
+    set(4, &cpu->registers.E, 0xE3, cpu);
+}
+
+// SET 4, H
+static void cb_E4(Cpu *cpu) {
+    set(4, &cpu->registers.H, 0xE4, cpu);
+}
+
+// SET 4, L
+static void cb_E5(Cpu *cpu) {
+    set(4, &cpu->registers.L, 0xE5, cpu);
+}
+
+// SET 4, (HL)
+static void cb_E6(Cpu *cpu) {
+    set_m(4, 0xE6, cpu);
+}
+
+// SET 4, A
+static void cb_E7(Cpu *cpu) {
+    set(4, &cpu->registers.A, 0xE7, cpu);
+}
+
+// SET 5, B
+static void cb_E8(Cpu *cpu) {
+    set(5, &cpu->registers.B, 0xE8, cpu);
+}
+
+// SET 5, C
+static void cb_E9(Cpu *cpu) {
+    set(5, &cpu->registers.C, 0xE9, cpu);
+}
+
+// SET 5, D
+static void cb_EA(Cpu *cpu) {
+    set(5, &cpu->registers.D, 0xEA, cpu);
+}
+
+// SET 5, E
+static void cb_EB(Cpu *cpu) {
+    set(5, &cpu->registers.E, 0xEB, cpu);
+}
+
+// SET 5, H
+static void cb_EC(Cpu *cpu) {
+    set(5, &cpu->registers.H, 0xEC, cpu);
+}
+
+// SET 5, L
+static void cb_ED(Cpu *cpu) {
+    set(5, &cpu->registers.L, 0xED, cpu);
+}
+
+// SET 5, (HL)
+static void cb_EE(Cpu *cpu) {
+    set_m(5, 0xEE, cpu);
+}
+
+// SET 5, A
+static void cb_EF(Cpu *cpu) {
+    set(5, &cpu->registers.A, 0xEF, cpu);
+}
+
+// SET 6, B
+static void cb_F0(Cpu *cpu) {
+    set(6, &cpu->registers.B, 0xF0, cpu);
+}
+
+// SET 6, C
+static void cb_F1(Cpu *cpu) {
+    set(6, &cpu->registers.C, 0xF1, cpu);
+}
+
+// SET 6, D
+static void cb_F2(Cpu *cpu) {
+    set(6, &cpu->registers.D, 0xF2, cpu);
+}
+
+// SET 6, E
+static void cb_F3(Cpu *cpu) {
+    set(6, &cpu->registers.E, 0xF3, cpu);
+}
+
+// SET 6, H
+static void cb_F4(Cpu *cpu) {
+    set(6, &cpu->registers.H, 0xF4, cpu);
+}
+
+// SET 6, L
+static void cb_F5(Cpu *cpu) {
+    set(6, &cpu->registers.L, 0xF5, cpu);
+}
+
+// SET 6, (HL)
+static void cb_F6(Cpu *cpu) {
+    set_m(6, 0xF6, cpu);
+}
+
+// SET 6, A
+static void cb_F7(Cpu *cpu) {
+    set(6, &cpu->registers.A, 0xF7, cpu);
+}
+
+// SET 7, B
+static void cb_F8(Cpu *cpu) {
+    set(7, &cpu->registers.B, 0xF8, cpu);
+}
+
+// SET 7, C
+static void cb_F9(Cpu *cpu) {
+    set(7, &cpu->registers.C, 0xF9, cpu);
+}
+
+// SET 7, D
+static void cb_FA(Cpu *cpu) {
+    set(7, &cpu->registers.D, 0xFA, cpu);
+}
+
+// SET 7, E
+static void cb_FB(Cpu *cpu) {
+    set(7, &cpu->registers.E, 0xFB, cpu);
+}
+
+// SET 7, H
+static void cb_FC(Cpu *cpu) {
+    set(7, &cpu->registers.H, 0xFC, cpu);
+}
+
+// SET 7, L
+static void cb_FD(Cpu *cpu) {
+    set(7, &cpu->registers.L, 0xFD, cpu);
+}
+
+// SET 7, (HL)
+static void cb_FE(Cpu *cpu) {
+    set_m(7, 0xFE, cpu);
+}
+
+// SET 7,A
+static void cb_FF(Cpu *cpu) {
+    set(7, &cpu->registers.A, 0xFF, cpu);
+}
+
+// Handler for every 0xCB prefixed opcode
+static const cb_instruction cb_instructions[256] = {
+    cb_00, cb_01, cb_02, cb_03, cb_04, cb_05, cb_06, cb_07, cb_08, cb_09, cb_0A, cb_0B, cb_0C, cb_0D, cb_0E, cb_0F,
+    cb_10, cb_11, cb_12, cb_13, cb_14, cb_15, cb_16, cb_17, cb_18, cb_19, cb_1A, cb_1B, cb_1C, cb_1D, cb_1E, cb_1F,
+    cb_20, cb_21, cb_22, cb_23, cb_24, cb_25, cb_26, cb_27, cb_28, cb_29, cb_2A, cb_2B, cb_2C, cb_2D, cb_2E, cb_2F,
+    cb_30, cb_31, cb_32, cb_33, cb_34, cb_35, cb_36, cb_37, cb_38, cb_39, cb_3A, cb_3B, cb_3C, cb_3D, cb_3E, cb_3F,
+    cb_40, cb_41, cb_42, cb_43, cb_44, cb_45, cb_46, cb_47, cb_48, cb_49, cb_4A, cb_4B, cb_4C, cb_4D, cb_4E, cb_4F,
+    cb_50, cb_51, cb_52, cb_53, cb_54, cb_55, cb_56, cb_57, cb_58, cb_59, cb_5A, cb_5B, cb_5C, cb_5D, cb_5E, cb_5F,
+    cb_60, cb_61, cb_62, cb_63, cb_64, cb_65, cb_66, cb_67, cb_68, cb_69, cb_6A, cb_6B, cb_6C, cb_6D, cb_6E, cb_6F,
+    cb_70, cb_71, cb_72, cb_73, cb_74, cb_75, cb_76, cb_77, cb_78, cb_79, cb_7A, cb_7B, cb_7C, cb_7D, cb_7E, cb_7F,
+    cb_80, cb_81, cb_82, cb_83, cb_84, cb_85, cb_86, cb_87, cb_88, cb_89, cb_8A, cb_8B, cb_8C, cb_8D, cb_8E, cb_8F,
+    cb_90, cb_91, cb_92, cb_93, cb_94, cb_95, cb_96, cb_97, cb_98, cb_99, cb_9A, cb_9B, cb_9C, cb_9D, cb_9E, cb_9F,
+    cb_A0, cb_A1, cb_A2, cb_A3, cb_A4, cb_A5, cb_A6, cb_A7, cb_A8, cb_A9, cb_AA, cb_AB, cb_AC, cb_AD, cb_AE, cb_AF,
+    cb_B0, cb_B1, cb_B2, cb_B3, cb_B4, cb_B5, cb_B6, cb_B7, cb_B8, cb_B9, cb_BA, cb_BB, cb_BC, cb_BD, cb_BE, cb_BF,
+    cb_C0, cb_C1, cb_C2, cb_C3, cb_C4, cb_C5, cb_C6, cb_C7, cb_C8, cb_C9, cb_CA, cb_CB, cb_CC, cb_CD, cb_CE, cb_CF,
+    cb_D0, cb_D1, cb_D2, cb_D3, cb_D4, cb_D5, cb_D6, cb_D7, cb_D8, cb_D9, cb_DA, cb_DB, cb_DC, cb_DD, cb_DE, cb_DF,
+    cb_E0, cb_E1, cb_E2, cb_E3, cb_E4, cb_E5, cb_E6, cb_E7, cb_E8, cb_E9, cb_EA, cb_EB, cb_EC, cb_ED, cb_EE, cb_EF,
+    cb_F0, cb_F1, cb_F2, cb_F3, cb_F4, cb_F5, cb_F6, cb_F7, cb_F8, cb_F9, cb_FA, cb_FB, cb_FC, cb_FD, cb_FE, cb_FF,
+};
+
+// Execute instruction with a 0xCB pefix
+int executeExtendedInstruction(uint8 opcode, Cpu *cpu) {
+    cb_instructions[opcode](cpu);
+    return 0;
+}
+
+const cb_opcode cb_opcodes[256];
+
+// Return information about requested opcode
+cb_opcode get_cb_opcode(uint8 value) {
+    return cb_opcodes[value];
+}
+
+// Store format to printf each instruction
+const cb_opcode cb_opcodes[256] = {
+    { "0xCB00 RLC B" },
+    { "0xCB01 RLC C" },
+    { "0xCB02 RLC D" },
+    { "0xCB03 RLC E" },
+    { "0xCB04 RLC H" },
+    { "0xCB05 RLC L" },
+    { "0xCB06 RLC (HL)" },
+    { "0xCB07 RLC A" },
+    { "0xCB08 RRC B" },
+    { "0xCB09 RRC C" },
+    { "0xCB0A RRC D" },
+    { "0xCB0B RRC E" },
+    { "0xCB0C RRC H" },
+    { "0xCB0D RRC L" },
+    { "0xCB0E RRC (HL)" },
+    { "0xCB0F RRC A" },
+    { "0xCB10 RL B" },
+    { "0xCB11 RL C" },
+    { "0xCB12 RL D" },
+    { "0xCB13 RL E" },
+    { "0xCB14 RL H" },
+    { "0xCB15 RL L" },
+    { "0xCB16 RL (HL)" },
+    { "0xCB17 RL A" },
+    { "0xCB18 RR B" },
+    { "0xCB19 RR C" },
+    { "0xCB1A RR D" },
+    { "0xCB1B RR E" },
+    { "0xCB1C RR H" },
+    { "0xCB1D RR L" },
+    { "0xCB1E RR (HL)" },
+    { "0xCB1F RR A" },
+    { "0xCB20 SLA B" },
+    { "0xCB21 SLA C" },
+    { "0xCB22 SLA D" },
+    { "0xCB23 SLA E" },
+    { "0xCB24 SLA H" },
+    { "0xCB25 SLA L" },
+    { "0xCB26 SLA (HL)" },
+    { "0xCB27 SLA A" },
+    { "0xCB28 SRA B" },
+    { "0xCB29 SRA C" },
+    { "0xCB2A SRA D" },
+    { "0xCB2B SRA E" },
+    { "0xCB2C SRA H" },
+    { "0xCB2D SRA L" },
+    { "0xCB2E SRA (HL)" },
+    { "0xCB2F SRA A" },
+    { "0xCB30 SWAP B" },
+    { "0xCB31 SWAP C" },
+    { "0xCB32 SWAP D" },
+    { "0xCB33 SWAP E" },
+    { "0xCB34 SWAP H" },
+    { "0xCB35 SWAP L" },
+    { "0xCB36 SWAP (HL)" },
+    { "0xCB37 SWAP A" },
+    { "0xCB38 SRL B" },
+    { "0xCB39 SRL C" },
+    { "0xCB3A SRL D" },
+    { "0xCB3B SRL E" },
+    { "0xCB3C SRL H" },
+    { "0xCB3D SRL L" },
+    { "0xCB3E SRL (HL)" },
+    { "0xCB3F SRL A" },
+    { "0xCB40 BIT 0, B" },
+    { "0xCB41 BIT 0, C" },
+    { "0xCB42 BIT 0, D" },
+    { "0xCB43 BIT 0, E" },
+    { "0xCB44 BIT 0, H" },
+    { "0xCB45 BIT 0, L" },
+    { "0xCB46 BIT 0, (HL)" },
+    { "0xCB47 BIT 0, A" },
+    { "0xCB48 BIT 1, B" },
+    { "0xCB49 BIT 1, C" },
+    { "0xCB4A BIT 1, D" },
+    { "0xCB4B BIT 1, E" },
+    { "0xCB4C BIT 1, H" },
+    { "0xCB4D BIT 1, L" },
+    { "0xCB4E BIT 1, (HL)" },
+    { "0xCB4F BIT 1, A" },
+    { "0xCB50 BIT 2, B" },
+    { "0xCB51 BIT 2, C" },
+    { "0xCB52 BIT 2, D" },
+    { "0xCB53 BIT 2, E" },
+    { "0xCB54 BIT 2, H" },
+    { "0xCB55 BIT 2, L" },
+    { "0xCB56 BIT 2, (HL)" },
+    { "0xCB57 BIT 2, A" },
+    { "0xCB58 BIT 3, B" },
+    { "0xCB59 BIT 3, C" },
+    { "0xCB5A BIT 3, D" },
+    { "0xCB5B BIT 3, E" },
+    { "0xCB5C BIT 3, H" },
+    { "0xCB5D BIT 3, L" },
+    { "0xCB5E BIT 3, (HL)" },
+    { "0xCB5F BIT 3, A" },
+    { "0xCB60 BIT 4, B" },
+    { "0xCB61 BIT 4, C" },
+    { "0xCB62 BIT 4, D" },
+    { "0xCB63 BIT 4, E" },
+    { "0xCB64 BIT 4, H" },
+    { "0xCB65 BIT 4, L" },
+    { "0xCB66 BIT 4, (HL)" },
+    { "0xCB67 BIT 4, A" },
+    { "0xCB68 BIT 5, B" },
+    { "0xCB69 BIT 5, C" },
+    { "0xCB6A BIT 5, D" },
+    { "0xCB6B BIT 5, E" },
+    { "0xCB6C BIT 5, H" },
+    { "0xCB6D BIT 5, L" },
+    { "0xCB6E BIT 5, (HL)" },
+    { "0xCB6F BIT 5, A" },
+    { "0xCB70 BIT 6, B" },
+    { "0xCB71 BIT 6, C" },
+    { "0xCB72 BIT 6, D" },
+    { "0xCB73 BIT 6, E" },
+    { "0xCB74 BIT 6, H" },
+    { "0xCB75 BIT 6, L" },
+    { "0xCB76 BIT 6, (HL)" },
+    { "0xCB77 BIT 6, A" },
+    { "0xCB78 BIT 7, B" },
+    { "0xCB79 BIT 7, C" },
+    { "0xCB7A BIT 7, D" },
+    { "0xCB7B BIT 7, E" },
+    { "0xCB7C BIT 7, H" },
+    { "0xCB7D BIT 7, L" },
+    { "0xCB7E BIT 7, (HL)" },
+    { "0xCB7F BIT 7, A" },
+    { "0xCB80 RES 0, B" },
+    { "0xCB81 RES 0, C" },
+    { "0xCB82 RES 0, D" },
+    { "0xCB83 RES 0, E" },
+    { "0xCB84 RES 0, H" },
+    { "0xCB85 RES 0, L" },
+    { "0xCB86 RES 0, (HL)" },
+    { "0xCB87 RES 0, A" },
+    { "0xCB88 RES 1, B" },
+    { "0xCB89 RES 1, C" },
+    { "0xCB8A RES 1, D" },
+    { "0xCB8B RES 1, E" },
+    { "0xCB8C RES 1, H" },
+    { "0xCB8D RES 1, L" },
+    { "0xCB8E RES 1, (HL)" },
+    { "0xCB8F RES 1, A" },
+    { "0xCB90 RES 2, B" },
+    { "0xCB91 RES 2, C" },
+    { "0xCB92 RES 2, D" },
+    { "0xCB93 RES 2, E" },
+    { "0xCB94 RES 2, H" },
+    { "0xCB95 RES 2, L" },
+    { "0xCB96 RES 2, (HL)" },
+    { "0xCB97 RES 2, A" },
+    { "0xCB98 RES 3, B" },
+    { "0xCB99 RES 3, C" },
+    { "0xCB9A RES 3, D" },
+    { "0xCB9B RES 3, E" },
+    { "0xCB9C RES 3, H" },
+    { "0xCB9D RES 3, L" },
+    { "0xCB9E RES 3, (HL)" },
+    { "0xCB9F RES 3, A" },
+    { "0xCBA0 RES 4, B" },
+    { "0xCBA1 RES 4, C" },
+    { "0xCBA2 RES 4, D" },
+    { "0xCBA3 RES 4, E" },
+    { "0xCBA4 RES 4, H" },
+    { "0xCBA5 RES 4, L" },
+    { "0xCBA6 RES 4, (HL)" },
+    { "0xCBA7 RES 4, A" },
+    { "0xCBA8 RES 5, B" },
+    { "0xCBA9 RES 5, C" },
+    { "0xCBAA RES 5, D" },
+    { "0xCBAB RES 5, E" },
+    { "0xCBAC RES 5, H" },
+    { "0xCBAD RES 5, L" },
+    { "0xCBAE RES 5, (HL)" },
+    { "0xCBAF RES 5, A" },
+    { "0xCBB0 RES 6, B" },
+    { "0xCBB1 RES 6, C" },
+    { "0xCBB2 RES 6, D" },
+    { "0xCBB3 RES 6, E" },
+    { "0xCBB4 RES 6, H" },
+    { "0xCBB5 RES 6, L" },
+    { "0xCBB6 RES 6, (HL)" },
+    { "0xCBB7 RES 6, A" },
+    { "0xCBB8 RES 7, B" },
+    { "0xCBB9 RES 7, C" },
+    { "0xCBBA RES 7, D" },
+    { "0xCBBB RES 7, E" },
+    { "0xCBBC RES 7, H" },
+    { "0xCBBD RES 7, L" },
+    { "0xCBBE RES 7, (HL)" },
+    { "0xCBBF RES 7, A" },
+    { "0xCBC0 SET 0, B" },
+    { "0xCBC1 SET 0, C" },
+    { "0xCBC2 SET 0, D" },
+    { "0xCBC3 SET 0, E" },
+    { "0xCBC4 SET 0, H" },
+    { "0xCBC5 SET 0, L" },
+    { "0xCBC6 SET 0, (HL)" },
+    { "0xCBC7 SET 0, A" },
+    { "0xCBC8 SET 1, B" },
+    { "0xCBC9 SET 1, C" },
+    { "0xCBCA SET 1, D" },
+    { "0xCBCB SET 1, E" },
+    { "0xCBCC SET 1, H" },
+    { "0xCBCD SET 1, L" },
+    { "0xCBCE SET 1, (HL)" },
+    { "0xCBCF SET 1, A" },
+    { "0xCBD0 SET 2, B" },
+    { "0xCBD1 SET 2, C" },
+    { "0xCBD2 SET 2, D" },
+    { "0xCBD3 SET 2, E" },
+    { "0xCBD4 SET 2, H" },
+    { "0xCBD5 SET 2, L" },
+    { "0xCBD6 SET 2, (HL)" },
+    { "0xCBD7 SET 2, A" },
+    { "0xCBD8 SET 3, B" },
+    { "0xCBD9 SET 3, C" },
+    { "0xCBDA SET 3, D" },
+    { "0xCBDB SET 3, E" },
+    { "0xCBDC SET 3, H" },
+    { "0xCBDD SET 3, L" },
+    { "0xCBDE SET 3, (HL)" },
+    { "0xCBDF SET 3, A" },
+    { "0xCBE0 SET 4, B" },
+    { "0xCBE1 SET 4, C" },
+    { "0xCBE2 SET 4, D" },
+    { "0xCBE3 SET 4, E" },
+    { "0xCBE4 SET 4, H" },
+    { "0xCBE5 SET 4, L" },
+    { "0xCBE6 SET 4, (HL)" },
+    { "0xCBE7 SET 4, A" },
+    { "0xCBE8 SET 5, B" },
+    { "0xCBE9 SET 5, C" },
+    { "0xCBEA SET 5, D" },
+    { "0xCBEB SET 5, E" },
+    { "0xCBEC SET 5, H" },
+    { "0xCBED SET 5, L" },
+    { "0xCBEE SET 5, (HL)" },
+    { "0xCBEF SET 5, A" },
+    { "0xCBF0 SET 6, B" },
+    { "0xCBF1 SET 6, C" },
+    { "0xCBF2 SET 6, D" },
+    { "0xCBF3 SET 6, E" },
+    { "0xCBF4 SET 6, H" },
+    { "0xCBF5 SET 6, L" },
+    { "0xCBF6 SET 6, (HL)" },
+    { "0xCBF7 SET 6, A" },
+    { "0xCBF8 SET 7, B" },
+    { "0xCBF9 SET 7, C" },
+    { "0xCBFA SET 7, D" },
+    { "0xCBFB SET 7, E" },
+    { "0xCBFC SET 7, H" },
+    { "0xCBFD SET 7, L" },
+    { "0xCBFE SET 7, (HL)" },
+    { "0xCBFF SET 7, A" }
+};
+
+// Number of cycles each 0xCB prefixed instruction takes, including the prefix.
+const uint8 cb_opcode_cycles[256] = {
+     8,  8,  8,  8,  8,  8, 16,  8,  8,  8,  8,  8,  8,  8, 16,  8, // 0x00
+     8,  8,  8,  8,  8,  8, 16,  8,  8,  8,  8,  8,  8,  8, 16,  8, // 0x10
+     8,  8,  8,  8,  8,  8, 16,  8,  8,  8,  8,  8,  8,  8, 16,  8, // 0x20
+     8,  8,  8,  8,  8,  8, 16,  8,  8,  8,  8,  8,  8,  8, 16,  8, // 0x30
+     8,  8,  8,  8,  8,  8, 12,  8,  8,  8,  8,  8,  8,  8, 12,  8, // 0x40
+     8,  8,  8,  8,  8,  8, 12,  8,  8,  8,  8,  8,  8,  8, 12,  8, // 0x50
+     8,  8,  8,  8,  8,  8, 12,  8,  8,  8,  8,  8,  8,  8, 12,  8, // 0x60
+     8,  8,  8,  8,  8,  8, 12,  8,  8,  8,  8,  8,  8,  8, 12,  8, // 0x70
+     8,  8,  8,  8,  8,  8, 16,  8,  8,  8,  8,  8,  8,  8, 16,  8, // 0x80
+     8,  8,  8,  8,  8,  8, 16,  8,  8,  8,  8,  8,  8,  8, 16,  8, // 0x90
+     8,  8,  8,  8,  8,  8, 16,  8,  8,  8,  8,  8,  8,  8, 16,  8, // 0xA0
+     8,  8,  8,  8,  8,  8, 16,  8,  8,  8,  8,  8,  8,  8, 16,  8, // 0xB0
+     8,  8,  8,  8,  8,  8, 16,  8,  8,  8,  8,  8,  8,  8, 16,  8, // 0xC0
+     8,  8,  8,  8,  8,  8, 16,  8,  8,  8,  8,  8,  8,  8, 16,  8, // 0xD0
+     8,  8,  8,  8,  8,  8, 16,  8,  8,  8,  8,  8,  8,  8, 16,  8, // 0xE0
+     8,  8,  8,  8,  8,  8, 16,  8,  8,  8,  8,  8,  8,  8, 16,  8, // 0xF0
+};
@@ -5,22 +5,8 @@
 #include "../interrupts.h"
 #include "opcodes.h"
 
-//read one unsigned byte from the PC
-static uint8 oneByte(Cpu *cpu) {
-    return readNextByte(cpu);
-}
-
-//read one signed byte from the PC
-static int8 oneByteSigned(Cpu *cpu) {
-    return (int8)readNextByte(cpu);
-}
-
-//read a short from memory
-static uint16 twoBytes(Cpu *cpu) {
-    uint16 lsb = (uint16)readNextByte(cpu); //read least significant byte first
-    uint16 msb = ((uint16)readNextByte(cpu)) << 8; //then read most significant byte
-    return lsb | msb;
-}
+// Define an instruction handler. Most don't use the operand.
+#define INSTRUCTION(name) static int name(__attribute__((unused)) uint16 operand, Cpu *cpu)
 
 //Halt the cpu until there is a interrupt
 static void halt(uint8 opcode, Cpu *cpu) {
@@ -31,57 +17,52 @@ static void halt(uint8 opcode, Cpu *cpu) {
         cpu->halt_bug = true;
         cpu->halt = false;
     }
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
     //debug(true, cpu);
 }
 
 //compare instruction
 static void cp(uint8 b, uint8 opcode, Cpu *cpu) {
     uint8 a = cpu->registers.A;
-    //set flags
-    (a - b == 0) ? setFlag(ZF, cpu) : clearFlag(ZF, cpu);
-    //cpu->FLAGS[ZF] = (temp == 0); //zero flag
-    setFlag(NF, cpu);
-    //cpu->FLAGS[NF] = 0x1; //subtract flag
-    ((a & 0xF) < (b & 0xF)) ? setFlag(HF, cpu) : clearFlag(HF, cpu);
-    //cpu->FLAGS[HF] = ((a & 0xF) < (b & 0xF)); //half-carry flag
-    (a < b) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    //cpu->FLAGS[CF] = (a < b); //carry flag
-    cpu->wait = get_opcode(opcode).cycles;
+    uint16 result = a - b;
+    //set flags from the subtraction, the result is thrown away
+    cpu->registers.zero = (uint8) result;
+    cpu->registers.negative = true;
+    cpu->registers.half = a ^ b ^ result;
+    cpu->registers.carry = result;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //set the carry flag
 static void scf(uint8 opcode, Cpu *cpu) {
     //set carry flag
-    setFlag(CF, cpu);
-    //reset negative flag
-    clearFlag(NF, cpu);
-    //reset half-carry flag
-    clearFlag(HF, cpu);
+    cpu->registers.carry = 0x100;
+    //reset negative and half-carry flags
+    cpu->registers.negative = false;
+    cpu->registers.half = 0;
     //leave zero flag alone
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //complement the carry flag
 static void ccf(uint8 opcode, Cpu *cpu) {
     //complement the state of the carry flag.
-    (readFlag(CF, cpu)) ? clearFlag(CF, cpu) : setFlag(CF, cpu);
-    //reset negative flag
-    clearFlag(NF, cpu);
-    //reset half-carry flag
-    clearFlag(HF, cpu);
+    cpu->registers.carry ^= 0x100;
+    //reset negative and half-carry flags
+    cpu->registers.negative = false;
+    cpu->registers.half = 0;
     //leave zero flag alone
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //jump to a 16bit address if condition is set
 static void jp_c(bool set, uint16 address, uint8 opcode, Cpu *cpu) {
     if (set) {
         cpu->PC = address;
-        cpu->wait = get_opcode(opcode).cyclesMax;
+        cpu->wait = opcode_cycles_taken[opcode];
     } else {
         //do nothing
-        cpu->wait = get_opcode(opcode).cycles;
+        cpu->wait = opcode_cycles[opcode];
     }
 }
 
@@ -89,184 +70,173 @@ static void jp_c(bool set, uint16 address, uint8 opcode, Cpu *cpu) {
 static void jr_c(bool set, int8 address, uint8 opcode, Cpu *cpu) {
     if (set) {
         cpu->PC += address;
-        cpu->wait = get_opcode(opcode).cyclesMax;
+        cpu->wait = opcode_cycles_taken[opcode];
     } else {
         //do nothing
-        cpu->wait = get_opcode(opcode).cycles;
+        cpu->wait = opcode_cycles[opcode];
     }
 }
 
 //load 8 bit value into some register
 static void ld_8(uint8 value, uint8 *reg, uint8 opcode, Cpu *cpu) {
     *reg = value;
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //load 8 bit value into some address in memory
 static void ld_8_m(uint8 value, uint16 address, uint8 opcode, Cpu *cpu) {
     writeByte(address, value, cpu);
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //load 8 bit value into a register from some address in memory and increment the value in the HL register
 static void ldi(uint8 opcode, Cpu *cpu) {
     cpu->registers.A = readByte(cpu->registers.HL, cpu);
     cpu->registers.HL++;
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //load 8 bit value from a register into some address in memory and increment the value in the HL register
 static void ldi_m(uint8 opcode, Cpu *cpu) {
     writeByte(cpu->registers.HL, cpu->registers.A, cpu);
     cpu->registers.HL++;
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //load 8 bit value into a register from some address in memory and decrement the value in the HL register
 static void ldd(uint8 opcode, Cpu *cpu) {
     cpu->registers.A = readByte(cpu->registers.HL, cpu);
     cpu->registers.HL--;
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //load 8 bit value from a register into some address in memory and decrement the value in the HL register
 static void ldd_m(uint8 opcode, Cpu *cpu) {
     writeByte(cpu->registers.HL, cpu->registers.A, cpu);
     cpu->registers.HL--;
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //load 16 bit value into some destination register
 static void ld_16(uint16 value, uint16 *reg, uint8 opcode, Cpu *cpu) {
     *reg = value;
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //load 16 bit value into some addres in memory
 static void ld_16_m(uint16 value, uint16 address, uint8 opcode, Cpu *cpu) {
     writeShort(address, value, cpu);
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //increment a byte in a register
 static void inc_8(uint8 *reg, uint8 opcode, Cpu *cpu) {
-    //set or reset zero flag based on whether result is zero
-    ((uint8)(*reg + 1)) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    //reset negative flag
-    clearFlag(NF, cpu);
-    //set half-carry flag based on result
-    ((*reg & 0xF) == 0xF) ? setFlag(HF, cpu) : clearFlag(HF, cpu);
-    (*reg)++;
-    cpu->wait = get_opcode(opcode).cycles;
+    uint8 result = *reg + 1;
+    //zero and half-carry flags come from the result, carry flag isn't touched
+    cpu->registers.zero = result;
+    cpu->registers.negative = false;
+    cpu->registers.half = *reg ^ result;
+    *reg = result;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //increment a byte at the memory location stored in HL
 static void inc_8_m(uint8 opcode, Cpu *cpu) {
-    //set or reset zero flag based on whether result is zero
-    ((uint8)(readByte(cpu->registers.HL, cpu) + 1)) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    //reset negative flag
-    clearFlag(NF, cpu);
-    //set or reset half-carry flag based on result
-    ((readByte(cpu->registers.HL, cpu) & 0xF) == 0xF) ? setFlag(HF, cpu) : clearFlag(HF, cpu);
-    //no change to carry flag
-    writeByte(cpu->registers.HL, readByte(cpu->registers.HL, cpu) + 1, cpu);
-    cpu->wait = get_opcode(opcode).cycles;
+    uint8 value = readByte(cpu->registers.HL, cpu);
+    uint8 result = value + 1;
+    //zero and half-carry flags come from the result, carry flag isn't touched
+    cpu->registers.zero = result;
+    cpu->registers.negative = false;
+    cpu->registers.half = value ^ result;
+    writeByte(cpu->registers.HL, result, cpu);
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //increment a short
 static void inc_16(uint16 *reg, uint8 opcode, Cpu *cpu) {
     // inc_16 doesn't set or clear any flags
     (*reg)++;
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //decrement a byte in memory
 static void dec_8(uint8 *reg, uint8 opcode, Cpu *cpu) {
-    //zero flag
-    (*reg - 1) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    //negative flag
-    setFlag(NF, cpu);
-    //half-carry flag
-    (*reg & 0xF) ? clearFlag(HF, cpu) : setFlag(HF, cpu);
-    (*reg)--;
-    cpu->wait = get_opcode(opcode).cycles;
+    uint8 result = *reg - 1;
+    //zero and half-carry flags come from the result, carry flag isn't touched
+    cpu->registers.zero = result;
+    cpu->registers.negative = true;
+    cpu->registers.half = *reg ^ result;
+    *reg = result;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //decrement a byte at the memory location stored in HL
 static void dec_8_m(uint8 opcode, Cpu *cpu) {
-    //zero flag
-    (readByte(cpu->registers.HL, cpu) - 1) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    //negative flag
-    setFlag(NF, cpu);
-    //half-carry flag
-    (readByte(cpu->registers.HL, cpu) & 0xF) ? clearFlag(HF, cpu) : setFlag(HF, cpu);
-    writeByte(cpu->registers.HL, readByte(cpu->registers.HL, cpu) - 1, cpu);
-    cpu->wait = get_opcode(opcode).cycles;
+    uint8 value = readByte(cpu->registers.HL, cpu);
+    uint8 result = value - 1;
+    //zero and half-carry flags come from the result, carry flag isn't touched
+    cpu->registers.zero = result;
+    cpu->registers.negative = true;
+    cpu->registers.half = value ^ result;
+    writeByte(cpu->registers.HL, result, cpu);
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //decrement a short
 static void dec_16(uint16 *reg, uint8 opcode, Cpu *cpu) {
     //dec_16 doesn't set or clear any flags
     (*reg)--;
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //add together some 8 bit unsigned value and the A register
 static void add_8(uint8 value, uint8 opcode, Cpu *cpu) {
-    //zero flag
-    ((uint8)(cpu->registers.A + value)) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    //reset negative flag
-    clearFlag(NF, cpu);
-    //half-carry flag
-    ((cpu->registers.A & 0xF) + (value & 0xF) > 0xF) ? setFlag(HF, cpu) : clearFlag(HF, cpu);
-    //carry flag
-    (((uint16)cpu->registers.A) + ((uint16)value) > 0xFF) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    //set value after flags are calculated
-    cpu->registers.A += value;
-    cpu->wait = get_opcode(opcode).cycles;
+    uint16 result = cpu->registers.A + value;
+    //flags come from the operands and result
+    cpu->registers.zero = (uint8) result;
+    cpu->registers.negative = false;
+    cpu->registers.half = cpu->registers.A ^ value ^ result;
+    cpu->registers.carry = result;
+    cpu->registers.A = (uint8) result;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //subtract an unsigned 8 bit value from the A register
 static void sub_8(uint8 value, uint8 opcode, Cpu *cpu) {
-    //zero flag
-    (cpu->registers.A == value) ? setFlag(ZF, cpu) : clearFlag(ZF, cpu);
-    //set negative flag
-    setFlag(NF, cpu);
-    //set or reset half-carry flag based on result
-    ((cpu->registers.A & 0xF) < (value & 0xF)) ? setFlag(HF, cpu) : clearFlag(HF, cpu);
-    //set or reset carry flag based on result
-    (cpu->registers.A < value) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    //set value after flags are calculated
-    cpu->registers.A -= value;
-    cpu->wait = get_opcode(opcode).cycles;
+    uint16 result = cpu->registers.A - value;
+    //flags come from the operands and result. A borrow leaves bit 8 of the result set.
+    cpu->registers.zero = (uint8) result;
+    cpu->registers.negative = true;
+    cpu->registers.half = cpu->registers.A ^ value ^ result;
+    cpu->registers.carry = result;
+    cpu->registers.A = (uint8) result;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //add together two unsigned 16 bit values and set flags
 static void add_16(uint16 value, uint16 *reg, uint8 opcode, Cpu *cpu) {
+    uint32 result = *reg + value;
     //zero flag isn't touched
-    //reset negative flag
-    clearFlag(NF, cpu);
-    //set or reset half-carry flag based on result (in 16bit ALU the highest bytes set the CF last, so only check for the high byte 3 -> 4 bit carry)
-    ((*reg & 0xFFF) + (value & 0xFFF) > 0xFFF) ? setFlag(HF, cpu) : clearFlag(HF, cpu);
-    //set or reset carry flag based on result
-    (((uint32)*reg) + ((uint32)value) > 0xFFFF) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    //set value after flags are calculated
-    *reg += value;
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->registers.negative = false;
+    //in the 16bit ALU the high byte sets the flags last, so the half-carry is from bit 11 and carry from bit 15
+    cpu->registers.half = (*reg ^ value ^ result) >> 8;
+    cpu->registers.carry = result >> 8;
+    *reg = (uint16) result;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 // Add together a signed byte and an unsigned short, save the result in some short register, and set flags.
 static void add_16_8(int8 s_byte, uint16 u_short, uint16 *reg, uint8 opcode, Cpu *cpu) {
-    // Set or clear half-carry flag based on result
-    ((u_short & 0xF) + (s_byte & 0xF) > 0xF) ? setFlag(HF, cpu) : clearFlag(HF, cpu);
-    // Set or clear carry flag based on result.
-    ((u_short & 0xFF) + (s_byte & 0xFF) > 0xFF) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
+    // Half-carry and carry flags come from adding the byte to the low byte of the short
+    uint16 low = (u_short & 0xFF) + (uint8) s_byte;
+    cpu->registers.half = u_short ^ (uint8) s_byte ^ low;
+    cpu->registers.carry = low;
     // Clear flags
-    clearFlag(ZF, cpu);
-    clearFlag(NF, cpu);
+    cpu->registers.zero = 1;
+    cpu->registers.negative = false;
     // Save reult to given register
     *reg = u_short + s_byte;
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //8 bit add between the A register, some value, and the carry flag
@@ -303,51 +273,42 @@ static void sbc(uint8 value, uint8 opcode, Cpu *cpu) {
 
 //rotate register A left, old bit 7 to carry bit and bit 0
 static void rlca(uint8 opcode, Cpu *cpu) {
-    //set carry flag based on bit 7
-    (cpu->registers.A >> 7) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    //shift left and use carry flag/bit 7 as new bit 0
-    cpu->registers.A = (cpu->registers.A << 1) | readFlag(CF, cpu);
-    //reset zero flag
-    clearFlag(ZF, cpu);
-    //reset half-carry flag
-    clearFlag(HF, cpu);
-    //reset negative flag
-    clearFlag(NF, cpu);
-    cpu->wait = get_opcode(opcode).cycles;
+    //shift left, old bit 7 lands in the carry flag and is used as the new bit 0
+    cpu->registers.carry = cpu->registers.A << 1;
+    cpu->registers.A = (cpu->registers.A << 1) | (cpu->registers.A >> 7);
+    //reset zero, half-carry and negative flags
+    cpu->registers.zero = 1;
+    cpu->registers.half = 0;
+    cpu->registers.negative = false;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //rotate the A register left, old bit 7 to carry bit and old carry bit to bit 0
 static void rla(uint8 opcode, Cpu *cpu) {
     //read carry flag state into temp variable
     bool flagState = readFlag(CF, cpu);
-    //update the carry flag
-    (cpu->registers.A >> 7) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    //shift right
-    cpu->registers.A <<= 1;
+    //shift left, old bit 7 lands in the carry flag
+    cpu->registers.carry = cpu->registers.A << 1;
     //insert previous flag state into bit 0
-    cpu->registers.A |= flagState;
-    //clear zero flag
-    clearFlag(ZF, cpu);
-    //clear half-carry flag
-    clearFlag(HF, cpu);
-    //clear negative flag
-    clearFlag(NF, cpu);
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->registers.A = (cpu->registers.A << 1) | flagState;
+    //clear zero, half-carry and negative flags
+    cpu->registers.zero = 1;
+    cpu->registers.half = 0;
+    cpu->registers.negative = false;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //rotate register A left, old bit 0 to carry bit and bit 7
 static void rrca(uint8 opcode, Cpu *cpu) {
-    //set carry flag based on bit 7
-    (cpu->registers.A & 0b1) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    //shift left and use carry flag/bit 7 as new bit 0
-    cpu->registers.A = (cpu->registers.A >> 1) | (((uint8) readFlag(CF, cpu)) << 7);
-    //reset zero flag
-    clearFlag(ZF, cpu);
-    //reset half-carry flag
-    clearFlag(HF, cpu);
-    //reset negative flag
-    clearFlag(NF, cpu);
-    cpu->wait = get_opcode(opcode).cycles;
+    //set carry flag based on bit 0
+    cpu->registers.carry = (cpu->registers.A & 0b1) << 8;
+    //shift right and use bit 0 as new bit 7
+    cpu->registers.A = (cpu->registers.A >> 1) | (cpu->registers.A << 7);
+    //reset zero, half-carry and negative flags
+    cpu->registers.zero = 1;
+    cpu->registers.half = 0;
+    cpu->registers.negative = false;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //right rotate the A register. New 7th bit is set by the carry flag and the carry flag is set by old 1st bit.
@@ -355,45 +316,41 @@ static void rra(uint8 opcode, Cpu *cpu) {
     //read carry flag state into temp variable
     bool flagState = readFlag(CF, cpu);
     //update the carry flag
-    (cpu->registers.A & 0b1) ? setFlag(CF, cpu) : clearFlag(CF, cpu);
-    //shift right
-    cpu->registers.A = cpu->registers.A >> 1;
-    //insert previous flag state into bit 7
-    cpu->registers.A |= flagState << 7;
-    //reset zero flag
-    clearFlag(ZF, cpu);
-    //reset half-carry flag
-    clearFlag(HF, cpu);
-    //reset negative flag
-    clearFlag(NF, cpu);
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->registers.carry = (cpu->registers.A & 0b1) << 8;
+    //shift right and insert previous flag state into bit 7
+    cpu->registers.A = (cpu->registers.A >> 1) | (flagState << 7);
+    //reset zero, half-carry and negative flags
+    cpu->registers.zero = 1;
+    cpu->registers.half = 0;
+    cpu->registers.negative = false;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //complement the A register
 static void cpl(uint8 opcode, Cpu *cpu) {
-    //set negative flag
-    setFlag(NF, cpu);
-    //set half-carry flag
-    setFlag(HF, cpu);
+    //set negative and half-carry flags
+    cpu->registers.negative = true;
+    cpu->registers.half = 0x10;
     //no change to zero flag and carry flag
     cpu->registers.A = ~cpu->registers.A;
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //push a short onto the stack
 static void push(uint16 value, uint8 opcode, Cpu *cpu) {
     writeShortToStack(value, cpu);
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //pop a short from the stack
 static void pop(uint16 *reg, bool AF, uint8 opcode, Cpu *cpu) {
     *reg = readShortFromStack(cpu);
-    // Mask out lower bytes if writing to AF register
+    // Mask out lower bytes if writing to AF register, and unpack the new flags
     if (AF) {
         *reg &= 0xFFF0;
+        writeFlagsRegister(cpu->registers.F, cpu);
     }
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //standard call. Save PC to the stack
@@ -403,10 +360,10 @@ static void call_c(bool set, uint16 pointer, uint8 opcode, Cpu *cpu) {
         writeShortToStack(cpu->PC, cpu);
         //change to new PC
         cpu->PC = pointer;
-        cpu->wait = get_opcode(opcode).cyclesMax;
+        cpu->wait = opcode_cycles_taken[opcode];
     } else {
         //condition not met: do nothing
-        cpu->wait = get_opcode(opcode).cycles;
+        cpu->wait = opcode_cycles[opcode];
     }
 }
 
@@ -415,17 +372,17 @@ static void ret_c(bool set, uint8 opcode, Cpu *cpu) {
     if (set) {
         //restore PC from stack
         cpu->PC = readShortFromStack(cpu);
-        cpu->wait = get_opcode(opcode).cyclesMax;
+        cpu->wait = opcode_cycles_taken[opcode];
     } else {
         //condition not met: do nothing
-        cpu->wait = get_opcode(opcode).cycles;
+        cpu->wait = opcode_cycles[opcode];
     }
 }
 
 //return after call and enable interrupts
 static void reti(uint8 opcode, Cpu *cpu) {
     cpu->PC = readShortFromStack(cpu);
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
     cpu->ime = true;
 }
 
@@ -434,7 +391,7 @@ static void ei(uint8 opcode, Cpu *cpu) {
     // Disable interrupts for 4 cycles, then re-enable
     cpu->ime = false;
     cpu->ime_enable = true;
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 // Disable interrupts immediately
@@ -442,56 +399,47 @@ static void di(uint8 opcode, Cpu *cpu) {
     // Interrupts are disabled immediately
     cpu->ime = false;
     cpu->ime_enable = false;
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //restart at given address. Save previous PC to the stack
 static void rst(uint8 pc, uint8 opcode, Cpu *cpu) {
     writeShortToStack(cpu->PC, cpu);
     cpu->PC = (uint16)pc;
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //xor A register with given value and set flags
 static void xor(uint8 value, uint8 opcode, Cpu *cpu) {
     cpu->registers.A ^= value;
-    //set or reset zero flag based on whether result is zero
-    (cpu->registers.A) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    //reset negative flag
-    clearFlag(NF, cpu);
-    //reset half-carry flag
-    clearFlag(HF, cpu);
-    //reset carry flag
-    clearFlag(CF, cpu);
-    cpu->wait = get_opcode(opcode).cycles;
+    //zero flag from the result, reset negative, half-carry and carry flags
+    cpu->registers.zero = cpu->registers.A;
+    cpu->registers.negative = false;
+    cpu->registers.half = 0;
+    cpu->registers.carry = 0;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //perform logical and on the A register with a given value and set values
 static void and(uint8 value, uint8 opcode, Cpu *cpu) {
     cpu->registers.A &= value;
-    //set or reset zero flag based on whether result is zero
-    (!cpu->registers.A) ? setFlag(ZF, cpu) : clearFlag(ZF, cpu);
-    //reset negative flag
-    clearFlag(NF, cpu);
-    //set carry flag
-    setFlag(HF, cpu);
-    //reset carry flag
-    clearFlag(CF, cpu);
-    cpu->wait = get_opcode(opcode).cycles;
+    //zero flag from the result, set half-carry flag, reset negative and carry flags
+    cpu->registers.zero = cpu->registers.A;
+    cpu->registers.negative = false;
+    cpu->registers.half = 0x10;
+    cpu->registers.carry = 0;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 //perform logical or on the A register with a given value and set flags
 static void or(uint8 value, uint8 opcode, Cpu *cpu) {
     cpu->registers.A |= value;
-    //set or reset zero flag based on whether result is zero
-    (!cpu->registers.A) ? setFlag(ZF, cpu) : clearFlag(ZF, cpu);
-    //reset negative flag
-    clearFlag(NF, cpu);
-    //reset half-carry flag
-    clearFlag(HF, cpu);
-    //reset carry flag
-    clearFlag(CF, cpu);
-    cpu->wait = get_opcode(opcode).cycles;
+    //zero flag from the result, reset negative, half-carry and carry flags
+    cpu->registers.zero = cpu->registers.A;
+    cpu->registers.negative = false;
+    cpu->registers.half = 0;
+    cpu->registers.carry = 0;
+    cpu->wait = opcode_cycles[opcode];
 }
 
 // Decimal adjust register A. Hex to Binary Coded Decimal. This makes the max
@@ -525,1029 +473,1849 @@ static void daa(uint8 opcode, Cpu *cpu) {
     // Mask and set value
     cpu->registers.A = (uint8)reg_a;
     // Zero flag
-    (cpu->registers.A) ? clearFlag(ZF, cpu) : setFlag(ZF, cpu);
-    cpu->wait = get_opcode(opcode).cycles;
+    cpu->registers.zero = cpu->registers.A;
+    cpu->wait = opcode_cycles[opcode];
 }
 
-//execute next instruction
-int executeNextInstruction(Cpu * cpu) {
-    // Don't execute if halt is called
-    if (cpu->halt) {
-        return 432;
-    }
-    /*uint8 temp = readByte(cpu->PC, cpu);
-    if (readFlag(CF, cpu) && (temp == 0xCE || temp == 0xDE)) {
-        debug(true, cpu);
-    }*/
-    //printInstruction(true, cpu->PC, cpu);
-    //grab instruction
-    uint8 opcode = readNextByte(cpu);
-    //find and execute next instruction
-    switch (opcode) {
-        case 0x00: //NOP
-            cpu->wait = 4;
-            break;
-        case 0x01: //LD BC, d16
-            ld_16(twoBytes(cpu), &cpu->registers.BC, opcode, cpu);
-            break;
-        case 0x02: //LD (BC), A
-            ld_8_m(cpu->registers.A, cpu->registers.BC, opcode, cpu);
-            break;
-        case 0x03: //INC BC
-            inc_16(&cpu->registers.BC, opcode, cpu);
-            break;
-        case 0x04: //INC B
-            inc_8(&cpu->registers.B, opcode, cpu);
-            break;
-        case 0x05: //DEC B
-            dec_8(&cpu->registers.B, opcode, cpu);
-            break;
-        case 0x06: //LD B, d8
-            ld_8(oneByte(cpu), &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x07: //RLCA
-            rlca(opcode, cpu);
-            break;
-        case 0x08: //LD (a16), SP
-            ld_16_m(cpu->SP, twoBytes(cpu), opcode, cpu);
-            break;
-        case 0x09: //ADD HL, BC
-            add_16(cpu->registers.BC, &cpu->registers.HL, opcode, cpu);
-            break;
-        case 0x0A: //LD A, (BC)
-            ld_8(readByte(cpu->registers.BC, cpu), &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x0B: //DEC BC
-            dec_16(&cpu->registers.BC, opcode, cpu);
-            break;
-        case 0x0C: //INC C
-            inc_8(&cpu->registers.C, opcode, cpu);
-            break;
-        case 0x0D: //DEC C
-            dec_8(&cpu->registers.C, opcode, cpu);
-            break;
-        case 0x0E: //LD C, d8
-            ld_8(oneByte(cpu), &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x0F: //RRCA
-            rrca(opcode, cpu);
-            break;
-        case 0x11: //LD DE, d16
-            ld_16(twoBytes(cpu), &cpu->registers.DE, opcode, cpu);
-            break;
-        case 0x12: //LD (DE), A
-            ld_8_m(cpu->registers.A, cpu->registers.DE, opcode, cpu);
-            break;
-        case 0x13: //INC DE
-            inc_16(&cpu->registers.DE, opcode, cpu);
-            break;
-        case 0x14: //INC D
-            inc_8(&cpu->registers.D, opcode, cpu);
-            break;
-        case 0x15: //DEC D
-            dec_8(&cpu->registers.D, opcode, cpu);
-            break;
-        case 0x16: //LD D, d8
-            ld_8(oneByte(cpu), &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x17: //RLA
-            rla(opcode, cpu);
-            break;
-        case 0x18: //JR r8
-            jr_c(true, oneByteSigned(cpu), opcode, cpu);
-            break;
-        case 0x19: //ADD HL, DE
-            add_16(cpu->registers.DE, &cpu->registers.HL, opcode, cpu);
-            break;
-        case 0x1A: //LD A, (DE)
-            ld_8(readByte(cpu->registers.DE, cpu), &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x1B: //DEC DE
-            dec_16(&cpu->registers.DE, opcode, cpu);
-            break;
-        case 0x1C: //INC E
-            inc_8(&cpu->registers.E, opcode, cpu);
-            break;
-        case 0x1D: //DEC E
-            dec_8(&cpu->registers.E, opcode, cpu);
-            break;
-        case 0x1E: //LD E, d8
-            ld_8(oneByte(cpu), &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x1F: //RRA
-            rra(opcode, cpu);
-            break;
-        case 0x20: //JR NZ, r8
-            jr_c(!readFlag(ZF, cpu), oneByteSigned(cpu), opcode, cpu);
-            break;
-        case 0x21: //LD HL, d16
-            ld_16(twoBytes(cpu), &cpu->registers.HL, opcode, cpu);
-            break;
-        case 0x22: //LDI (HL), A
-            ldi_m(opcode, cpu);
-            break;
-        case 0x23: //INC HL
-            inc_16(&cpu->registers.HL, opcode, cpu);
-            break;
-        case 0x24: //INC H
-            inc_8(&cpu->registers.H, opcode, cpu);
-            break;
-        case 0x25: //DEC H
-            dec_8(&cpu->registers.H, opcode, cpu);
-            break;
-        case 0x26: //LD H, d8
-            ld_8(oneByte(cpu), &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x27: //DAA
-            daa(opcode, cpu);
-            break;
-        case 0x28: //JR Z,r8
-            jr_c(readFlag(ZF, cpu), oneByteSigned(cpu), opcode, cpu);
-            break;
-        case 0x29: //ADD HL, HL
-            add_16(cpu->registers.HL, &cpu->registers.HL, opcode, cpu);
-            break;
-        case 0x2A: //LDI A, (HL)
-            ldi(opcode, cpu);
-            break;
-        case 0x2B: //DEC HL
-            dec_16(&cpu->registers.HL, opcode, cpu);
-            break;
-        case 0x2C: //INC L
-            inc_8(&cpu->registers.L, opcode, cpu);
-            break;
-        case 0x2D: //DEC L
-            dec_8(&cpu->registers.L, opcode, cpu);
-            break;
-        case 0x2E: //LD L, d8
-            ld_8(oneByte(cpu), &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x2F: //CPL
-            cpl(opcode, cpu);
-            break;
-        case 0x30: //JR NC, r8
-            jr_c(!readFlag(CF, cpu), oneByteSigned(cpu), opcode, cpu);
-            break;
-        case 0x31: //LD SP, d16
-            ld_16(twoBytes(cpu), &cpu->SP, opcode, cpu);
-            break;
-        case 0x32: //LDD (HL), A
-            ldd_m(opcode, cpu);
-            break;
-        case 0x33: //INC SP
-            inc_16(&cpu->SP, opcode, cpu);
-            break;
-        case 0x34: //INC (HL)
-            inc_8_m(opcode, cpu);
-            break;
-        case 0x35: //DEC (HL)
-            dec_8_m(opcode, cpu);
-            break;
-        case 0x36: //LD (HL), d8
-            ld_8_m(oneByte(cpu), cpu->registers.HL, opcode, cpu);
-            break;
-        case 0x37: //SCF
-            scf(opcode, cpu);
-            break;
-        case 0x38: //JR C, r8
-            jr_c(readFlag(CF, cpu), oneByteSigned(cpu), opcode, cpu);
-            break;
-        case 0x39: //ADD HL, SP
-            add_16(cpu->SP, &cpu->registers.HL, opcode, cpu);
-            break;
-        case 0x3A: //LDD A, (HL)
-            ldd(opcode, cpu);
-            break;
-        case 0x3B: //DEC SP
-            dec_16(&cpu->SP, opcode, cpu);
-            break;
-        case 0x3C: //INC A
-            inc_8(&cpu->registers.A, opcode, cpu);
-            break;
-        case 0x3D: //DEC A
-            dec_8(&cpu->registers.A, opcode, cpu);
-            break;
-        case 0x3E: //LD A, d8
-            ld_8(oneByte(cpu), &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x3F: //CCF
-            ccf(opcode, cpu);
-            break;
-        case 0x40: //LD B, B
-            ld_8(cpu->registers.B, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x41: //LD B, C
-            ld_8(cpu->registers.C, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x42: //LD B, D
-            ld_8(cpu->registers.D, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x43: //LD B, E
-            ld_8(cpu->registers.E, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x44: //LD B, H
-            ld_8(cpu->registers.H, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x45: //LD B, L
-            ld_8(cpu->registers.L, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x46: //LD B, (HL)
-            ld_8(readByte(cpu->registers.HL, cpu), &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x47: //LD B, A
-            ld_8(cpu->registers.A, &cpu->registers.B, opcode, cpu);
-            break;
-        case 0x48: //LD C, B
-            ld_8(cpu->registers.B, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x49: //LD C, C
-            ld_8(cpu->registers.C, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x4A: //lD C, D
-            ld_8(cpu->registers.D, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x4B: //LD C, E
-            ld_8(cpu->registers.E, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x4C: //LD C, H
-            ld_8(cpu->registers.H, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x4D: //LD C, L
-            ld_8(cpu->registers.L, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x4E: //LD C, (HL)
-            ld_8(readByte(cpu->registers.HL, cpu), &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x4F: //LD C, A
-            ld_8(cpu->registers.A, &cpu->registers.C, opcode, cpu);
-            break;
-        case 0x50: //LD D, B
-            ld_8(cpu->registers.B, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x51: //LD D, C
-            ld_8(cpu->registers.C, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x52: //LD D, D
-            ld_8(cpu->registers.D, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x53: //LD D, E
-            ld_8(cpu->registers.E, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x54: //LD D, H
-            ld_8(cpu->registers.H, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x55: //LD D, L
-            ld_8(cpu->registers.L, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x56: //LD D, (HL)
-            ld_8(readByte(cpu->registers.HL, cpu), &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x57: //LD D, A
-            ld_8(cpu->registers.A, &cpu->registers.D, opcode, cpu);
-            break;
-        case 0x58: //LD E, B
-            ld_8(cpu->registers.B, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x59: //LD E, C
-            ld_8(cpu->registers.C, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x5A: //LD E, D
-            ld_8(cpu->registers.D, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x5B: //LD E, E
-            ld_8(cpu->registers.E, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x5C: //lD E, H
-            ld_8(cpu->registers.H, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x5D: //LD E, L
-            ld_8(cpu->registers.L, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x5E: //LD E, (HL)
-            ld_8(readByte(cpu->registers.HL, cpu), &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x5F: //LD E, A
-            ld_8(cpu->registers.A, &cpu->registers.E, opcode, cpu);
-            break;
-        case 0x60: //LD H, B
-            ld_8(cpu->registers.B, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x61: //LD H, C
-            ld_8(cpu->registers.C, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x62: //LD H, D
-            ld_8(cpu->registers.D, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x63: //LD H, E
-            ld_8(cpu->registers.E, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x64: //LD H, H
-            ld_8(cpu->registers.H, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x65: //LD H, L
-            ld_8(cpu->registers.L, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x66: //LD H, (HL)
-            ld_8(readByte(cpu->registers.HL, cpu), &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x67: //LD H, A
-            ld_8(cpu->registers.A, &cpu->registers.H, opcode, cpu);
-            break;
-        case 0x68: //LD L, B
-            ld_8(cpu->registers.B, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x69: //LD L, C
-            ld_8(cpu->registers.C, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x6A: //LD L, D
-            ld_8(cpu->registers.D, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x6B: //LD L, E
-            ld_8(cpu->registers.E, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x6C: //LD L, H
-            ld_8(cpu->registers.H, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x6D: //LD L, L
-            ld_8(cpu->registers.L, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x6E: //LD L, (HL)
-            ld_8(readByte(cpu->registers.HL, cpu), &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x6F: //LD L, A
-            ld_8(cpu->registers.A, &cpu->registers.L, opcode, cpu);
-            break;
-        case 0x70: //LD (HL), B
-            ld_8_m(cpu->registers.B, cpu->registers.HL, opcode, cpu);
-            break;
-        case 0x71: //LD (HL), C
-            ld_8_m(cpu->registers.C, cpu->registers.HL, opcode, cpu);
-            break;
-        case 0x72: //LD (HL), D
-            ld_8_m(cpu->registers.D, cpu->registers.HL, opcode, cpu);
-            break;
-        case 0x73: //LD (HL), E
-            ld_8_m(cpu->registers.E, cpu->registers.HL, opcode, cpu);
-            break;
-        case 0x74: //LD (HL), H
-            ld_8_m(cpu->registers.H, cpu->registers.HL, opcode, cpu);
-            break;
-        case 0x75: //LD (HL), L
-            ld_8_m(cpu->registers.L, cpu->registers.HL, opcode, cpu);
-            break;
-        case 0x76: //HALT
-            halt(opcode, cpu);
-            break;
-        case 0x77: //LD (HL), A
-            ld_8_m(cpu->registers.A, cpu->registers.HL, opcode, cpu);
-            break;
-        case 0x78: //LD A, B
-            ld_8(cpu->registers.B, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x79: //LD A, C
-            ld_8(cpu->registers.C, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x7A: //LD A, D
-            ld_8(cpu->registers.D, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x7B: //LD A, E
-            ld_8(cpu->registers.E, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x7C: //LD A, H
-            ld_8(cpu->registers.H, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x7D: //LD A, L
-            ld_8(cpu->registers.L, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x7E: //LD A, (HL)
-            ld_8(readByte(cpu->registers.HL, cpu), &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x7F: //LD A, A
-            ld_8(cpu->registers.A, &cpu->registers.A, opcode, cpu);
-            break;
-        case 0x80: //ADD B
-            add_8(cpu->registers.B, opcode, cpu);
-            break;
-        case 0x81: //ADD C
-            add_8(cpu->registers.C, opcode, cpu);
-            break;
-        case 0x82: //ADD D
-            add_8(cpu->registers.D, opcode, cpu);
-            break;
-        case 0x83: //ADD E
-            add_8(cpu->registers.E, opcode, cpu);
-            break;
-        case 0x84: //ADD H
-            add_8(cpu->registers.H, opcode, cpu);
-            break;
-        case 0x85: //ADD L
-            add_8(cpu->registers.L, opcode, cpu);
-            break;
-        case 0x86: //ADD (HL)
-            add_8(readByte(cpu->registers.HL, cpu), opcode, cpu);
-            break;
-        case 0x87: //ADD A
-            add_8(cpu->registers.A, opcode, cpu);
-            break;
-        case 0x88: //ADC B
-            adc(cpu->registers.B, opcode, cpu);
-            break;
-        case 0x89: //ADC C
-            adc(cpu->registers.C, opcode, cpu);
-            break;
-        case 0x8A: //ADC D
-            adc(cpu->registers.D, opcode, cpu);
-            break;
-        case 0x8B: //ADC E
-            adc(cpu->registers.E, opcode, cpu);
-            break;
-        case 0x8C: //ADC H
-            adc(cpu->registers.H, opcode, cpu);
-            break;
-        case 0x8D: //ADC L
-            adc(cpu->registers.L, opcode, cpu);
-            break;
-        case 0x8E: //ADC (HL)
-            adc(readByte(cpu->registers.HL, cpu), opcode, cpu);
-            break;
-        case 0x8F: //ADC A
-            adc(cpu->registers.A, opcode, cpu);
-            break;
-        case 0x90: //SUB B
-            sub_8(cpu->registers.B, opcode, cpu);
-            break;
-        case 0x91: //SUB C
-            sub_8(cpu->registers.C, opcode, cpu);
-            break;
-        case 0x92: //SUB D
-            sub_8(cpu->registers.D, opcode, cpu);
-            break;
-        case 0x93: //SUB E
-            sub_8(cpu->registers.E, opcode, cpu);
-            break;
-        case 0x94: //SUB H
-            sub_8(cpu->registers.H, opcode, cpu);
-            break;
-        case 0x95: //SUB L
-            sub_8(cpu->registers.L, opcode, cpu);
-            break;
-        case 0x96: //SUB (HL)
-            sub_8(readByte(cpu->registers.HL, cpu), opcode, cpu);
-            break;
-        case 0x97: //SUB A
-            sub_8(cpu->registers.A, opcode, cpu);
-            break;
-        case 0x98: //SBC B
-            sbc(cpu->registers.B, opcode, cpu);
-            break;
-        case 0x99: //SBC C
-            sbc(cpu->registers.C, opcode, cpu);
-            break;
-        case 0x9A: //SBC D
-            sbc(cpu->registers.D, opcode, cpu);
-            break;
-        case 0x9B: //SBC E
-            sbc(cpu->registers.E, opcode, cpu);
-            break;
-        case 0x9C: //SBC H
-            sbc(cpu->registers.H, opcode, cpu);
-            break;
-        case 0x9D: //SBC L
-            sbc(cpu->registers.L, opcode, cpu);
-            break;
-        case 0x9E: //SBC (HL)
-            sbc(readByte(cpu->registers.HL, cpu), opcode, cpu);
-            break;
-        case 0x9F: //SBC A
-            sbc(cpu->registers.A, opcode, cpu);
-            break;
-        case 0xA0: //AND B
-            and(cpu->registers.B, opcode, cpu);
-            break;
-        case 0xA1: //AND C
-            and(cpu->registers.C, opcode, cpu);
-            break;
-        case 0xA2: //AND D
-            and(cpu->registers.D, opcode, cpu);
-            break;
-        case 0xA3: //AND E
-            and(cpu->registers.E, opcode, cpu);
-            break;
-        case 0xA4: //AND H
-            and(cpu->registers.H, opcode, cpu);
-            break;
-        case 0xA5: //AND L
-            and(cpu->registers.L, opcode, cpu);
-            break;
-        case 0xA6: //AND (HL)
-            and(readByte(cpu->registers.HL, cpu), opcode, cpu);
-            break;
-        case 0xA7: //AND A
-            and(cpu->registers.A, opcode, cpu);
-            break;
-        case 0xA8: //XOR B
-            xor(cpu->registers.B, opcode, cpu);
-            break;
-        case 0xA9: //XOR C
-            xor(cpu->registers.C, opcode, cpu);
-            break;
-        case 0xAA: //XOR D
-            xor(cpu->registers.D, opcode, cpu);
-            break;
-        case 0xAB: //XOR E
-            xor(cpu->registers.E, opcode, cpu);
-            break;
-        case 0xAC: //XOR H
-            xor(cpu->registers.H, opcode, cpu);
-            break;
-        case 0xAD: //XOR L
-            xor(cpu->registers.L, opcode, cpu);
-            break;
-        case 0xAE: //XOR (HL)
-            xor(readByte(cpu->registers.HL, cpu), opcode, cpu);
-            break;
-        case 0xAF: //XOR A
-            xor(cpu->registers.A, opcode, cpu);
-            break;
-        case 0xB0: //OR B
-            or(cpu->registers.B, opcode, cpu);
-            break;
-        case 0xB1: //OR C
-            or(cpu->registers.C, opcode, cpu);
-            break;
-        case 0xB2: //OR D
-            or(cpu->registers.D, opcode, cpu);
-            break;
-        case 0xB3: //OR E
-            or(cpu->registers.E, opcode, cpu);
-            break;
-        case 0xB4: //OR H
-            or(cpu->registers.H, opcode, cpu);
-            break;
-        case 0xB5: //OR L
-            or(cpu->registers.L, opcode, cpu);
-            break;
-        case 0xB6: //OR (HL)
-            or(readByte(cpu->registers.HL, cpu), opcode, cpu);
-            break;
-        case 0xB7: //OR A
-            or(cpu->registers.A, opcode, cpu);
-            break;
-        case 0xB8: //CP B
-            cp(cpu->registers.B, opcode, cpu);
-            break;
-        case 0xB9: //CP C
-            cp(cpu->registers.C, opcode, cpu);
-            break;
-        case 0xBA: //CP D
-            cp(cpu->registers.D, opcode, cpu);
-            break;
-        case 0xBB: //CP E
-            cp(cpu->registers.E, opcode, cpu);
-            break;
-        case 0xBC: //CP H
-            cp(cpu->registers.H, opcode, cpu);
-            break;
-        case 0xBD: //CP L
-            cp(cpu->registers.L, opcode, cpu);
-            break;
-        case 0xBE: //CP (HL)
-            cp(readByte(cpu->registers.HL, cpu), opcode, cpu);
-            break;
-        case 0xBF: //CP A
-            cp(cpu->registers.A, opcode, cpu);
-            break;
-        case 0xC0: //RET NZ
-            ret_c(!readFlag(ZF, cpu), opcode, cpu);
-            break;
-        case 0xC1: //POP BC
-            pop(&cpu->registers.BC, false, opcode, cpu);
-            break;
-        case 0xC2: //JP NZ, a16
-            jp_c(!readFlag(ZF, cpu), twoBytes(cpu), opcode, cpu);
-            break;
-        case 0xC3: //JP a16
-            jp_c(true, twoBytes(cpu), opcode, cpu); //will always jump so set condition to be true
-            break;
-        case 0xC4: //CALL NZ, a16
-            call_c(!readFlag(ZF, cpu), twoBytes(cpu), opcode, cpu);
-            break;
-        case 0xC5: //PUSH BC
-            push(cpu->registers.BC, opcode, cpu);
-            break;
-        case 0xC6: //ADD A, d8
-            add_8(oneByte(cpu), opcode, cpu);
-            break;
-        case 0xC7: //RST 0x00
-            rst(0x00, opcode, cpu);
-            break;
-        case 0xC8: //RET Z
-            ret_c(readFlag(ZF, cpu), opcode, cpu);
-            break;
-        case 0xC9: //RET
-            ret_c(true, opcode, cpu); //will always return so set the condition to be true
-            break;
-        case 0xCA: //JP Z, a16
-            jp_c(readFlag(ZF, cpu), twoBytes(cpu), opcode, cpu);
-            break;
-        case 0xCB: //PREFIX CB
-            //return result of the cb prefix instruction
-            return executeNextExtendedInstruction(cpu);
-            break;
-        case 0xCC: //CALL Z, a16
-            call_c(readFlag(ZF, cpu), twoBytes(cpu), opcode, cpu);
-            break;
-        case 0xCD: //CALL a16
-            call_c(true, twoBytes(cpu), opcode, cpu);
-            break;
-        case 0xCE: //ADC d8
-            adc(oneByte(cpu), opcode, cpu);
-            break;
-        case 0xCF: //RST 0x08
-            rst(0x08, opcode, cpu);
-            break;
-        case 0xD0: //RET NC
-            ret_c(!readFlag(CF, cpu), opcode, cpu);
-            break;
-        case 0xD1: //POP DE
-            pop(&cpu->registers.DE, false, opcode, cpu);
-            break;
-        case 0xD2: //JP NC, a16
-            jp_c(!readFlag(CF, cpu), twoBytes(cpu), opcode, cpu);
-            break;
-        case 0xD4: //CALL NC, a16
-            call_c(!readFlag(CF, cpu), twoBytes(cpu), opcode, cpu);
-            break;
-        case 0xD5: //PUSH DE
-            push(cpu->registers.DE, opcode, cpu);
-            break;
-        case 0xD6: //SUB d8
-            sub_8(oneByte(cpu), opcode, cpu);
-            break;
-        case 0xD7: //RST 0x10
-            rst(0x10, opcode, cpu);
-            break;
-        case 0xD8: //RET C
-            ret_c(readFlag(CF, cpu), opcode, cpu);
-            break;
-        case 0xD9: //RETI
-            reti(opcode, cpu);
-            break;
-        case 0xDA: //JP C, a16
-            jp_c(readFlag(CF, cpu), twoBytes(cpu), opcode, cpu);
-            break;
-        case 0xDC: //CALL C, a16
-            call_c(readFlag(CF, cpu), twoBytes(cpu), opcode, cpu);
-            break;
-        case 0xDE: //SBC d8
-            sbc(oneByte(cpu), opcode, cpu);
-            break;
-        case 0xDF: //RST 0x18
-            rst(0x18, opcode, cpu);
-            break;
-        case 0xE0: //LDH (a8), A
-            ld_8_m(cpu->registers.A, 0xFF00 + oneByte(cpu), opcode, cpu);
-            break;
-        case 0xE1: //POP HL
-            pop(&cpu->registers.HL, false, opcode, cpu);
-            break;
-        case 0xE2: //LD (C), A
-            ld_8_m(cpu->registers.A, 0xFF00 + cpu->registers.C, opcode, cpu);
-            break;
-        case 0xE5: //PUSH HL
-            push(cpu->registers.HL, opcode, cpu);
-            break;
-        case 0xE6: //AND d8
-            and(readNextByte(cpu), opcode, cpu);
-            break;
-        case 0xE7: //RST 0x20
-            rst(0x20, opcode, cpu);
-            break;
-        case 0xE8: //ADD SP, r8
-            add_16_8((int8)readNextByte(cpu), cpu->SP, &cpu->SP, opcode, cpu);
-            break;
-        case 0xE9: //JP (HL) -> read as JP HL
-            jp_c(true, cpu->registers.HL, opcode, cpu);
-            break;
-        case 0xEA: //LD (a16), A
-            ld_8_m(cpu->registers.A, twoBytes(cpu), opcode, cpu);
-            break;
-        case 0xEE: //XOR d8
-            xor(oneByte(cpu), opcode, cpu);
-            break;
-        case 0xEF: //RST 0x28
-            rst(0x28, opcode, cpu);
-            break;
-        case 0xF0: //LDH A, (a8)
-            ld_8(readByte(0xFF00 + readNextByte(cpu), cpu), &cpu->registers.A, opcode, cpu);
-            break;
-        case 0xF1: //POP AF
-            pop(&cpu->registers.AF, true, opcode, cpu);
-            break;
-        case 0xF2: //LD A, (C)
-            ld_8(readByte(0xFF00 + cpu->registers.C, cpu), &cpu->registers.A, opcode, cpu);
-            break;
-        case 0xF3: //DI
-            di(opcode, cpu);
-            break;
-        case 0xF5: //PUSH AF
-            push(cpu->registers.AF, opcode, cpu);
-            break;
-        case 0xF6: //OR d8
-            or(oneByte(cpu), opcode, cpu);
-            break;
-        case 0xF7: //RST 0x30
-            rst(0x30, opcode, cpu);
-            break;
-        case 0xF8: //LD HL, SP+r8
-            add_16_8((int8)readNextByte(cpu), cpu->SP, &cpu->registers.HL, opcode, cpu);
-            break;
-        case 0xF9: //LD SP, HL
-            ld_16(cpu->registers.HL, &cpu->SP, opcode, cpu);
-            break;
-        case 0xFA: //LD A, (a16)
-            ld_8(readByte(twoBytes(cpu), cpu), &cpu->registers.A, opcode, cpu);
-            break;
-        case 0xFB: //EI
-            ei(opcode, cpu);
-            break;
-        case 0xFE: //CP d8
-            cp(oneByte(cpu), opcode, cpu);
-            break;
-        case 0xFF: //RST 0x38
-            rst(0x38, opcode, cpu);
-            break;
-        default: //instruction not implemented
-            printf("Error instruction not found: ");
-            printInstruction(false, cpu->PC - 1, cpu);
-            return 1;
-    }
+// NOP
+INSTRUCTION(op_00) {
+    cpu->wait = opcode_cycles[0x00];
     return 0;
 }
 
-const opcode opcodes[256];
+// LD BC, d16
+INSTRUCTION(op_01) {
+    ld_16(operand, &cpu->registers.BC, 0x01, cpu);
+    return 0;
+}
 
-// Return information about requested opcode
-opcode get_opcode(uint8 value) {
-    return opcodes[value];
+// LD (BC), A
+INSTRUCTION(op_02) {
+    ld_8_m(cpu->registers.A, cpu->registers.BC, 0x02, cpu);
+    return 0;
 }
 
-// Store format to printf each instruction, it's number of cycles, and how many bytes the instruction is in memory.
-const opcode opcodes[256] = {
-	{ "0x00 NOP", 4, 4, 1 },
-	{ "0x01 LD BC, 0x%04X", 12, 12, 3 },
-	{ "0x02 LD (BC), A", 8, 8, 1 },
-	{ "0x03 INC BC", 8, 8, 1 },
-	{ "0x04 INC B", 4, 4, 1 },
-	{ "0x05 DEC B", 4, 4, 1 },
-	{ "0x06 LD B, 0x%02" PRIX8, 8, 8, 2 },
-	{ "0x07 RLCA", 4, 4, 1 },
-	{ "0x08 LD (0x%04X), SP", 20, 20, 3 },
-	{ "0x09 ADD HL, BC", 8, 8, 1 },
-	{ "0x0A LD A, (BC)", 8, 8, 1 },
-	{ "0x0B DEC BC", 8, 8, 1 },
-	{ "0x0C INC C", 4, 4, 1 },
-	{ "0x0D DEC C", 4, 4, 1 },
-	{ "0x0E LD C, 0x%02" PRIX8, 8, 8, 2 },
-	{ "0x0F RRCA", 4, 4, 1 },
-	{ "0x10 STOP 0", 4, 4, 2 },
-	{ "0x11 LD DE, 0x%04X", 12, 12, 3 },
-	{ "0x12 LD (DE), A", 8, 8, 1 },
-	{ "0x13 INC DE", 8, 8, 1 },
-	{ "0x14 INC D", 4, 4, 1 },
-	{ "0x15 DEC D", 4, 4, 1 },
-	{ "0x16 LD D, 0x%02" PRIX8, 8, 8, 2 },
-	{ "0x17 RLA", 4, 4, 1 },
-	{ "0x18 JR 0x%02" PRIX8, 12, 12, 2 },
-	{ "0x19 ADD HL, DE", 8, 8, 1 },
-	{ "0x1A LD A, (DE)", 8, 8, 1 },
-	{ "0x1B DEC DE", 8, 8, 1 },
-	{ "0x1C INC E", 4, 4, 1 },
-	{ "0x1D DEC E", 4, 4, 1 },
-	{ "0x1E LD E, 0x%02" PRIX8, 8, 8, 2 },
-	{ "0x1F RRA", 4, 4, 1 },
-	{ "0x20 JR NZ, 0x%02" PRIX8, 8, 12, 2 },
-	{ "0x21 LD HL, 0x%04X", 12, 12, 3 },
-	{ "0x22 LDI (HL), A", 8, 8, 1 },
-	{ "0x23 INC HL", 8, 8, 1 },
-	{ "0x24 INC H", 4, 4, 1 },
-	{ "0x25 DEC H", 4, 4, 1 },
-	{ "0x26 LD H, 0x%02" PRIX8, 8, 8, 2 },
-	{ "0x27 DAA", 4, 4, 1 },
-	{ "0x28 JR Z, 0x%02" PRIX8, 8, 12, 2 },
-	{ "0x29 ADD HL, HL", 8, 8, 1 },
-	{ "0x2A LDI A, (HL)", 8, 8, 1 },
-	{ "0x2B DEC HL", 8, 8, 1 },
-	{ "0x2C INC L", 4, 4, 1 },
-	{ "0x2D DEC L", 4, 4, 1 },
-	{ "0x2E LD L, 0x%02" PRIX8, 8, 8, 2 },
-	{ "0x2F CPL", 4, 4, 1 },
-	{ "0x30 JR NC, 0x%02" PRIX8, 8, 12, 2},
-	{ "0x31 LD SP, 0x%04X", 12, 12, 3 },
-	{ "0x32 LDD (HL), A", 8, 8, 1 },
-	{ "0x33 INC SP", 8, 8, 1 },
-	{ "0x34 INC (HL)", 12, 12, 1 },
-	{ "0x35 DEC (HL)", 12, 12, 1 },
-	{ "0x36 LD (HL), 0x%02" PRIX8, 12, 12, 2 },
-    { "0x37 SCF", 4, 4, 1 },
-	{ "0x38 JR C, 0x%02" PRIX8, 8, 12, 2 },
-	{ "0x39 ADD HL, SP", 8, 8, 1 },
-	{ "0x3A LDD A, (HL)", 8, 8, 1 },
-	{ "0x3B DEC SP", 8, 8, 1 },
-	{ "0x3C INC A", 4, 4, 1 },
-	{ "0x3D DEC A", 4, 4, 1 },
-	{ "0x3E LD A, 0x%02" PRIX8, 8, 8, 2 },
-	{ "0x3F CCF", 4, 4, 1 },
-	{ "0x40 LD B, B", 4, 4, 1 },
-	{ "0x41 LD B, C", 4, 4, 1 },
-	{ "0x42 LD B, D", 4, 4, 1 },
-	{ "0x43 LD B, E", 4, 4, 1 },
-	{ "0x44 LD B, H", 4, 4, 1 },
-	{ "0x45 LD B, L", 4, 4, 1 },
-	{ "0x46 LD B, (HL)", 8, 8, 1 },
-	{ "0x47 LD B, A", 4, 4, 1 },
-	{ "0x48 LD C, B", 4, 4, 1 },
-	{ "0x49 LD C, C", 4, 4, 1 },
-	{ "0x4A LD C, D", 4, 4, 1 },
-	{ "0x4B LD C, E", 4, 4, 1 },
-	{ "0x4C LD C, H", 4, 4, 1 },
-	{ "0x4D LD C, L", 4, 4, 1 },
-	{ "0x4E LD C, (HL)", 8, 8, 1 },
-	{ "0x4F LD C, A", 4, 4, 1 },
-	{ "0x50 LD D, B", 4, 4, 1 },
-	{ "0x51 LD D, C", 4, 4, 1 },
-	{ "0x52 LD D, D", 4, 4, 1 },
-	{ "0x53 LD D, E", 4, 4, 1 },
-	{ "0x54 LD D, H", 4, 4, 1 },
-	{ "0x55 LD D, L", 4, 4, 1 },
-	{ "0x56 LD D, (HL)", 8, 8, 1 },
-	{ "0x57 LD D, A", 4, 4, 1 },
-	{ "0x58 LD E, B", 4, 4, 1 },
-	{ "0x59 LD E, C", 4, 4, 1 },
-	{ "0x5A LD E, D", 4, 4, 1 },
-	{ "0x5B LD E, E", 4, 4, 1 },
-	{ "0x5C LD E, H", 4, 4, 1 },
-	{ "0x5D LD E, L", 4, 4, 1 },
-	{ "0x5E LD E, (HL)", 8, 8, 1 },
-	{ "0x5F LD E, A", 4, 4, 1 },
-	{ "0x60 LD H, B", 4, 4, 1 },
-	{ "0x61 LD H, C", 4, 4, 1 },
-	{ "0x62 LD H, D", 4, 4, 1 },
-	{ "0x63 LD H, E", 4, 4, 1 },
-	{ "0x64 LD H, H", 4, 4, 1 },
-	{ "0x65 LD H, L", 4, 4, 1 },
-	{ "0x66 LD H, (HL)", 8, 8, 1 },
-    { "0x67 LD H, A", 4, 4, 1 },
-	{ "0x68 LD L, B", 4, 4, 1 },
-	{ "0x69 LD L, C", 4, 4, 1 },
-	{ "0x6A LD L, D", 4, 4, 1 },
-	{ "0x6B LD L, E", 4, 4, 1 },
-	{ "0x6C LD L, H", 4, 4, 1 },
-	{ "0x6D LD L, L", 4, 4, 1 },
-	{ "0x6E LD L, (HL)", 8, 8, 1 },
-	{ "0x6F LD L, A", 4, 4, 1 },
-	{ "0x70 LD (HL), B", 8, 8, 1 },
-	{ "0x71 LD (HL), C", 8, 8, 1 },
-	{ "0x72 LD (HL), D", 8, 8, 1 },
-	{ "0x73 LD (HL), E", 8, 8, 1 },
-	{ "0x74 LD (HL), H", 8, 8, 1 },
-	{ "0x75 LD (HL), L", 8, 8, 1 },
-	{ "0x76 HALT", 4, 4, 1 },
-	{ "0x77 LD (HL), A", 8, 8, 1 },
-	{ "0x78 LD A, B", 4, 4, 1 },
-	{ "0x79 LD A, C", 4, 4, 1 },
-	{ "0x7A LD A, D", 4, 4, 1 },
-	{ "0x7B LD A, E", 4, 4, 1 },
-	{ "0x7C LD A, H", 4, 4, 1 },
-	{ "0x7D LD A, L", 4, 4, 1 },
-	{ "0x7E LD A, (HL)", 8, 8, 1 },
-	{ "0x7F LD A, A", 4, 4, 1 },
-	{ "0x80 ADD A, B", 4, 4, 1 },
-	{ "0x81 ADD A, C", 4, 4, 1 },
-	{ "0x82 ADD A, D", 4, 4, 1 },
-	{ "0x83 ADD A, E", 4, 4, 1 },
-	{ "0x84 ADD A, H", 4, 4, 1 },
-	{ "0x85 ADD A, L", 4, 4, 1 },
-	{ "0x86 ADD A, (HL)", 8, 8, 1 },
-	{ "0x87 ADD A", 4, 4, 1 },
-	{ "0x88 ADC B", 4, 4, 1 },
-	{ "0x89 ADC C", 4, 4, 1 },
-	{ "0x8A ADC D", 4, 4, 1 },
-	{ "0x8B ADC E", 4, 4, 1 },
-	{ "0x8C ADC H", 4, 4, 1 },
-	{ "0x8D ADC L", 4, 4, 1 },
-	{ "0x8E ADC (HL)", 8, 8, 1 },
-	{ "0x8F ADC A", 4, 4, 1 },
-	{ "0x90 SUB B", 4, 4, 1 },
-	{ "0x91 SUB C", 4, 4, 1 },
-	{ "0x92 SUB D", 4, 4, 1 },
-	{ "0x93 SUB E", 4, 4, 1 },
-	{ "0x94 SUB H", 4, 4, 1 },
-	{ "0x95 SUB L", 4, 4, 1 },
-	{ "0x96 SUB (HL)", 8, 8, 1 },
-	{ "0x97 SUB A", 4, 4, 1 },
-	{ "0x98 SBC B", 4, 4, 1 },
-	{ "0x99 SBC C", 4, 4, 1 },
-	{ "0x9A SBC D", 4, 4, 1 },
-	{ "0x9B SBC E", 4, 4, 1 },
-	{ "0x9C SBC H", 4, 4, 1 },
-	{ "0x9D SBC L", 4, 4, 1 },
-	{ "0x9E SBC (HL)", 8, 8, 1 },
-	{ "0x9F SBC A", 4, 4, 1 },
-	{ "0xA0 AND B", 4, 4, 1 },
-	{ "0xA1 AND C", 4, 4, 1 },
-	{ "0xA2 AND D", 4, 4, 1 },
-	{ "0xA3 AND E", 4, 4, 1 },
-	{ "0xA4 AND H", 4, 4, 1 },
-	{ "0xA5 AND L", 4, 4, 1 },
-	{ "0xA6 AND (HL)", 8, 8, 1 },
-	{ "0xA7 AND A", 4, 4, 1 },
-	{ "0xA8 XOR B", 4, 4, 1 },
-	{ "0xA9 XOR C", 4, 4, 1 },
-	{ "0xAA XOR D", 4, 4, 1 },
-	{ "0xAB XOR E", 4, 4, 1 },
-	{ "0xAC XOR H", 4, 4, 1 },
-	{ "0xAD XOR L", 4, 4, 1 },
-	{ "0xAE XOR (HL)", 8, 8, 1 },
-	{ "0xAF XOR A", 4, 4, 1 },
-	{ "0xB0 OR B", 4, 4, 1 },
-	{ "0xB1 OR C", 4, 4, 1 },
-	{ "0xB2 OR D", 4, 4, 1 },
-	{ "0xB3 OR E", 4, 4, 1 },
-	{ "0xB4 OR H", 4, 4, 1 },
-	{ "0xB5 OR L", 4, 4, 1 },
-	{ "0xB6 OR (HL)", 8, 8, 1 },
-	{ "0xB7 OR A", 4, 4, 1 },
-	{ "0xB8 CP B", 4, 4, 1 },
-	{ "0xB9 CP C", 4, 4, 1 },
-	{ "0xBA CP D", 4, 4, 1 },
-	{ "0xBB CP E", 4, 4, 1 },
-	{ "0xBC CP H", 4, 4, 1 },
-	{ "0xBD CP L", 4, 4, 1 },
-	{ "0xBE CP (HL)", 8, 8, 1 },
-	{ "0xBF CP A", 4, 4, 1 },
-	{ "0xC0 RET NZ", 8, 20, 1 },
-	{ "0xC1 POP BC", 12, 12, 1 },
-	{ "0xC2 JP NZ, 0x%04X", 12, 16, 3 },
-	{ "0xC3 JP 0x%04X", 16, 16, 3 },
-	{ "0xC4 CALL NZ, 0x%04X", 12, 24, 3 },
-	{ "0xC5 PUSH BC", 16, 16, 1 },
-	{ "0xC6 ADD A, 0x%02" PRIX8, 8, 8, 2 },
-	{ "0xC7 RST 0x00", 16, 16, 1 },
-	{ "0xC8 RET Z", 8, 20, 1 },
-	{ "0xC9 RET", 16, 16, 1 },
-	{ "0xCA JP Z, 0x%04X", 12, 16, 3 },
-	{ "0xCB PREFIX CB", 4, 4, 1 },
-	{ "0xCC CALL Z, 0x%04X", 12, 24, 3 },
-	{ "0xCD CALL 0x%04X", 24, 24, 3 },
-	{ "0xCE ADC 0x%02" PRIX8, 8, 8, 2 },
-	{ "0xCF RST 0x08", 16, 16, 1 },
-	{ "0xD0 RET NC", 8, 20, 1 },
-	{ "0xD1 POP DE", 12, 12, 1 },
-	{ "0xD2 JP NC, 0x%04X", 12, 16, 3 },
-	{ "0xD3 NONE", 0, 0, 1 },
-	{ "0xD4 CALL NC, 0x%04X", 12, 24, 3 },
-	{ "0xD5 PUSH DE", 16, 16, 1 },
-	{ "0xD6 SUB 0x%02" PRIX8, 8, 8, 2 },
-	{ "0xD7 RST 0x10", 16, 16, 1 },
-	{ "0xD8 RET C", 8, 20, 1 },
-	{ "0xD9 RETI", 16, 16, 1 },
-	{ "0xDA JP C, 0x%04X", 12, 16, 3 },
-	{ "0xDB NONE", 0, 0, 1 },
-	{ "0xDC CALL C, 0x%04X", 12, 24, 3 },
-	{ "0xDD NONE", 0, 0, 1 },
-	{ "0xDE SBC 0x%02" PRIX8, 8, 8, 2 },
-	{ "0xDF RST 0x18", 16, 16, 1 },
-	{ "0xE0 LDH (0x%02" PRIX8 "), A", 12, 12, 2 },
-	{ "0xE1 POP HL", 12, 12, 1 },
-	{ "0xE2 LD (C), A", 8, 8, 2 },
-	{ "0xE3 NONE", 0, 0, 1 },
-	{ "0xE4 NONE", 0, 0, 1 },
-	{ "0xE5 PUSH HL", 16, 16, 1 },
-	{ "0xE6 AND 0x%02" PRIX8, 8, 8, 2 },
-	{ "0xE7 RST 0x20", 16, 16, 1 },
-	{ "0xE8 ADD SP, 0x%02" PRIX8, 16, 16, 2 },
-	{ "0xE9 JP (HL)", 4, 4, 1 },
-	{ "0xEA LD (0x%02" PRIX8 "), A", 16, 16, 3 },
-	{ "0xEB NONE", 0, 0, 1 },
-	{ "0xEC NONE", 0, 0, 1 },
-	{ "0xED NONE", 0, 0, 1 },
-	{ "0xEE XOR 0x%02" PRIX8, 8, 8, 2 },
-	{ "0xEF RST 0x28", 16, 16, 1 },
-	{ "0xF0 LDH A, (0x%02" PRIX8 ")", 12, 12, 2 },
-	{ "0xF1 POP AF", 12, 12, 1 },
-	{ "0xF2 LD A, (C)", 8, 8, 2 },
-	{ "0xF3 DI", 4, 4, 1 },
-	{ "0xF4 NONE", 0, 0, 1 },
-	{ "0xF5 PUSH AF", 16, 16, 1 },
-	{ "0xF6 OR 0x%02" PRIX8, 8, 8, 2 },
-	{ "0xF7 RST 0x30", 16, 16, 1 },
-	{ "0xF8 LD HL, SP+0x%02" PRIX8, 12, 12, 2 },
-	{ "0xF9 LD SP, HL", 8, 8, 1 },
-	{ "0xFA LD A, (0x%04X)", 16, 16, 3 },
-	{ "0xFB EI", 4, 4, 1 },
-	{ "0xFC NONE", 0, 0, 1 },
-	{ "0xFD NONE", 0, 0, 1 },
-	{ "0xFE CP 0x%02" PRIX8, 8, 8, 2 },
-	{ "0xFF RST 0x38", 16, 16, 1 },
+// INC BC
+INSTRUCTION(op_03) {
+    inc_16(&cpu->registers.BC, 0x03, cpu);
+    return 0;
+}
+
+// INC B
+INSTRUCTION(op_04) {
+    inc_8(&cpu->registers.B, 0x04, cpu);
+    return 0;
+}
+
+// DEC B
+INSTRUCTION(op_05) {
+    dec_8(&cpu->registers.B, 0x05, cpu);
+    return 0;
+}
+
+// LD B, d8
+INSTRUCTION(op_06) {
+    ld_8((uint8) operand, &cpu->registers.B, 0x06, cpu);
+    return 0;
+}
+
+// RLCA
+INSTRUCTION(op_07) {
+    rlca(0x07, cpu);
+    return 0;
+}
+
+// LD (a16), SP
+INSTRUCTION(op_08) {
+    ld_16_m(cpu->SP, operand, 0x08, cpu);
+    return 0;
+}
+
+// ADD HL, BC
+INSTRUCTION(op_09) {
+    add_16(cpu->registers.BC, &cpu->registers.HL, 0x09, cpu);
+    return 0;
+}
+
+// LD A, (BC)
+INSTRUCTION(op_0A) {
+    ld_8(readByte(cpu->registers.BC, cpu), &cpu->registers.A, 0x0A, cpu);
+    return 0;
+}
+
+// DEC BC
+INSTRUCTION(op_0B) {
+    dec_16(&cpu->registers.BC, 0x0B, cpu);
+    return 0;
+}
+
+// INC C
+INSTRUCTION(op_0C) {
+    inc_8(&cpu->registers.C, 0x0C, cpu);
+    return 0;
+}
+
+// DEC C
+INSTRUCTION(op_0D) {
+    dec_8(&cpu->registers.C, 0x0D, cpu);
+    return 0;
+}
+
+// LD C, d8
+INSTRUCTION(op_0E) {
+    ld_8((uint8) operand, &cpu->registers.C, 0x0E, cpu);
+    return 0;
+}
+
+// RRCA
+INSTRUCTION(op_0F) {
+    rrca(0x0F, cpu);
+    return 0;
+}
+
+// LD DE, d16
+INSTRUCTION(op_11) {
+    ld_16(operand, &cpu->registers.DE, 0x11, cpu);
+    return 0;
+}
+
+// LD (DE), A
+INSTRUCTION(op_12) {
+    ld_8_m(cpu->registers.A, cpu->registers.DE, 0x12, cpu);
+    return 0;
+}
+
+// INC DE
+INSTRUCTION(op_13) {
+    inc_16(&cpu->registers.DE, 0x13, cpu);
+    return 0;
+}
+
+// INC D
+INSTRUCTION(op_14) {
+    inc_8(&cpu->registers.D, 0x14, cpu);
+    return 0;
+}
+
+// DEC D
+INSTRUCTION(op_15) {
+    dec_8(&cpu->registers.D, 0x15, cpu);
+    return 0;
+}
+
+// LD D, d8
+INSTRUCTION(op_16) {
+    ld_8((uint8) operand, &cpu->registers.D, 0x16, cpu);
+    return 0;
+}
+
+// RLA
+INSTRUCTION(op_17) {
+    rla(0x17, cpu);
+    return 0;
+}
+
+// JR r8
+INSTRUCTION(op_18) {
+    jr_c(true, (int8) operand, 0x18, cpu);
+    return 0;
+}
+
+// ADD HL, DE
+INSTRUCTION(op_19) {
+    add_16(cpu->registers.DE, &cpu->registers.HL, 0x19, cpu);
+    return 0;
+}
+
+// LD A, (DE)
+INSTRUCTION(op_1A) {
+    ld_8(readByte(cpu->registers.DE, cpu), &cpu->registers.A, 0x1A, cpu);
+    return 0;
+}
+
+// DEC DE
+INSTRUCTION(op_1B) {
+    dec_16(&cpu->registers.DE, 0x1B, cpu);
+    return 0;
+}
+
+// INC E
+INSTRUCTION(op_1C) {
+    inc_8(&cpu->registers.E, 0x1C, cpu);
+    return 0;
+}
+
+// DEC E
+INSTRUCTION(op_1D) {
+    dec_8(&cpu->registers.E, 0x1D, cpu);
+    return 0;
+}
+
+// LD E, d8
+INSTRUCTION(op_1E) {
+    ld_8((uint8) operand, &cpu->registers.E, 0x1E, cpu);
+    return 0;
+}
+
+// RRA
+INSTRUCTION(op_1F) {
+    rra(0x1F, cpu);
+    return 0;
+}
+
+// JR NZ, r8
+INSTRUCTION(op_20) {
+    jr_c(!readFlag(ZF, cpu), (int8) operand, 0x20, cpu);
+    return 0;
+}
+
+// LD HL, d16
+INSTRUCTION(op_21) {
+    ld_16(operand, &cpu->registers.HL, 0x21, cpu);
+    return 0;
+}
+
+// LDI (HL), A
+INSTRUCTION(op_22) {
+    ldi_m(0x22, cpu);
+    return 0;
+}
+
+// INC HL
+INSTRUCTION(op_23) {
+    inc_16(&cpu->registers.HL, 0x23, cpu);
+    return 0;
+}
+
+// INC H
+INSTRUCTION(op_24) {
+    inc_8(&cpu->registers.H, 0x24, cpu);
+    return 0;
+}
+
+// DEC H
+INSTRUCTION(op_25) {
+    dec_8(&cpu->registers.H, 0x25, cpu);
+    return 0;
+}
+
+// LD H, d8
+INSTRUCTION(op_26) {
+    ld_8((uint8) operand, &cpu->registers.H, 0x26, cpu);
+    return 0;
+}
+
+// DAA
+INSTRUCTION(op_27) {
+    daa(0x27, cpu);
+    return 0;
+}
+
+// JR Z,r8
+INSTRUCTION(op_28) {
+    jr_c(readFlag(ZF, cpu), (int8) operand, 0x28, cpu);
+    return 0;
+}
+
+// ADD HL, HL
+INSTRUCTION(op_29) {
+    add_16(cpu->registers.HL, &cpu->registers.HL, 0x29, cpu);
+    return 0;
+}
+
+// LDI A, (HL)
+INSTRUCTION(op_2A) {
+    ldi(0x2A, cpu);
+    return 0;
+}
+
+// DEC HL
+INSTRUCTION(op_2B) {
+    dec_16(&cpu->registers.HL, 0x2B, cpu);
+    return 0;
+}
+
+// INC L
+INSTRUCTION(op_2C) {
+    inc_8(&cpu->registers.L, 0x2C, cpu);
+    return 0;
+}
+
+// DEC L
+INSTRUCTION(op_2D) {
+    dec_8(&cpu->registers.L, 0x2D, cpu);
+    return 0;
+}
+
+// LD L, d8
+INSTRUCTION(op_2E) {
+    ld_8((uint8) operand, &cpu->registers.L, 0x2E, cpu);
+    return 0;
+}
+
+// CPL
+INSTRUCTION(op_2F) {
+    cpl(0x2F, cpu);
+    return 0;
+}
+
+// JR NC, r8
+INSTRUCTION(op_30) {
+    jr_c(!readFlag(CF, cpu), (int8) operand, 0x30, cpu);
+    return 0;
+}
+
+// LD SP, d16
+INSTRUCTION(op_31) {
+    ld_16(operand, &cpu->SP, 0x31, cpu);
+    return 0;
+}
+
+// LDD (HL), A
+INSTRUCTION(op_32) {
+    ldd_m(0x32, cpu);
+    return 0;
+}
+
+// INC SP
+INSTRUCTION(op_33) {
+    inc_16(&cpu->SP, 0x33, cpu);
+    return 0;
+}
+
+// INC (HL)
+INSTRUCTION(op_34) {
+    inc_8_m(0x34, cpu);
+    return 0;
+}
+
+// DEC (HL)
+INSTRUCTION(op_35) {
+    dec_8_m(0x35, cpu);
+    return 0;
+}
+
+// LD (HL), d8
+INSTRUCTION(op_36) {
+    ld_8_m((uint8) operand, cpu->registers.HL, 0x36, cpu);
+    return 0;
+}
+
+// SCF
+INSTRUCTION(op_37) {
+    scf(0x37, cpu);
+    return 0;
+}
+
+// JR C, r8
+INSTRUCTION(op_38) {
+    jr_c(readFlag(CF, cpu), (int8) operand, 0x38, cpu);
+    return 0;
+}
+
+// ADD HL, SP
+INSTRUCTION(op_39) {
+    add_16(cpu->SP, &cpu->registers.HL, 0x39, cpu);
+    return 0;
+}
+
+// LDD A, (HL)
+INSTRUCTION(op_3A) {
+    ldd(0x3A, cpu);
+    return 0;
+}
+
+// DEC SP
+INSTRUCTION(op_3B) {
+    dec_16(&cpu->SP, 0x3B, cpu);
+    return 0;
+}
+
+// INC A
+INSTRUCTION(op_3C) {
+    inc_8(&cpu->registers.A, 0x3C, cpu);
+    return 0;
+}
+
+// DEC A
+INSTRUCTION(op_3D) {
+    dec_8(&cpu->registers.A, 0x3D, cpu);
+    return 0;
+}
+
+// LD A, d8
+INSTRUCTION(op_3E) {
+    ld_8((uint8) operand, &cpu->registers.A, 0x3E, cpu);
+    return 0;
+}
+
+// CCF
+INSTRUCTION(op_3F) {
+    ccf(0x3F, cpu);
+    return 0;
+}
+
+// LD B, B
+INSTRUCTION(op_40) {
+    ld_8(cpu->registers.B, &cpu->registers.B, 0x40, cpu);
+    return 0;
+}
+
+// LD B, C
+INSTRUCTION(op_41) {
+    ld_8(cpu->registers.C, &cpu->registers.B, 0x41, cpu);
+    return 0;
+}
+
+// LD B, D
+INSTRUCTION(op_42) {
+    ld_8(cpu->registers.D, &cpu->registers.B, 0x42, cpu);
+    return 0;
+}
+
+// LD B, E
+INSTRUCTION(op_43) {
+    ld_8(cpu->registers.E, &cpu->registers.B, 0x43, cpu);
+    return 0;
+}
+
+// LD B, H
+INSTRUCTION(op_44) {
+    ld_8(cpu->registers.H, &cpu->registers.B, 0x44, cpu);
+    return 0;
+}
+
+// LD B, L
+INSTRUCTION(op_45) {
+    ld_8(cpu->registers.L, &cpu->registers.B, 0x45, cpu);
+    return 0;
+}
+
+// LD B, (HL)
+INSTRUCTION(op_46) {
+    ld_8(readByte(cpu->registers.HL, cpu), &cpu->registers.B, 0x46, cpu);
+    return 0;
+}
+
+// LD B, A
+INSTRUCTION(op_47) {
+    ld_8(cpu->registers.A, &cpu->registers.B, 0x47, cpu);
+    return 0;
+}
+
+// LD C, B
+INSTRUCTION(op_48) {
+    ld_8(cpu->registers.B, &cpu->registers.C, 0x48, cpu);
+    return 0;
+}
+
+// LD C, C
+INSTRUCTION(op_49) {
+    ld_8(cpu->registers.C, &cpu->registers.C, 0x49, cpu);
+    return 0;
+}
+
+// lD C, D
+INSTRUCTION(op_4A) {
+    ld_8(cpu->registers.D, &cpu->registers.C, 0x4A, cpu);
+    return 0;
+}
+
+// LD C, E
+INSTRUCTION(op_4B) {
+    ld_8(cpu->registers.E, &cpu->registers.C, 0x4B, cpu);
+    return 0;
+}
+
+// LD C, H
+INSTRUCTION(op_4C) {
+    ld_8(cpu->registers.H, &cpu->registers.C, 0x4C, cpu);
+    return 0;
+}
+
+// LD C, L
+INSTRUCTION(op_4D) {
+    ld_8(cpu->registers.L, &cpu->registers.C, 0x4D, cpu);
+    return 0;
+}
+
+// LD C, (HL)
+INSTRUCTION(op_4E) {
+    ld_8(readByte(cpu->registers.HL, cpu), &cpu->registers.C, 0x4E, cpu);
+    return 0;
+}
+
+// LD C, A
+INSTRUCTION(op_4F) {
+    ld_8(cpu->registers.A, &cpu->registers.C, 0x4F, cpu);
+    return 0;
+}
+
+// LD D, B
+INSTRUCTION(op_50) {
+    ld_8(cpu->registers.B, &cpu->registers.D, 0x50, cpu);
+    return 0;
+}
+
+// LD D, C
+INSTRUCTION(op_51) {
+    ld_8(cpu->registers.C, &cpu->registers.D, 0x51, cpu);
+    return 0;
+}
+
+// LD D, D
+INSTRUCTION(op_52) {
+    ld_8(cpu->registers.D, &cpu->registers.D, 0x52, cpu);
+    return 0;
+}
+
+// LD D, E
+INSTRUCTION(op_53) {
+    ld_8(cpu->registers.E, &cpu->registers.D, 0x53, cpu);
+    return 0;
+}
+
+// LD D, H
+INSTRUCTION(op_54) {
+    ld_8(cpu->registers.H, &cpu->registers.D, 0x54, cpu);
+    return 0;
+}
+
+// LD D, L
+INSTRUCTION(op_55) {
+    ld_8(cpu->registers.L, &cpu->registers.D, 0x55, cpu);
+    return 0;
+}
+
+// LD D, (HL)
+INSTRUCTION(op_56) {
+    ld_8(readByte(cpu->registers.HL, cpu), &cpu->registers.D, 0x56, cpu);
+    return 0;
+}
+
+// LD D, A
+INSTRUCTION(op_57) {
+    ld_8(cpu->registers.A, &cpu->registers.D, 0x57, cpu);
+    return 0;
+}
+
+// LD E, B
+INSTRUCTION(op_58) {
+    ld_8(cpu->registers.B, &cpu->registers.E, 0x58, cpu);
+    return 0;
+}
+
+// LD E, C
+INSTRUCTION(op_59) {
+    ld_8(cpu->registers.C, &cpu->registers.E, 0x59, cpu);
+    return 0;
+}
+
+// LD E, D
+INSTRUCTION(op_5A) {
+    ld_8(cpu->registers.D, &cpu->registers.E, 0x5A, cpu);
+    return 0;
+}
+
+// LD E, E
+INSTRUCTION(op_5B) {
+    ld_8(cpu->registers.E, &cpu->registers.E, 0x5B, cpu);
+    return 0;
+}
+
+// lD E, H
+INSTRUCTION(op_5C) {
+    ld_8(cpu->registers.H, &cpu->registers.E, 0x5C, cpu);
+    return 0;
+}
+
+// LD E, L
+INSTRUCTION(op_5D) {
+    ld_8(cpu->registers.L, &cpu->registers.E, 0x5D, cpu);
+    return 0;
+}
+
+// LD E, (HL)
+INSTRUCTION(op_5E) {
+    ld_8(readByte(cpu->registers.HL, cpu), &cpu->registers.E, 0x5E, cpu);
+    return 0;
+}
+
+// LD E, A
+INSTRUCTION(op_5F) {
+    ld_8(cpu->registers.A, &cpu->registers.E, 0x5F, cpu);
+    return 0;
+}
+
+// LD H, B
+INSTRUCTION(op_60) {
+    ld_8(cpu->registers.B, &cpu->registers.H, 0x60, cpu);
+    return 0;
+}
+
+// LD H, C
+INSTRUCTION(op_61) {
+    ld_8(cpu->registers.C, &cpu->registers.H, 0x61, cpu);
+    return 0;
+}
+
+// LD H, D
+INSTRUCTION(op_62) {
+    ld_8(cpu->registers.D, &cpu->registers.H, 0x62, cpu);
+    return 0;
+}
+
+// LD H, E
+INSTRUCTION(op_63) {
+    ld_8(cpu->registers.E, &cpu->registers.H, 0x63, cpu);
+    return 0;
+}
+
+// LD H, H
+INSTRUCTION(op_64) {
+    ld_8(cpu->registers.H, &cpu->registers.H, 0x64, cpu);
+    return 0;
+}
+
+// LD H, L
+INSTRUCTION(op_65) {
+    ld_8(cpu->registers.L, &cpu->registers.H, 0x65, cpu);
+    return 0;
+}
+
+// LD H, (HL)
+INSTRUCTION(op_66) {
+    ld_8(readByte(cpu->registers.HL, cpu), &cpu->registers.H, 0x66, cpu);
+    return 0;
+}
+
+// LD H, A
+INSTRUCTION(op_67) {
+    ld_8(cpu->registers.A, &cpu->registers.H, 0x67, cpu);
+    return 0;
+}
+
+// LD L, B
+INSTRUCTION(op_68) {
+    ld_8(cpu->registers.B, &cpu->registers.L, 0x68, cpu);
+    return 0;
+}
+
+// LD L, C
+INSTRUCTION(op_69) {
+    ld_8(cpu->registers.C, &cpu->registers.L, 0x69, cpu);
+    return 0;
+}
+
+// LD L, D
+INSTRUCTION(op_6A) {
+    ld_8(cpu->registers.D, &cpu->registers.L, 0x6A, cpu);
+    return 0;
+}
+
+// LD L, E
+INSTRUCTION(op_6B) {
+    ld_8(cpu->registers.E, &cpu->registers.L, 0x6B, cpu);
+    return 0;
+}
+
+// LD L, H
+INSTRUCTION(op_6C) {
+    ld_8(cpu->registers.H, &cpu->registers.L, 0x6C, cpu);
+    return 0;
+}
+
+// LD L, L
+INSTRUCTION(op_6D) {
+    ld_8(cpu->registers.L, &cpu->registers.L, 0x6D, cpu);
+    return 0;
+}
+
+// LD L, (HL)
+INSTRUCTION(op_6E) {
+    ld_8(readByte(cpu->registers.HL, cpu), &cpu->registers.L, 0x6E, cpu);
+    return 0;
+}
+
+// LD L, A
+INSTRUCTION(op_6F) {
+    ld_8(cpu->registers.A, &cpu->registers.L, 0x6F, cpu);
+    return 0;
+}
+
+// LD (HL), B
+INSTRUCTION(op_70) {
+    ld_8_m(cpu->registers.B, cpu->registers.HL, 0x70, cpu);
+    return 0;
+}
+
+// LD (HL), C
+INSTRUCTION(op_71) {
+    ld_8_m(cpu->registers.C, cpu->registers.HL, 0x71, cpu);
+    return 0;
+}
+
+// LD (HL), D
+INSTRUCTION(op_72) {
+    ld_8_m(cpu->registers.D, cpu->registers.HL, 0x72, cpu);
+    return 0;
+}
+
+// LD (HL), E
+INSTRUCTION(op_73) {
+    ld_8_m(cpu->registers.E, cpu->registers.HL, 0x73, cpu);
+    return 0;
+}
+
+// LD (HL), H
+INSTRUCTION(op_74) {
+    ld_8_m(cpu->registers.H, cpu->registers.HL, 0x74, cpu);
+    return 0;
+}
+
+// LD (HL), L
+INSTRUCTION(op_75) {
+    ld_8_m(cpu->registers.L, cpu->registers.HL, 0x75, cpu);
+    return 0;
+}
+
+// HALT
+INSTRUCTION(op_76) {
+    halt(0x76, cpu);
+    return 0;
+}
+
+// LD (HL), A
+INSTRUCTION(op_77) {
+    ld_8_m(cpu->registers.A, cpu->registers.HL, 0x77, cpu);
+    return 0;
+}
+
+// LD A, B
+INSTRUCTION(op_78) {
+    ld_8(cpu->registers.B, &cpu->registers.A, 0x78, cpu);
+    return 0;
+}
+
+// LD A, C
+INSTRUCTION(op_79) {
+    ld_8(cpu->registers.C, &cpu->registers.A, 0x79, cpu);
+    return 0;
+}
+
+// LD A, D
+INSTRUCTION(op_7A) {
+    ld_8(cpu->registers.D, &cpu->registers.A, 0x7A, cpu);
+    return 0;
+}
+
+// LD A, E
+INSTRUCTION(op_7B) {
+    ld_8(cpu->registers.E, &cpu->registers.A, 0x7B, cpu);
+    return 0;
+}
+
+// LD A, H
+INSTRUCTION(op_7C) {
+    ld_8(cpu->registers.H, &cpu->registers.A, 0x7C, cpu);
+    return 0;
+}
+
+// LD A, L
+INSTRUCTION(op_7D) {
+    ld_8(cpu->registers.L, &cpu->registers.A, 0x7D, cpu);
+    return 0;
+}
+
+// LD A, (HL)
+INSTRUCTION(op_7E) {
+    ld_8(readByte(cpu->registers.HL, cpu), &cpu->registers.A, 0x7E, cpu);
+    return 0;
+}
+
+// LD A, A
+INSTRUCTION(op_7F) {
+    ld_8(cpu->registers.A, &cpu->registers.A, 0x7F, cpu);
+    return 0;
+}
+
+// ADD B
+INSTRUCTION(op_80) {
+    add_8(cpu->registers.B, 0x80, cpu);
+    return 0;
+}
+
+// ADD C
+INSTRUCTION(op_81) {
+    add_8(cpu->registers.C, 0x81, cpu);
+    return 0;
+}
+
+// ADD D
+INSTRUCTION(op_82) {
+    add_8(cpu->registers.D, 0x82, cpu);
+    return 0;
+}
+
+// ADD E
+INSTRUCTION(op_83) {
+    add_8(cpu->registers.E, 0x83, cpu);
+    return 0;
+}
+
+// ADD H
+INSTRUCTION(op_84) {
+    add_8(cpu->registers.H, 0x84, cpu);
+    return 0;
+}
+
+// ADD L
+INSTRUCTION(op_85) {
+    add_8(cpu->registers.L, 0x85, cpu);
+    return 0;
+}
+
+// ADD (HL)
+INSTRUCTION(op_86) {
+    add_8(readByte(cpu->registers.HL, cpu), 0x86, cpu);
+    return 0;
+}
+
+// ADD A
+INSTRUCTION(op_87) {
+    add_8(cpu->registers.A, 0x87, cpu);
+    return 0;
+}
+
+// ADC B
+INSTRUCTION(op_88) {
+    adc(cpu->registers.B, 0x88, cpu);
+    return 0;
+}
+
+// ADC C
+INSTRUCTION(op_89) {
+    adc(cpu->registers.C, 0x89, cpu);
+    return 0;
+}
+
+// ADC D
+INSTRUCTION(op_8A) {
+    adc(cpu->registers.D, 0x8A, cpu);
+    return 0;
+}
+
+// ADC E
+INSTRUCTION(op_8B) {
+    adc(cpu->registers.E, 0x8B, cpu);
+    return 0;
+}
+
+// ADC H
+INSTRUCTION(op_8C) {
+    adc(cpu->registers.H, 0x8C, cpu);
+    return 0;
+}
+
+// ADC L
+INSTRUCTION(op_8D) {
+    adc(cpu->registers.L, 0x8D, cpu);
+    return 0;
+}
+
+// ADC (HL)
+INSTRUCTION(op_8E) {
+    adc(readByte(cpu->registers.HL, cpu), 0x8E, cpu);
+    return 0;
+}
+
+// ADC A
+INSTRUCTION(op_8F) {
+    adc(cpu->registers.A, 0x8F, cpu);
+    return 0;
+}
+
+// SUB B
+INSTRUCTION(op_90) {
+    sub_8(cpu->registers.B, 0x90, cpu);
+    return 0;
+}
+
+// SUB C
+INSTRUCTION(op_91) {
+    sub_8(cpu->registers.C, 0x91, cpu);
+    return 0;
+}
+
+// SUB D
+INSTRUCTION(op_92) {
+    sub_8(cpu->registers.D, 0x92, cpu);
+    return 0;
+}
+
+// SUB E
+INSTRUCTION(op_93) {
+    sub_8(cpu->registers.E, 0x93, cpu);
+    return 0;
+}
+
+// SUB H
+INSTRUCTION(op_94) {
+    sub_8(cpu->registers.H, 0x94, cpu);
+    return 0;
+}
+
+// SUB L
+INSTRUCTION(op_95) {
+    sub_8(cpu->registers.L, 0x95, cpu);
+    return 0;
+}
+
+// SUB (HL)
+INSTRUCTION(op_96) {
+    sub_8(readByte(cpu->registers.HL, cpu), 0x96, cpu);
+    return 0;
+}
+
+// SUB A
+INSTRUCTION(op_97) {
+    sub_8(cpu->registers.A, 0x97, cpu);
+    return 0;
+}
+
+// SBC B
+INSTRUCTION(op_98) {
+    sbc(cpu->registers.B, 0x98, cpu);
+    return 0;
+}
+
+// SBC C
+INSTRUCTION(op_99) {
+    sbc(cpu->registers.C, 0x99, cpu);
+    return 0;
+}
+
+// SBC D
+INSTRUCTION(op_9A) {
+    sbc(cpu->registers.D, 0x9A, cpu);
+    return 0;
+}
+
+// SBC E
+INSTRUCTION(op_9B) {
+    sbc(cpu->registers.E, 0x9B, cpu);
+    return 0;
+}
+
+// SBC H
+INSTRUCTION(op_9C) {
+    sbc(cpu->registers.H, 0x9C, cpu);
+    return 0;
+}
+
+// SBC L
+INSTRUCTION(op_9D) {
+    sbc(cpu->registers.L, 0x9D, cpu);
+    return 0;
+}
+
+// SBC (HL)
+INSTRUCTION(op_9E) {
+    sbc(readByte(cpu->registers.HL, cpu), 0x9E, cpu);
+    return 0;
+}
+
+// SBC A
+INSTRUCTION(op_9F) {
+    sbc(cpu->registers.A, 0x9F, cpu);
+    return 0;
+}
+
+// AND B
+INSTRUCTION(op_A0) {
+    and(cpu->registers.B, 0xA0, cpu);
+    return 0;
+}
+
+// AND C
+INSTRUCTION(op_A1) {
+    and(cpu->registers.C, 0xA1, cpu);
+    return 0;
+}
+
+// AND D
+INSTRUCTION(op_A2) {
+    and(cpu->registers.D, 0xA2, cpu);
+    return 0;
+}
+
+// AND E
+INSTRUCTION(op_A3) {
+    and(cpu->registers.E, 0xA3, cpu);
+    return 0;
+}
+
+// AND H
+INSTRUCTION(op_A4) {
+    and(cpu->registers.H, 0xA4, cpu);
+    return 0;
+}
+
+// AND L
+INSTRUCTION(op_A5) {
+    and(cpu->registers.L, 0xA5, cpu);
+    return 0;
+}
+
+// AND (HL)
+INSTRUCTION(op_A6) {
+    and(readByte(cpu->registers.HL, cpu), 0xA6, cpu);
+    return 0;
+}
+
+// AND A
+INSTRUCTION(op_A7) {
+    and(cpu->registers.A, 0xA7, cpu);
+    return 0;
+}
+
+// XOR B
+INSTRUCTION(op_A8) {
+    xor(cpu->registers.B, 0xA8, cpu);
+    return 0;
+}
+
+// XOR C
+INSTRUCTION(op_A9) {
+    xor(cpu->registers.C, 0xA9, cpu);
+    return 0;
+}
+
+// XOR D
+INSTRUCTION(op_AA) {
+    xor(cpu->registers.D, 0xAA, cpu);
+    return 0;
+}
+
+// XOR E
+INSTRUCTION(op_AB) {
+    xor(cpu->registers.E, 0xAB, cpu);
+    return 0;
+}
+
+// XOR H
+INSTRUCTION(op_AC) {
+    xor(cpu->registers.H, 0xAC, cpu);
+    return 0;
+}
+
+// XOR L
+INSTRUCTION(op_AD) {
+    xor(cpu->registers.L, 0xAD, cpu);
+    return 0;
+}
+
+// XOR (HL)
+INSTRUCTION(op_AE) {
+    xor(readByte(cpu->registers.HL, cpu), 0xAE, cpu);
+    return 0;
+}
+
+// XOR A
+INSTRUCTION(op_AF) {
+    xor(cpu->registers.A, 0xAF, cpu);
+    return 0;
+}
+
+// OR B
+INSTRUCTION(op_B0) {
+    or(cpu->registers.B, 0xB0, cpu);
+    return 0;
+}
+
+// OR C
+INSTRUCTION(op_B1) {
+    or(cpu->registers.C, 0xB1, cpu);
+    return 0;
+}
+
+// OR D
+INSTRUCTION(op_B2) {
+    or(cpu->registers.D, 0xB2, cpu);
+    return 0;
+}
+
+// OR E
+INSTRUCTION(op_B3) {
+    or(cpu->registers.E, 0xB3, cpu);
+    return 0;
+}
+
+// OR H
+INSTRUCTION(op_B4) {
+    or(cpu->registers.H, 0xB4, cpu);
+    return 0;
+}
+
+// OR L
+INSTRUCTION(op_B5) {
+    or(cpu->registers.L, 0xB5, cpu);
+    return 0;
+}
+
+// OR (HL)
+INSTRUCTION(op_B6) {
+    or(readByte(cpu->registers.HL, cpu), 0xB6, cpu);
+    return 0;
+}
+
+// OR A
+INSTRUCTION(op_B7) {
+    or(cpu->registers.A, 0xB7, cpu);
+    return 0;
+}
+
+// CP B
+INSTRUCTION(op_B8) {
+    cp(cpu->registers.B, 0xB8, cpu);
+    return 0;
+}
+
+// CP C
+INSTRUCTION(op_B9) {
+    cp(cpu->registers.C, 0xB9, cpu);
+    return 0;
+}
+
+// CP D
+INSTRUCTION(op_BA) {
+    cp(cpu->registers.D, 0xBA, cpu);
+    return 0;
+}
+
+// CP E
+INSTRUCTION(op_BB) {
+    cp(cpu->registers.E, 0xBB, cpu);
+    return 0;
+}
+
+// CP H
+INSTRUCTION(op_BC) {
+    cp(cpu->registers.H, 0xBC, cpu);
+    return 0;
+}
+
+// CP L
+INSTRUCTION(op_BD) {
+    cp(cpu->registers.L, 0xBD, cpu);
+    return 0;
+}
+
+// CP (HL)
+INSTRUCTION(op_BE) {
+    cp(readByte(cpu->registers.HL, cpu), 0xBE, cpu);
+    return 0;
+}
+
+// CP A
+INSTRUCTION(op_BF) {
+    cp(cpu->registers.A, 0xBF, cpu);
+    return 0;
+}
+
+// RET NZ
+INSTRUCTION(op_C0) {
+    ret_c(!readFlag(ZF, cpu), 0xC0, cpu);
+    return 0;
+}
+
+// POP BC
+INSTRUCTION(op_C1) {
+    pop(&cpu->registers.BC, false, 0xC1, cpu);
+    return 0;
+}
+
+// JP NZ, a16
+INSTRUCTION(op_C2) {
+    jp_c(!readFlag(ZF, cpu), operand, 0xC2, cpu);
+    return 0;
+}
+
+// JP a16
+INSTRUCTION(op_C3) {
+    jp_c(true, operand, 0xC3, cpu); //will always jump so set condition to be true
+    return 0;
+}
+
+// CALL NZ, a16
+INSTRUCTION(op_C4) {
+    call_c(!readFlag(ZF, cpu), operand, 0xC4, cpu);
+    return 0;
+}
+
+// PUSH BC
+INSTRUCTION(op_C5) {
+    push(cpu->registers.BC, 0xC5, cpu);
+    return 0;
+}
+
+// ADD A, d8
+INSTRUCTION(op_C6) {
+    add_8((uint8) operand, 0xC6, cpu);
+    return 0;
+}
+
+// RST 0x00
+INSTRUCTION(op_C7) {
+    rst(0x00, 0xC7, cpu);
+    return 0;
+}
+
+// RET Z
+INSTRUCTION(op_C8) {
+    ret_c(readFlag(ZF, cpu), 0xC8, cpu);
+    return 0;
+}
+
+// RET
+INSTRUCTION(op_C9) {
+    ret_c(true, 0xC9, cpu); //will always return so set the condition to be true
+    return 0;
+}
+
+// JP Z, a16
+INSTRUCTION(op_CA) {
+    jp_c(readFlag(ZF, cpu), operand, 0xCA, cpu);
+    return 0;
+}
+
+// PREFIX CB
+INSTRUCTION(op_CB) {
+    //execute the cb prefix instruction given by the second byte
+    return executeExtendedInstruction((uint8) operand, cpu);
+}
+
+// CALL Z, a16
+INSTRUCTION(op_CC) {
+    call_c(readFlag(ZF, cpu), operand, 0xCC, cpu);
+    return 0;
+}
+
+// CALL a16
+INSTRUCTION(op_CD) {
+    call_c(true, operand, 0xCD, cpu);
+    return 0;
+}
+
+// ADC d8
+INSTRUCTION(op_CE) {
+    adc((uint8) operand, 0xCE, cpu);
+    return 0;
+}
+
+// RST 0x08
+INSTRUCTION(op_CF) {
+    rst(0x08, 0xCF, cpu);
+    return 0;
+}
+
+// RET NC
+INSTRUCTION(op_D0) {
+    ret_c(!readFlag(CF, cpu), 0xD0, cpu);
+    return 0;
+}
+
+// POP DE
+INSTRUCTION(op_D1) {
+    pop(&cpu->registers.DE, false, 0xD1, cpu);
+    return 0;
+}
+
+// JP NC, a16
+INSTRUCTION(op_D2) {
+    jp_c(!readFlag(CF, cpu), operand, 0xD2, cpu);
+    return 0;
+}
+
+// CALL NC, a16
+INSTRUCTION(op_D4) {
+    call_c(!readFlag(CF, cpu), operand, 0xD4, cpu);
+    return 0;
+}
+
+// PUSH DE
+INSTRUCTION(op_D5) {
+    push(cpu->registers.DE, 0xD5, cpu);
+    return 0;
+}
+
+// SUB d8
+INSTRUCTION(op_D6) {
+    sub_8((uint8) operand, 0xD6, cpu);
+    return 0;
+}
+
+// RST 0x10
+INSTRUCTION(op_D7) {
+    rst(0x10, 0xD7, cpu);
+    return 0;
+}
+
+// RET C
+INSTRUCTION(op_D8) {
+    ret_c(readFlag(CF, cpu), 0xD8, cpu);
+    return 0;
+}
+
+// RETI
+INSTRUCTION(op_D9) {
+    reti(0xD9, cpu);
+    return 0;
+}
+
+// JP C, a16
+INSTRUCTION(op_DA) {
+    jp_c(readFlag(CF, cpu), operand, 0xDA, cpu);
+    return 0;
+}
+
+// CALL C, a16
+INSTRUCTION(op_DC) {
+    call_c(readFlag(CF, cpu), operand, 0xDC, cpu);
+    return 0;
+}
+
+// SBC d8
+INSTRUCTION(op_DE) {
+    sbc((uint8) operand, 0xDE, cpu);
+    return 0;
+}
+
+// RST 0x18
+INSTRUCTION(op_DF) {
+    rst(0x18, 0xDF, cpu);
+    return 0;
+}
+
+// LDH (a8), A
+INSTRUCTION(op_E0) {
+    ld_8_m(cpu->registers.A, 0xFF00 + (uint8) operand, 0xE0, cpu);
+    return 0;
+}
+
+// POP HL
+INSTRUCTION(op_E1) {
+    pop(&cpu->registers.HL, false, 0xE1, cpu);
+    return 0;
+}
+
+// LD (C), A
+INSTRUCTION(op_E2) {
+    ld_8_m(cpu->registers.A, 0xFF00 + cpu->registers.C, 0xE2, cpu);
+    return 0;
+}
+
+// PUSH HL
+INSTRUCTION(op_E5) {
+    push(cpu->registers.HL, 0xE5, cpu);
+    return 0;
+}
+
+// AND d8
+INSTRUCTION(op_E6) {
+    and((uint8) operand, 0xE6, cpu);
+    return 0;
+}
+
+// RST 0x20
+INSTRUCTION(op_E7) {
+    rst(0x20, 0xE7, cpu);
+    return 0;
+}
+
+// ADD SP, r8
+INSTRUCTION(op_E8) {
+    add_16_8((int8) operand, cpu->SP, &cpu->SP, 0xE8, cpu);
+    return 0;
+}
+
+// JP (HL) -> read as JP HL
+INSTRUCTION(op_E9) {
+    jp_c(true, cpu->registers.HL, 0xE9, cpu);
+    return 0;
+}
+
+// LD (a16), A
+INSTRUCTION(op_EA) {
+    ld_8_m(cpu->registers.A, operand, 0xEA, cpu);
+    return 0;
+}
+
+// XOR d8
+INSTRUCTION(op_EE) {
+    xor((uint8) operand, 0xEE, cpu);
+    return 0;
+}
+
+// RST 0x28
+INSTRUCTION(op_EF) {
+    rst(0x28, 0xEF, cpu);
+    return 0;
+}
+
+// LDH A, (a8)
+INSTRUCTION(op_F0) {
+    ld_8(readByte(0xFF00 + (uint8) operand, cpu), &cpu->registers.A, 0xF0, cpu);
+    return 0;
+}
+
+// POP AF
+INSTRUCTION(op_F1) {
+    pop(&cpu->registers.AF, true, 0xF1, cpu);
+    return 0;
+}
+
+// LD A, (C)
+INSTRUCTION(op_F2) {
+    ld_8(readByte(0xFF00 + cpu->registers.C, cpu), &cpu->registers.A, 0xF2, cpu);
+    return 0;
+}
+
+// DI
+INSTRUCTION(op_F3) {
+    di(0xF3, cpu);
+    return 0;
+}
+
+// PUSH AF
+INSTRUCTION(op_F5) {
+    cpu->registers.F = readFlagsRegister(cpu);
+    push(cpu->registers.AF, 0xF5, cpu);
+    return 0;
+}
+
+// OR d8
+INSTRUCTION(op_F6) {
+    or((uint8) operand, 0xF6, cpu);
+    return 0;
+}
+
+// RST 0x30
+INSTRUCTION(op_F7) {
+    rst(0x30, 0xF7, cpu);
+    return 0;
+}
+
+// LD HL, SP+r8
+INSTRUCTION(op_F8) {
+    add_16_8((int8) operand, cpu->SP, &cpu->registers.HL, 0xF8, cpu);
+    return 0;
+}
+
+// LD SP, HL
+INSTRUCTION(op_F9) {
+    ld_16(cpu->registers.HL, &cpu->SP, 0xF9, cpu);
+    return 0;
+}
+
+// LD A, (a16)
+INSTRUCTION(op_FA) {
+    ld_8(readByte(operand, cpu), &cpu->registers.A, 0xFA, cpu);
+    return 0;
+}
+
+// EI
+INSTRUCTION(op_FB) {
+    ei(0xFB, cpu);
+    return 0;
+}
+
+// CP d8
+INSTRUCTION(op_FE) {
+    cp((uint8) operand, 0xFE, cpu);
+    return 0;
+}
+
+// RST 0x38
+INSTRUCTION(op_FF) {
+    rst(0x38, 0xFF, cpu);
+    return 0;
+}
+
+// Unknown instruction
+INSTRUCTION(op_invalid) {
+    printf("Error instruction not found: ");
+    printInstruction(false, cpu->PC - 1, cpu);
+    return 1;
+}
+
+// Handler for every opcode. Operands are fetched before the handler is called.
+const instruction instructions[256] = {
+    op_00, op_01, op_02, op_03, op_04, op_05, op_06, op_07, op_08, op_09, op_0A, op_0B, op_0C, op_0D, op_0E, op_0F,
+    op_invalid, op_11, op_12, op_13, op_14, op_15, op_16, op_17, op_18, op_19, op_1A, op_1B, op_1C, op_1D, op_1E, op_1F,
+    op_20, op_21, op_22, op_23, op_24, op_25, op_26, op_27, op_28, op_29, op_2A, op_2B, op_2C, op_2D, op_2E, op_2F,
+    op_30, op_31, op_32, op_33, op_34, op_35, op_36, op_37, op_38, op_39, op_3A, op_3B, op_3C, op_3D, op_3E, op_3F,
+    op_40, op_41, op_42, op_43, op_44, op_45, op_46, op_47, op_48, op_49, op_4A, op_4B, op_4C, op_4D, op_4E, op_4F,
+    op_50, op_51, op_52, op_53, op_54, op_55, op_56, op_57, op_58, op_59, op_5A, op_5B, op_5C, op_5D, op_5E, op_5F,
+    op_60, op_61, op_62, op_63, op_64, op_65, op_66, op_67, op_68, op_69, op_6A, op_6B, op_6C, op_6D, op_6E, op_6F,
+    op_70, op_71, op_72, op_73, op_74, op_75, op_76, op_77, op_78, op_79, op_7A, op_7B, op_7C, op_7D, op_7E, op_7F,
+    op_80, op_81, op_82, op_83, op_84, op_85, op_86, op_87, op_88, op_89, op_8A, op_8B, op_8C, op_8D, op_8E, op_8F,
+    op_90, op_91, op_92, op_93, op_94, op_95, op_96, op_97, op_98, op_99, op_9A, op_9B, op_9C, op_9D, op_9E, op_9F,
+    op_A0, op_A1, op_A2, op_A3, op_A4, op_A5, op_A6, op_A7, op_A8, op_A9, op_AA, op_AB, op_AC, op_AD, op_AE, op_AF,
+    op_B0, op_B1, op_B2, op_B3, op_B4, op_B5, op_B6, op_B7, op_B8, op_B9, op_BA, op_BB, op_BC, op_BD, op_BE, op_BF,
+    op_C0, op_C1, op_C2, op_C3, op_C4, op_C5, op_C6, op_C7, op_C8, op_C9, op_CA, op_CB, op_CC, op_CD, op_CE, op_CF,
+    op_D0, op_D1, op_D2, op_invalid, op_D4, op_D5, op_D6, op_D7, op_D8, op_D9, op_DA, op_invalid, op_DC, op_invalid, op_DE, op_DF,
+    op_E0, op_E1, op_E2, op_invalid, op_invalid, op_E5, op_E6, op_E7, op_E8, op_E9, op_EA, op_invalid, op_invalid, op_invalid, op_EE, op_EF,
+    op_F0, op_F1, op_F2, op_F3, op_invalid, op_F5, op_F6, op_F7, op_F8, op_F9, op_FA, op_FB, op_invalid, op_invalid, op_FE, op_FF,
+};
+
+//execute next instruction
+int executeNextInstruction(Cpu * cpu) {
+    // Don't execute if halt is called
+    if (cpu->halt) {
+        return 432;
+    }
+    //grab instruction
+    uint8 opcode = readNextByte(cpu);
+    //the halt bug stops the PC moving past the instruction after HALT
+    if (cpu->halt_bug) {
+        cpu->halt_bug = false;
+        cpu->PC--;
+    }
+    //grab any operands
+    uint16 operand = 0;
+    if (opcode_length[opcode] > 1) {
+        operand = readNextByte(cpu);
+        if (opcode_length[opcode] > 2) {
+            operand |= ((uint16) readNextByte(cpu)) << 8;
+        }
+    }
+    //find and execute next instruction
+    cpu->instructions++;
+    return instructions[opcode](operand, cpu);
+}
+
+// Store format to printf each instruction
+const opcode opcodes[256] = {
+	{ "0x00 NOP" },
+	{ "0x01 LD BC, 0x%04X" },
+	{ "0x02 LD (BC), A" },
+	{ "0x03 INC BC" },
+	{ "0x04 INC B" },
+	{ "0x05 DEC B" },
+	{ "0x06 LD B, 0x%02" PRIX8 },
+	{ "0x07 RLCA" },
+	{ "0x08 LD (0x%04X), SP" },
+	{ "0x09 ADD HL, BC" },
+	{ "0x0A LD A, (BC)" },
+	{ "0x0B DEC BC" },
+	{ "0x0C INC C" },
+	{ "0x0D DEC C" },
+	{ "0x0E LD C, 0x%02" PRIX8 },
+	{ "0x0F RRCA" },
+	{ "0x10 STOP 0" },
+	{ "0x11 LD DE, 0x%04X" },
+	{ "0x12 LD (DE), A" },
+	{ "0x13 INC DE" },
+	{ "0x14 INC D" },
+	{ "0x15 DEC D" },
+	{ "0x16 LD D, 0x%02" PRIX8 },
+	{ "0x17 RLA" },
+	{ "0x18 JR 0x%02" PRIX8 },
+	{ "0x19 ADD HL, DE" },
+	{ "0x1A LD A, (DE)" },
+	{ "0x1B DEC DE" },
+	{ "0x1C INC E" },
+	{ "0x1D DEC E" },
+	{ "0x1E LD E, 0x%02" PRIX8 },
+	{ "0x1F RRA" },
+	{ "0x20 JR NZ, 0x%02" PRIX8 },
+	{ "0x21 LD HL, 0x%04X" },
+	{ "0x22 LDI (HL), A" },
+	{ "0x23 INC HL" },
+	{ "0x24 INC H" },
+	{ "0x25 DEC H" },
+	{ "0x26 LD H, 0x%02" PRIX8 },
+	{ "0x27 DAA" },
+	{ "0x28 JR Z, 0x%02" PRIX8 },
+	{ "0x29 ADD HL, HL" },
+	{ "0x2A LDI A, (HL)" },
+	{ "0x2B DEC HL" },
+	{ "0x2C INC L" },
+	{ "0x2D DEC L" },
+	{ "0x2E LD L, 0x%02" PRIX8 },
+	{ "0x2F CPL" },
+	{ "0x30 JR NC, 0x%02" PRIX8 },
+	{ "0x31 LD SP, 0x%04X" },
+	{ "0x32 LDD (HL), A" },
+	{ "0x33 INC SP" },
+	{ "0x34 INC (HL)" },
+	{ "0x35 DEC (HL)" },
+	{ "0x36 LD (HL), 0x%02" PRIX8 },
+	{ "0x37 SCF" },
+	{ "0x38 JR C, 0x%02" PRIX8 },
+	{ "0x39 ADD HL, SP" },
+	{ "0x3A LDD A, (HL)" },
+	{ "0x3B DEC SP" },
+	{ "0x3C INC A" },
+	{ "0x3D DEC A" },
+	{ "0x3E LD A, 0x%02" PRIX8 },
+	{ "0x3F CCF" },
+	{ "0x40 LD B, B" },
+	{ "0x41 LD B, C" },
+	{ "0x42 LD B, D" },
+	{ "0x43 LD B, E" },
+	{ "0x44 LD B, H" },
+	{ "0x45 LD B, L" },
+	{ "0x46 LD B, (HL)" },
+	{ "0x47 LD B, A" },
+	{ "0x48 LD C, B" },
+	{ "0x49 LD C, C" },
+	{ "0x4A LD C, D" },
+	{ "0x4B LD C, E" },
+	{ "0x4C LD C, H" },
+	{ "0x4D LD C, L" },
+	{ "0x4E LD C, (HL)" },
+	{ "0x4F LD C, A" },
+	{ "0x50 LD D, B" },
+	{ "0x51 LD D, C" },
+	{ "0x52 LD D, D" },
+	{ "0x53 LD D, E" },
+	{ "0x54 LD D, H" },
+	{ "0x55 LD D, L" },
+	{ "0x56 LD D, (HL)" },
+	{ "0x57 LD D, A" },
+	{ "0x58 LD E, B" },
+	{ "0x59 LD E, C" },
+	{ "0x5A LD E, D" },
+	{ "0x5B LD E, E" },
+	{ "0x5C LD E, H" },
+	{ "0x5D LD E, L" },
+	{ "0x5E LD E, (HL)" },
+	{ "0x5F LD E, A" },
+	{ "0x60 LD H, B" },
+	{ "0x61 LD H, C" },
+	{ "0x62 LD H, D" },
+	{ "0x63 LD H, E" },
+	{ "0x64 LD H, H" },
+	{ "0x65 LD H, L" },
+	{ "0x66 LD H, (HL)" },
+	{ "0x67 LD H, A" },
+	{ "0x68 LD L, B" },
+	{ "0x69 LD L, C" },
+	{ "0x6A LD L, D" },
+	{ "0x6B LD L, E" },
+	{ "0x6C LD L, H" },
+	{ "0x6D LD L, L" },
+	{ "0x6E LD L, (HL)" },
+	{ "0x6F LD L, A" },
+	{ "0x70 LD (HL), B" },
+	{ "0x71 LD (HL), C" },
+	{ "0x72 LD (HL), D" },
+	{ "0x73 LD (HL), E" },
+	{ "0x74 LD (HL), H" },
+	{ "0x75 LD (HL), L" },
+	{ "0x76 HALT" },
+	{ "0x77 LD (HL), A" },
+	{ "0x78 LD A, B" },
+	{ "0x79 LD A, C" },
+	{ "0x7A LD A, D" },
+	{ "0x7B LD A, E" },
+	{ "0x7C LD A, H" },
+	{ "0x7D LD A, L" },
+	{ "0x7E LD A, (HL)" },
+	{ "0x7F LD A, A" },
+	{ "0x80 ADD A, B" },
+	{ "0x81 ADD A, C" },
+	{ "0x82 ADD A, D" },
+	{ "0x83 ADD A, E" },
+	{ "0x84 ADD A, H" },
+	{ "0x85 ADD A, L" },
+	{ "0x86 ADD A, (HL)" },
+	{ "0x87 ADD A" },
+	{ "0x88 ADC B" },
+	{ "0x89 ADC C" },
+	{ "0x8A ADC D" },
+	{ "0x8B ADC E" },
+	{ "0x8C ADC H" },
+	{ "0x8D ADC L" },
+	{ "0x8E ADC (HL)" },
+	{ "0x8F ADC A" },
+	{ "0x90 SUB B" },
+	{ "0x91 SUB C" },
+	{ "0x92 SUB D" },
+	{ "0x93 SUB E" },
+	{ "0x94 SUB H" },
+	{ "0x95 SUB L" },
+	{ "0x96 SUB (HL)" },
+	{ "0x97 SUB A" },
+	{ "0x98 SBC B" },
+	{ "0x99 SBC C" },
+	{ "0x9A SBC D" },
+	{ "0x9B SBC E" },
+	{ "0x9C SBC H" },
+	{ "0x9D SBC L" },
+	{ "0x9E SBC (HL)" },
+	{ "0x9F SBC A" },
+	{ "0xA0 AND B" },
+	{ "0xA1 AND C" },
+	{ "0xA2 AND D" },
+	{ "0xA3 AND E" },
+	{ "0xA4 AND H" },
+	{ "0xA5 AND L" },
+	{ "0xA6 AND (HL)" },
+	{ "0xA7 AND A" },
+	{ "0xA8 XOR B" },
+	{ "0xA9 XOR C" },
+	{ "0xAA XOR D" },
+	{ "0xAB XOR E" },
+	{ "0xAC XOR H" },
+	{ "0xAD XOR L" },
+	{ "0xAE XOR (HL)" },
+	{ "0xAF XOR A" },
+	{ "0xB0 OR B" },
+	{ "0xB1 OR C" },
+	{ "0xB2 OR D" },
+	{ "0xB3 OR E" },
+	{ "0xB4 OR H" },
+	{ "0xB5 OR L" },
+	{ "0xB6 OR (HL)" },
+	{ "0xB7 OR A" },
+	{ "0xB8 CP B" },
+	{ "0xB9 CP C" },
+	{ "0xBA CP D" },
+	{ "0xBB CP E" },
+	{ "0xBC CP H" },
+	{ "0xBD CP L" },
+	{ "0xBE CP (HL)" },
+	{ "0xBF CP A" },
+	{ "0xC0 RET NZ" },
+	{ "0xC1 POP BC" },
+	{ "0xC2 JP NZ, 0x%04X" },
+	{ "0xC3 JP 0x%04X" },
+	{ "0xC4 CALL NZ, 0x%04X" },
+	{ "0xC5 PUSH BC" },
+	{ "0xC6 ADD A, 0x%02" PRIX8 },
+	{ "0xC7 RST 0x00" },
+	{ "0xC8 RET Z" },
+	{ "0xC9 RET" },
+	{ "0xCA JP Z, 0x%04X" },
+	{ "0xCB PREFIX CB" },
+	{ "0xCC CALL Z, 0x%04X" },
+	{ "0xCD CALL 0x%04X" },
+	{ "0xCE ADC 0x%02" PRIX8 },
+	{ "0xCF RST 0x08" },
+	{ "0xD0 RET NC" },
+	{ "0xD1 POP DE" },
+	{ "0xD2 JP NC, 0x%04X" },
+	{ "0xD3 NONE" },
+	{ "0xD4 CALL NC, 0x%04X" },
+	{ "0xD5 PUSH DE" },
+	{ "0xD6 SUB 0x%02" PRIX8 },
+	{ "0xD7 RST 0x10" },
+	{ "0xD8 RET C" },
+	{ "0xD9 RETI" },
+	{ "0xDA JP C, 0x%04X" },
+	{ "0xDB NONE" },
+	{ "0xDC CALL C, 0x%04X" },
+	{ "0xDD NONE" },
+	{ "0xDE SBC 0x%02" PRIX8 },
+	{ "0xDF RST 0x18" },
+	{ "0xE0 LDH (0x%02" PRIX8 "), A" },
+	{ "0xE1 POP HL" },
+	{ "0xE2 LD (C), A" },
+	{ "0xE3 NONE" },
+	{ "0xE4 NONE" },
+	{ "0xE5 PUSH HL" },
+	{ "0xE6 AND 0x%02" PRIX8 },
+	{ "0xE7 RST 0x20" },
+	{ "0xE8 ADD SP, 0x%02" PRIX8 },
+	{ "0xE9 JP (HL)" },
+	{ "0xEA LD (0x%02" PRIX8 "), A" },
+	{ "0xEB NONE" },
+	{ "0xEC NONE" },
+	{ "0xED NONE" },
+	{ "0xEE XOR 0x%02" PRIX8 },
+	{ "0xEF RST 0x28" },
+	{ "0xF0 LDH A, (0x%02" PRIX8 ")" },
+	{ "0xF1 POP AF" },
+	{ "0xF2 LD A, (C)" },
+	{ "0xF3 DI" },
+	{ "0xF4 NONE" },
+	{ "0xF5 PUSH AF" },
+	{ "0xF6 OR 0x%02" PRIX8 },
+	{ "0xF7 RST 0x30" },
+	{ "0xF8 LD HL, SP+0x%02" PRIX8 },
+	{ "0xF9 LD SP, HL" },
+	{ "0xFA LD A, (0x%04X)" },
+	{ "0xFB EI" },
+	{ "0xFC NONE" },
+	{ "0xFD NONE" },
+	{ "0xFE CP 0x%02" PRIX8 },
+	{ "0xFF RST 0x38" },
+};
+
+// Return information about requested opcode
+opcode get_opcode(uint8 value) {
+    return opcodes[value];
+}
+
+// Number of cycles each instruction takes. Conditional instructions take this long when the condition isn't met.
+const uint8 opcode_cycles[256] = {
+     4, 12,  8,  8,  4,  4,  8,  4, 20,  8,  8,  8,  4,  4,  8,  4, // 0x00
+     4, 12,  8,  8,  4,  4,  8,  4, 12,  8,  8,  8,  4,  4,  8,  4, // 0x10
+     8, 12,  8,  8,  4,  4,  8,  4,  8,  8,  8,  8,  4,  4,  8,  4, // 0x20
+     8, 12,  8,  8, 12, 12, 12,  4,  8,  8,  8,  8,  4,  4,  8,  4, // 0x30
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 0x40
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 0x50
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 0x60
+     8,  8,  8,  8,  8,  8,  4,  8,  4,  4,  4,  4,  4,  4,  8,  4, // 0x70
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 0x80
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 0x90
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 0xA0
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 0xB0
+     8, 12, 12, 16, 12, 16,  8, 16,  8, 16, 12,  4, 12, 24,  8, 16, // 0xC0
+     8, 12, 12,  0, 12, 16,  8, 16,  8, 16, 12,  0, 12,  0,  8, 16, // 0xD0
+    12, 12,  8,  0,  0, 16,  8, 16, 16,  4, 16,  0,  0,  0,  8, 16, // 0xE0
+    12, 12,  8,  4,  0, 16,  8, 16, 12,  8, 16,  4,  0,  0,  8, 16, // 0xF0
+};
+
+// Number of cycles each instruction takes when a conditional jump, call, or return is taken.
+const uint8 opcode_cycles_taken[256] = {
+     4, 12,  8,  8,  4,  4,  8,  4, 20,  8,  8,  8,  4,  4,  8,  4, // 0x00
+     4, 12,  8,  8,  4,  4,  8,  4, 12,  8,  8,  8,  4,  4,  8,  4, // 0x10
+    12, 12,  8,  8,  4,  4,  8,  4, 12,  8,  8,  8,  4,  4,  8,  4, // 0x20
+    12, 12,  8,  8, 12, 12, 12,  4, 12,  8,  8,  8,  4,  4,  8,  4, // 0x30
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 0x40
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 0x50
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 0x60
+     8,  8,  8,  8,  8,  8,  4,  8,  4,  4,  4,  4,  4,  4,  8,  4, // 0x70
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 0x80
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 0x90
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 0xA0
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 0xB0
+    20, 12, 16, 16, 24, 16,  8, 16, 20, 16, 16,  4, 24, 24,  8, 16, // 0xC0
+    20, 12, 16,  0, 24, 16,  8, 16, 20, 16, 16,  0, 24,  0,  8, 16, // 0xD0
+    12, 12,  8,  0,  0, 16,  8, 16, 16,  4, 16,  0,  0,  0,  8, 16, // 0xE0
+    12, 12,  8,  4,  0, 16,  8, 16, 12,  8, 16,  4,  0,  0,  8, 16, // 0xF0
+};
+
+// Number of bytes each instruction takes up in memory, including operands.
+const uint8 opcode_length[256] = {
+    1, 3, 1, 1, 1, 1, 2, 1, 3, 1, 1, 1, 1, 1, 2, 1, // 0x00
+    2, 3, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 2, 1, // 0x10
+    2, 3, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 2, 1, // 0x20
+    2, 3, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 2, 1, // 0x30
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x40
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x50
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x60
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x70
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x80
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x90
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0xA0
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0xB0
+    1, 1, 3, 3, 3, 1, 2, 1, 1, 1, 3, 2, 3, 3, 2, 1, // 0xC0
+    1, 1, 3, 1, 3, 1, 2, 1, 1, 1, 3, 1, 3, 1, 2, 1, // 0xD0
+    2, 1, 1, 1, 1, 1, 2, 1, 2, 1, 3, 1, 1, 1, 2, 1, // 0xE0
+    2, 1, 1, 1, 1, 1, 2, 1, 2, 1, 3, 1, 1, 1, 2, 1, // 0xF0
 };
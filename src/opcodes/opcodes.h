@@ -5,21 +5,27 @@
 
 typedef struct {
 	char* name;
-	uint8 cycles;
-    uint8 cyclesMax;
-    uint8 bytes;
 } opcode;
 
 typedef struct {
     char* name;
-    uint8 cycles;
 } cb_opcode;
 
+// Instruction handlers. The operand holds any immediate bytes following the opcode.
+typedef int (*instruction)(uint16 operand, Cpu *cpu);
+typedef void (*cb_instruction)(Cpu *cpu);
+
+extern const instruction instructions[256];
+extern const uint8 opcode_cycles[256];
+extern const uint8 opcode_cycles_taken[256];
+extern const uint8 opcode_length[256];
+extern const uint8 cb_opcode_cycles[256];
+
 extern opcode get_opcode(uint8 value);
 extern cb_opcode get_cb_opcode(uint8 value);
 
 extern int executeNextInstruction(Cpu *cpu);
 
-extern int executeNextExtendedInstruction(Cpu *cpu);
+extern int executeExtendedInstruction(uint8 opcode, Cpu *cpu);
 
 #endif /* OPCODE_H */
@@ -0,0 +1,279 @@
+/* -*-mode:c; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+// Renders frames on a second thread while the cpu thread runs the next one.
+//
+// During a frame the cpu thread logs every write the display reads, in order: vram, OAM and the LCDC, scroll,
+// window and palette registers. A marker is logged where each scanline is drawn. At the end of the frame the
+// log is handed to the renderer thread, which replays it against its own copy of the display and the memory
+// it reads, drawing each line at its marker. Raster effects come out the same as drawing on the cpu thread.
+// Each frame is passed to the frontend at the end of the frame after it.
+#include "types.h"
+#include "cpu.h"
+#include "renderer.h"
+#include "display.h"
+#include "memory.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Address logged for a scanline being drawn, with the line as the value. Rom writes are never logged.
+#define LOG_LINE 0x0000
+#define LOG_START_CAPACITY 4096
+// Logs with no lines to draw are handed over at this length, so they don't grow while the LCD is off
+#define LOG_LIMIT 0x10000
+
+typedef struct {
+    uint16 address;
+    uint8 value;
+} LogEntry;
+
+typedef struct {
+    LogEntry *entries; // malloc'ed
+    uint32 count;
+    uint32 capacity;
+    uint32 lines;
+} FrameLog;
+
+struct Renderer {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake; // signalled when there's a log to replay, or the thread should stop
+    pthread_cond_t done; // signalled when a log has been replayed
+    bool busy;
+    bool stop;
+    // The log being written by the cpu thread, and the one handed to the renderer thread
+    FrameLog logs[2];
+    uint8 current;
+    FrameLog *job;
+    bool jobEndsFrame;
+    bool jobRendered;
+    // Whether the last frame handed over was rendered, or skipped with setEmulatorRendering
+    bool frameRendered;
+    // Copy of the cpu holding only the display and the memory it reads. Owned by the renderer thread.
+    Cpu *copy; // malloc'ed
+};
+
+// Apply the writes in a log to the copy of the display, drawing each line at its marker
+static void replayLog(FrameLog *log, Cpu *copy) {
+    for (uint32 i = 0; i < log->count; i++) {
+        uint16 address = log->entries[i].address;
+        uint8 value = log->entries[i].value;
+        if (address == LOG_LINE) {
+            // The window line restarts with each frame, which always starts drawing at line 0
+            if (value == 0) {
+                resetWindowLine(copy);
+            }
+            copy->memory.io[SCANLINE - IO_BASE] = value;
+            loadScanline(copy);
+        } else if (address < VRAM_BASE + VRAM_BOUND) {
+            uint16 offset = address - VRAM_BASE;
+            copy->memory.vramBank[offset] = value;
+            if (address < BG_MAP_DATA1_BASE) {
+                markTileDirty(offset >> 4, copy);
+            } else {
+                markMapDirty(copy);
+            }
+        } else if (address < OAM_BASE + OAM_BOUND) {
+            copy->memory.oam[address - OAM_BASE] = value;
+            markSpritesDirty(copy);
+        } else {
+            copy->memory.io[address - IO_BASE] = value;
+            if (address == BG_PALETTE) {
+                updateBackgroundColour(value, copy);
+            } else if (address == SP_PALETTE_0) {
+                updateSpritePalette(0, value, copy);
+            } else if (address == SP_PALETTE_1) {
+                updateSpritePalette(1, value, copy);
+            }
+        }
+    }
+}
+
+// Renderer thread. Replays each log it's handed, converting finished frames for the frontend.
+static void *runRenderer(void *data) {
+    struct Renderer *renderer = (struct Renderer *) data;
+    pthread_mutex_lock(&renderer->lock);
+    while (!renderer->stop) {
+        if (!renderer->busy) {
+            pthread_cond_wait(&renderer->wake, &renderer->lock);
+            continue;
+        }
+        pthread_mutex_unlock(&renderer->lock);
+        replayLog(renderer->job, renderer->copy);
+        if (renderer->jobEndsFrame && renderer->jobRendered) {
+            finishFrameChanges(renderer->copy);
+            if (renderer->copy->display->pixelFormat != PIXEL_SHADES) {
+                convertFrame(renderer->copy);
+            }
+        }
+        pthread_mutex_lock(&renderer->lock);
+        renderer->busy = false;
+        pthread_cond_signal(&renderer->done);
+    }
+    pthread_mutex_unlock(&renderer->lock);
+    return NULL;
+}
+
+// Wait for the renderer thread to finish the last log it was handed
+static void waitRenderer(struct Renderer *renderer) {
+    pthread_mutex_lock(&renderer->lock);
+    while (renderer->busy) {
+        pthread_cond_wait(&renderer->done, &renderer->lock);
+    }
+    pthread_mutex_unlock(&renderer->lock);
+}
+
+// Hand the current log to the renderer thread, once it's finished the last one, and start a new one
+static void submitLog(bool endsFrame, Cpu *cpu) {
+    struct Renderer *renderer = cpu->renderer;
+    waitRenderer(renderer);
+    renderer->job = &renderer->logs[renderer->current];
+    renderer->jobEndsFrame = endsFrame;
+    renderer->jobRendered = cpu->display->rendering;
+    renderer->copy->display->pixelFormat = cpu->display->pixelFormat;
+    renderer->current ^= 1;
+    renderer->logs[renderer->current].count = 0;
+    renderer->logs[renderer->current].lines = 0;
+    pthread_mutex_lock(&renderer->lock);
+    renderer->busy = true;
+    pthread_cond_signal(&renderer->wake);
+    pthread_mutex_unlock(&renderer->lock);
+}
+
+static void appendLog(uint16 address, uint8 value, Cpu *cpu) {
+    struct Renderer *renderer = cpu->renderer;
+    FrameLog *log = &renderer->logs[renderer->current];
+    if (log->count == log->capacity) {
+        if (!log->lines && log->count >= LOG_LIMIT) {
+            // Nothing to draw yet, so hand over what there is rather than keep growing
+            submitLog(false, cpu);
+            log = &renderer->logs[renderer->current];
+        } else {
+            log->capacity *= 2;
+            log->entries = (LogEntry *) realloc(log->entries, log->capacity * sizeof(LogEntry));
+            if (!log->entries) {
+                printf("Failed to malloc renderer log\n");
+                exit(531);
+            }
+        }
+    }
+    log->entries[log->count].address = address;
+    log->entries[log->count].value = value;
+    log->count++;
+}
+
+// Log a write to vram, OAM or a display register, for the renderer thread to replay
+void logRendererWrite(uint16 address, uint8 value, Cpu *cpu) {
+    appendLog(address, value, cpu);
+}
+
+// Log the point a scanline is drawn at
+void logRendererLine(uint8 scanLine, Cpu *cpu) {
+    appendLog(LOG_LINE, scanLine, cpu);
+    cpu->renderer->logs[cpu->renderer->current].lines++;
+}
+
+// Pass the frame the renderer thread last finished to the frontend
+static void passFrame(bool rendered, Cpu *cpu) {
+    if (!cpu->videoCallback) {
+        return;
+    }
+    struct Display *display = cpu->renderer->copy->display;
+    if (!rendered) {
+        cpu->videoCallback(NULL, cpu->callbackData);
+    } else if (display->pixelFormat == PIXEL_SHADES) {
+        cpu->videoCallback(display->shades, cpu->callbackData);
+    } else {
+        cpu->videoCallback(display->frameBuffer, cpu->callbackData);
+    }
+}
+
+// At the end of a frame, pass the frame before it to the frontend and hand this one to the renderer thread
+void drawRendererFrame(Cpu *cpu) {
+    struct Renderer *renderer = cpu->renderer;
+    if (!cpu->display->renderThreaded) {
+        // Back to drawing on the cpu thread. This frame is finished now and passed on in place of the one before.
+        submitLog(true, cpu);
+        waitRenderer(renderer);
+        passFrame(renderer->jobRendered, cpu);
+        stopRenderer(cpu);
+        return;
+    }
+    waitRenderer(renderer);
+    passFrame(renderer->frameRendered, cpu);
+    renderer->frameRendered = cpu->display->rendering;
+    submitLog(true, cpu);
+}
+
+// Start rendering frames on a second thread, at the end of a frame drawn on the cpu thread. That frame is
+// passed on again at the end of the next one, while the renderer thread draws the next.
+void startRenderer(Cpu *cpu) {
+    struct Renderer *renderer = (struct Renderer *) calloc(1, sizeof(struct Renderer));
+    Cpu *copy = (Cpu *) calloc(1, sizeof(Cpu));
+    if (!renderer || !copy) {
+        printf("Failed to malloc renderer\n");
+        exit(531);
+    }
+    copy->display = createDisplay();
+    copy->memory.vramBank = (uint8 *) malloc(VRAM_BANK_SIZE);
+    if (!copy->memory.vramBank) {
+        printf("Failed to malloc renderer vram\n");
+        exit(531);
+    }
+    resetDisplay(copy);
+    memcpy(copy->memory.vramBank, cpu->memory.vramBank, VRAM_BANK_SIZE);
+    memcpy(copy->memory.oam, cpu->memory.oam, OAM_BOUND);
+    memcpy(copy->memory.io, cpu->memory.io, IO_BOUND);
+    struct Display *display = cpu->display;
+    memcpy(copy->display->backgroundColourOffset, display->backgroundColourOffset, sizeof(display->backgroundColourOffset));
+    memcpy(copy->display->spritePaletteZero, display->spritePaletteZero, sizeof(display->spritePaletteZero));
+    memcpy(copy->display->spritePaletteOne, display->spritePaletteOne, sizeof(display->spritePaletteOne));
+    copy->display->pixelFormat = display->pixelFormat;
+    memcpy(copy->display->shades, display->shades, sizeof(display->shades));
+    memcpy(copy->display->frameBuffer, display->frameBuffer, sizeof(display->frameBuffer));
+    renderer->copy = copy;
+    renderer->frameRendered = display->rendering;
+    for (uint8 i = 0; i < 2; i++) {
+        renderer->logs[i].capacity = LOG_START_CAPACITY;
+        renderer->logs[i].entries = (LogEntry *) malloc(LOG_START_CAPACITY * sizeof(LogEntry));
+        if (!renderer->logs[i].entries) {
+            printf("Failed to malloc renderer log\n");
+            exit(531);
+        }
+    }
+    pthread_mutex_init(&renderer->lock, NULL);
+    pthread_cond_init(&renderer->wake, NULL);
+    pthread_cond_init(&renderer->done, NULL);
+    if (pthread_create(&renderer->thread, NULL, runRenderer, renderer)) {
+        printf("Failed to start renderer thread\n");
+        exit(532);
+    }
+    cpu->renderer = renderer;
+}
+
+// Stop the renderer thread and free it. Frames are drawn on the cpu thread again.
+void stopRenderer(Cpu *cpu) {
+    struct Renderer *renderer = cpu->renderer;
+    pthread_mutex_lock(&renderer->lock);
+    renderer->stop = true;
+    pthread_cond_signal(&renderer->wake);
+    pthread_mutex_unlock(&renderer->lock);
+    pthread_join(renderer->thread, NULL);
+    pthread_mutex_destroy(&renderer->lock);
+    pthread_cond_destroy(&renderer->wake);
+    pthread_cond_destroy(&renderer->done);
+    free(renderer->logs[0].entries);
+    free(renderer->logs[1].entries);
+    free(renderer->copy->memory.vramBank);
+    free(renderer->copy->display);
+    free(renderer->copy);
+    free(renderer);
+    cpu->renderer = NULL;
+    // The cpu's own frame hasn't kept up with what the frontend was passed
+    markFrameChanged(cpu);
+}
+
+// The copy of the cpu frames are drawn with, which holds the last finished frame's details
+Cpu *rendererCopy(Cpu *cpu) {
+    return cpu->renderer->copy;
+}
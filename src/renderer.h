@@ -0,0 +1,14 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include "types.h"
+#include "cpu.h"
+
+extern void startRenderer(Cpu *cpu);
+extern void stopRenderer(Cpu *cpu);
+extern void logRendererWrite(uint16 address, uint8 value, Cpu *cpu);
+extern void logRendererLine(uint8 scanLine, Cpu *cpu);
+extern void drawRendererFrame(Cpu *cpu);
+extern Cpu *rendererCopy(Cpu *cpu);
+
+#endif /* RENDERER_H */
@@ -0,0 +1,71 @@
+/* -*-mode:c; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+#include "types.h"
+#include "cpu.h"
+#include "scheduler.h"
+#include "screen.h"
+#include "interrupts.h"
+
+// Handler for each event. Each is passed the time the event was due.
+static void (*const EVENT_HANDLERS[EVENT_COUNT])(uint64 time, Cpu *cpu) = {
+    screenEvent,
+    timerEvent
+};
+
+// Find the time of the next event that is due
+static void updateNextEvent(Cpu *cpu) {
+    cpu->nextEvent = EVENT_NEVER;
+    for (uint8 event = 0; event < EVENT_COUNT; event++) {
+        if (cpu->events[event] < cpu->nextEvent) {
+            cpu->nextEvent = cpu->events[event];
+        }
+    }
+}
+
+// Reset the master clock and clear all events
+void resetScheduler(Cpu *cpu) {
+    cpu->clock = 0;
+    for (uint8 event = 0; event < EVENT_COUNT; event++) {
+        cpu->events[event] = EVENT_NEVER;
+    }
+    cpu->nextEvent = EVENT_NEVER;
+}
+
+// Schedule an event to run at the given time. Replaces any previous time for that event.
+void scheduleEvent(uint8 event, uint64 time, Cpu *cpu) {
+    cpu->events[event] = time;
+    updateNextEvent(cpu);
+}
+
+// Stop an event from running
+void cancelEvent(uint8 event, Cpu *cpu) {
+    scheduleEvent(event, EVENT_NEVER, cpu);
+}
+
+// Move the master clock forward and run every event that is now due, in order.
+void advanceClock(uint32 cycles, Cpu *cpu) {
+    cpu->clock += cycles;
+    while (cpu->nextEvent <= cpu->clock) {
+        // Find the earliest event. Events due at the same time run in enum order.
+        uint8 due = 0;
+        for (uint8 event = 1; event < EVENT_COUNT; event++) {
+            if (cpu->events[event] < cpu->events[due]) {
+                due = event;
+            }
+        }
+        uint64 time = cpu->events[due];
+        cpu->events[due] = EVENT_NEVER;
+        EVENT_HANDLERS[due](time, cpu);
+        updateNextEvent(cpu);
+    }
+}
+
+// Move the master clock forward in whole steps until the next event has run. With nothing scheduled
+// it moves a single step.
+void advanceToNextEvent(uint32 step, Cpu *cpu) {
+    if (cpu->nextEvent == EVENT_NEVER) {
+        advanceClock(step, cpu);
+        return;
+    }
+    uint64 steps = (cpu->nextEvent - cpu->clock + step - 1) / step;
+    advanceClock((uint32) (steps * step), cpu);
+}
@@ -0,0 +1,24 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "types.h"
+
+typedef struct Cpu Cpu;
+
+// Time used for events that aren't scheduled
+#define EVENT_NEVER UINT64_MAX
+
+// Events that can be scheduled on the master clock
+enum {
+    EVENT_SCREEN,
+    EVENT_TIMER,
+    EVENT_COUNT
+};
+
+extern void resetScheduler(Cpu *cpu);
+extern void scheduleEvent(uint8 event, uint64 time, Cpu *cpu);
+extern void cancelEvent(uint8 event, Cpu *cpu);
+extern void advanceClock(uint32 cycles, Cpu *cpu);
+extern void advanceToNextEvent(uint32 step, Cpu *cpu);
+
+#endif /* SCHEDULER_H */
@@ -6,11 +6,8 @@
 #include "memory.h"
 #include "interrupts.h"
 #include "display.h"
-#include <time.h>
-
-uint16 cycles = 0;
-bool displayActive = true;
-uint8 displayActiveCounter = 0;
+#include "renderer.h"
+#include "scheduler.h"
 
 // Check to see if scanline equals the the LY Compare value. If equal set flag and fire
 // interrupt if enabled.
@@ -53,82 +50,101 @@ static void setMode(uint8 mode, Cpu *cpu) {
     }
 }
 
-// Single step for the logic to control the screen
-void updateScreen(Cpu *cpu) {
+// Cycles spent in each screen mode. V Blank lasts this long for each of its lines.
+#define OAM_CYCLES      80
+#define VRAM_CYCLES     172
+#define H_BLANK_CYCLES  204
+#define V_BLANK_CYCLES  204
+// Cycles the LCD must be switched on for before the display restarts
+#define DISPLAY_RESTART_CYCLES 255
+
+// Start the screen at the beginning of V Blank
+void resetScreen(Cpu *cpu) {
+    cpu->displayActive = true;
+    scheduleEvent(EVENT_SCREEN, cpu->clock + V_BLANK_CYCLES, cpu);
+}
+
+// Run the screen logic for the end of the current mode, and schedule the end of the next one
+void screenEvent(uint64 time, Cpu *cpu) {
     //Order and number of cycles ref: http://imrannazar.com/GameBoy-Emulation-in-JavaScript:-GPU-Timings
     //TL;DR: flow is 143 * (OAM -> VRAM -> H_BLANK) -> 10 * V_BLANK
-    if (displayActive) { // DISPLAY ENABLED
-        uint8 screenMode = cpu->memory.io[STAT - IO_BASE] & 0b11; //grab last two bits for checking the screen mode
-        cycles++;
-        switch (screenMode) {
-            case OAM:
-                if (cycles >= 80) {
-                    setMode(VRAM, cpu);
-                    cycles = 0;
-                }
-                break;
-            case VRAM:
-                if (cycles >= 172) {
-                    // Load scanline during VRAM
-                    if (displayActive) {
-                        loadScanline(cpu);
-                    }
-                    setMode(H_BLANK, cpu);
-                    cycles = 0;
-                }
-                break;
-            case H_BLANK:
-                if (cycles >= 204) {
-                    incrementScanline(cpu);
-                    //switch to vblank when the scanline hits 144
-                    if (cpu->memory.io[SCANLINE - IO_BASE] > 143) {
-                        //write new status to the the STAT register
-                        setMode(V_BLANK, cpu);
-                        //set an interrupt flag
-                        setInterruptFlag(INTR_V_BLANK, cpu);
-                        // Draw the frame at beginning of v blank.
-                        // Only display if correct bit is set. Ths can only be togged during V Blank
-                        resetWindowLine();
-                        if (readBit(7, &cpu->memory.io[LCDC - IO_BASE])) {
-                            draw(cpu);
-                        } else {
-                            displayActive = false;
-                            displayActiveCounter = 255;
-                        }
-                    } else {
-                        setMode(OAM, cpu);
-                    }
-                    cycles = 0;
+    if (!cpu->displayActive) {
+        // Display has been switched back on for long enough to restart
+        cpu->displayActive = true;
+        resetWindowLine(cpu);
+        startFrame(cpu);
+        setScanline(0, cpu);
+        setMode(V_BLANK, cpu);
+        scheduleEvent(EVENT_SCREEN, time + V_BLANK_CYCLES, cpu);
+        return;
+    }
+    uint8 screenMode = cpu->memory.io[STAT - IO_BASE] & 0b11; //grab last two bits for checking the screen mode
+    switch (screenMode) {
+        case OAM:
+            setMode(VRAM, cpu);
+            scheduleEvent(EVENT_SCREEN, time + VRAM_CYCLES, cpu);
+            break;
+        case VRAM:
+            // Load scanline during VRAM, unless the frame is being skipped. A renderer thread draws it later.
+            if (cpu->display->rendering) {
+                if (cpu->renderer) {
+                    logRendererLine(cpu->memory.io[SCANLINE - IO_BASE], cpu);
+                } else {
+                    loadScanline(cpu);
                 }
-                break;
-            case V_BLANK:
-                if (cycles >= 204) {
-                    incrementScanline(cpu);
-                    //reset the scanline and switch the mode back to OAM
-                    if (cpu->memory.io[SCANLINE - IO_BASE] > 153) {
-                        //reset the scanline back to 0
-                        setScanline(0, cpu);
-                        //write new status to the the STAT register
-                        setMode(OAM, cpu);
-                        //load tiles as V Blank is now over
-                        loadTiles(cpu);
-                    }
-                    cycles = 0;
+            }
+            setMode(H_BLANK, cpu);
+            scheduleEvent(EVENT_SCREEN, time + H_BLANK_CYCLES, cpu);
+            break;
+        case H_BLANK:
+            incrementScanline(cpu);
+            //switch to vblank when the scanline hits 144
+            if (cpu->memory.io[SCANLINE - IO_BASE] > 143) {
+                //write new status to the the STAT register
+                setMode(V_BLANK, cpu);
+                //set an interrupt flag
+                setInterruptFlag(INTR_V_BLANK, cpu);
+                // Draw the frame at beginning of v blank.
+                // Only display if correct bit is set. Ths can only be togged during V Blank
+                resetWindowLine(cpu);
+                if (readBit(7, &cpu->memory.io[LCDC - IO_BASE])) {
+                    draw(cpu);
+                    scheduleEvent(EVENT_SCREEN, time + V_BLANK_CYCLES, cpu);
+                } else {
+                    // Wait for the LCD to be switched back on. See updateScreenControl
+                    cpu->displayActive = false;
                 }
-                break;
-        }
-    } else { // DISPLAY DISABLED
-        if (!readBit(7, &cpu->memory.io[LCDC - IO_BASE])) {
-            displayActiveCounter = 255;
-        } else {
-            displayActiveCounter--;
-            if (displayActiveCounter == 0) {
-                displayActive = true;
-                resetWindowLine();
-                cycles = 0;
+                startFrame(cpu);
+            } else {
+                setMode(OAM, cpu);
+                scheduleEvent(EVENT_SCREEN, time + OAM_CYCLES, cpu);
+            }
+            break;
+        case V_BLANK:
+            incrementScanline(cpu);
+            //reset the scanline and switch the mode back to OAM
+            if (cpu->memory.io[SCANLINE - IO_BASE] > 153) {
+                //reset the scanline back to 0
                 setScanline(0, cpu);
-                setMode(V_BLANK, cpu);
+                //write new status to the the STAT register
+                setMode(OAM, cpu);
+                scheduleEvent(EVENT_SCREEN, time + OAM_CYCLES, cpu);
+            } else {
+                scheduleEvent(EVENT_SCREEN, time + V_BLANK_CYCLES, cpu);
             }
-        }
+            break;
+    }
+}
+
+// Handle writes to the LCDC register. When the display is off, it restarts once the LCD
+// has been switched on for long enough.
+void updateScreenControl(Cpu *cpu) {
+    if (cpu->displayActive) {
+        return;
+    }
+    if (!readBit(7, &cpu->memory.io[LCDC - IO_BASE])) {
+        cancelEvent(EVENT_SCREEN, cpu);
+    } else if (cpu->events[EVENT_SCREEN] == EVENT_NEVER) {
+        scheduleEvent(EVENT_SCREEN, cpu->clock + DISPLAY_RESTART_CYCLES, cpu);
     }
 }
@@ -3,7 +3,9 @@
 
 #include "cpu.h"
 
-extern void updateScreen(Cpu *cpu);
+extern void resetScreen(Cpu *cpu);
+extern void screenEvent(uint64 time, Cpu *cpu);
+extern void updateScreenControl(Cpu *cpu);
 
 // Screen constants
 #define H_BLANK             0b000
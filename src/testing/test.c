@@ -7,6 +7,7 @@
 // Performs basic reset on the cpu
 static void resetCPU(Cpu *cpu) {
     cpu->registers.AF = 0x00;
+    writeFlagsRegister(cpu->registers.F, cpu);
     cpu->registers.BC = 0x00;
     cpu->registers.DE = 0x00;
     cpu->registers.HL = 0x00;
@@ -47,7 +48,7 @@ static bool assertUint16(uint16 actual, uint16 expected) {
 
 // Assert flag is either set or reset
 static bool assertFlag(uint8 flag, bool state, Cpu *cpu) {
-    bool result = ((cpu->registers.F >> flag) & 0b1) == state;
+    bool result = ((readFlagsRegister(cpu) >> flag) & 0b1) == state;
     if (!result) {
         char *name;
         switch (flag) {
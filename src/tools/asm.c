@@ -0,0 +1,1142 @@
+/* -*-mode:c; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+// SM83 assembler. Builds small cartridges from source so benchmark roms can live in the tree.
+//
+// Usage: gbe-asm [source] [rom]
+//
+// Syntax follows the common Game Boy assemblers: one instruction per line, ';' comments, memory
+// operands in brackets ([hl], [hl+], [$ff00+c], [label]), and labels ending in ':'. Labels starting
+// with '.' are local to the last global label. Numbers can be decimal, $hex, 0xhex, %binary or 'c'.
+// Expressions support + - * / % & | ^ << >> ~, parentheses, high(), low() and bank(label), and '@' for
+// the address of the current instruction (bank(@) for its bank).
+//
+// Directives:
+//   title "NAME"        cartridge title (up to 15 characters)
+//   cartridge type      cartridge type byte, e.g. $01 for MBC1
+//   rombanks n          number of 16KB rom banks (2 to 512, a power of two)
+//   ramsize code        cartridge ram size byte, e.g. $03 for 32KB
+//   bank n              assemble into rom bank n (bank 0 at $0000, others at $4000)
+//   org address         set the address within the current bank, or ram for 'org $c000' style sections
+//   name equ expr       define a constant
+//   db / dw / ds        bytes (and strings), little endian words, and n bytes of fill
+//   include "file"      assemble another file, relative to the current one
+//
+// The header ($104-$14F) is written by the assembler: logo, title, cartridge type, sizes and both
+// checksums. The cartridge type and sizes are checked against what cartridgeInfo accepts.
+// Sources are assembled in two passes. Instruction sizes never depend on values, so labels can be
+// used before they are defined everywhere except in org, ds and bank.
+#include "../types.h"
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#define ASM_BANK_SIZE 0x4000
+#define ASM_MAX_BANKS 512
+#define ASM_MAX_SYMBOLS 4096
+#define ASM_MAX_NAME 64
+#define ASM_MAX_LINE 512
+#define ASM_MAX_OPERANDS 3
+#define ASM_MAX_INCLUDE 8
+
+#define HEADER_BASE 0x104
+#define HEADER_BOUND 0x150
+
+typedef struct {
+    char name[ASM_MAX_NAME];
+    int32 value;
+    uint16 bank;
+    bool defined; // defined during the current pass
+} Symbol;
+
+// Operand kinds. Registers share a kind and are told apart by index.
+typedef enum {
+    OP_R8,      // b c d e h l [hl] a
+    OP_R16,     // bc de hl sp af (af has index 4)
+    OP_COND,    // nz z nc c
+    OP_IMM,     // expression
+    OP_MEM,     // [expression]
+    OP_MEM_BC,
+    OP_MEM_DE,
+    OP_MEM_HLI, // [hl+]
+    OP_MEM_HLD, // [hl-]
+    OP_MEM_C,   // [c] or [$ff00+c]
+    OP_SP_REL,  // sp+expression
+} OperandKind;
+
+typedef struct {
+    OperandKind kind;
+    int index;
+    int32 value;
+    bool isC; // register c, which is also a condition
+} Operand;
+
+typedef struct {
+    const char *file;
+    int line;
+    int pass;
+    uint16 bank;
+    uint32 address; // address within the current section
+    bool inRom;     // sections outside rom ($8000 and up) reserve space but emit nothing
+    char scope[ASM_MAX_NAME];
+    bool undefined; // an expression used a symbol that is not yet defined
+    Symbol symbols[ASM_MAX_SYMBOLS];
+    int symbolCount;
+    uint8 *rom;
+    uint8 *used; // rom bytes already assembled, to catch overlapping sections
+    uint32 romBanks;
+    uint8 cartType;
+    uint8 ramSize;
+    char title[16];
+    int depth;
+} Assembler;
+
+static const uint8 LOGO[48] = {
+    0xCE, 0xED, 0x66, 0x66, 0xCC, 0x0D, 0x00, 0x0B, 0x03, 0x73, 0x00, 0x83, 0x00, 0x0C, 0x00, 0x0D,
+    0x00, 0x08, 0x11, 0x1F, 0x88, 0x89, 0x00, 0x0E, 0xDC, 0xCC, 0x6E, 0xE6, 0xDD, 0xDD, 0xD9, 0x99,
+    0xBB, 0xBB, 0x67, 0x63, 0x6E, 0x0E, 0xEC, 0xCC, 0xDD, 0xDC, 0x99, 0x9F, 0xBB, 0xB9, 0x33, 0x3E,
+};
+
+static void error(Assembler *as, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    if (as->line) {
+        fprintf(stderr, "%s:%d: error: ", as->file, as->line);
+    } else {
+        fprintf(stderr, "%s: error: ", as->file);
+    }
+    vfprintf(stderr, format, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+    exit(1);
+}
+
+static char *skipSpace(char *text) {
+    while (*text == ' ' || *text == '\t') {
+        text++;
+    }
+    return text;
+}
+
+static bool isNameChar(char c) {
+    return isalnum((unsigned char) c) || c == '_' || c == '.';
+}
+
+// Lower case copy of text with surrounding and internal whitespace removed
+static void compact(const char *text, char *out, size_t size) {
+    size_t length = 0;
+    for (; *text && length + 1 < size; text++) {
+        if (*text != ' ' && *text != '\t') {
+            out[length++] = (char) tolower((unsigned char) *text);
+        }
+    }
+    out[length] = '\0';
+}
+
+/*
+ * Symbols
+ */
+
+// Expand local labels (.name) into global.name
+static void qualify(Assembler *as, const char *name, char *out) {
+    if (name[0] == '.') {
+        if (!as->scope[0]) {
+            error(as, "local label %s has no global label before it", name);
+        }
+        if (strlen(as->scope) + strlen(name) >= ASM_MAX_NAME) {
+            error(as, "label name too long: %s", name);
+        }
+        sprintf(out, "%s%s", as->scope, name);
+    } else {
+        if (strlen(name) >= ASM_MAX_NAME) {
+            error(as, "label name too long: %s", name);
+        }
+        strcpy(out, name);
+    }
+}
+
+static Symbol *findSymbol(Assembler *as, const char *name) {
+    char full[ASM_MAX_NAME];
+    qualify(as, name, full);
+    for (int i = 0; i < as->symbolCount; i++) {
+        if (!strcmp(as->symbols[i].name, full)) {
+            return &as->symbols[i];
+        }
+    }
+    return NULL;
+}
+
+static void defineSymbol(Assembler *as, const char *name, int32 value, bool label) {
+    Symbol *symbol = findSymbol(as, name);
+    if (!symbol) {
+        if (as->symbolCount >= ASM_MAX_SYMBOLS) {
+            error(as, "too many symbols");
+        }
+        symbol = &as->symbols[as->symbolCount++];
+        qualify(as, name, symbol->name);
+    } else if (symbol->defined) {
+        error(as, "%s is already defined", name);
+    } else if (label && as->pass == 1 && symbol->value != value) {
+        error(as, "internal error: %s moved between passes", name);
+    }
+    symbol->value = value;
+    symbol->bank = as->bank;
+    symbol->defined = true;
+}
+
+/*
+ * Expressions
+ */
+
+static int32 parseExpression(Assembler *as, char **text);
+
+static int32 parseNumber(Assembler *as, char **text, int base) {
+    char *end;
+    long value = strtol(*text, &end, base);
+    if (end == *text) {
+        error(as, "expected a number at '%s'", *text);
+    }
+    *text = end;
+    return (int32) value;
+}
+
+static int32 parsePrimary(Assembler *as, char **text) {
+    char *p = skipSpace(*text);
+    int32 value = 0;
+    if (*p == '(') {
+        p++;
+        value = parseExpression(as, &p);
+        p = skipSpace(p);
+        if (*p != ')') {
+            error(as, "expected ')'");
+        }
+        p++;
+    } else if (*p == '-') {
+        p++;
+        value = -parsePrimary(as, &p);
+    } else if (*p == '+') {
+        p++;
+        value = parsePrimary(as, &p);
+    } else if (*p == '~') {
+        p++;
+        value = ~parsePrimary(as, &p);
+    } else if (*p == '$') {
+        p++;
+        value = parseNumber(as, &p, 16);
+    } else if (*p == '%') {
+        p++;
+        value = parseNumber(as, &p, 2);
+    } else if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+        p += 2;
+        value = parseNumber(as, &p, 16);
+    } else if (p[0] == '0' && (p[1] == 'b' || p[1] == 'B')) {
+        p += 2;
+        value = parseNumber(as, &p, 2);
+    } else if (isdigit((unsigned char) *p)) {
+        value = parseNumber(as, &p, 10);
+    } else if (*p == '\'' && p[1] && p[2] == '\'') {
+        value = (uint8) p[1];
+        p += 3;
+    } else if (*p == '@') {
+        // Address of the current instruction
+        p++;
+        value = (int32) as->address;
+    } else if (isNameChar(*p)) {
+        char name[ASM_MAX_NAME];
+        int length = 0;
+        while (isNameChar(*p)) {
+            if (length + 1 >= ASM_MAX_NAME) {
+                error(as, "name too long");
+            }
+            name[length++] = *p++;
+        }
+        name[length] = '\0';
+        char *q = skipSpace(p);
+        if (*q == '(' && (!strcasecmp(name, "high") || !strcasecmp(name, "low") || !strcasecmp(name, "bank"))) {
+            q++;
+            if (!strcasecmp(name, "bank")) {
+                q = skipSpace(q);
+                char label[ASM_MAX_NAME];
+                int labelLength = 0;
+                while (isNameChar(*q) && labelLength + 1 < ASM_MAX_NAME) {
+                    label[labelLength++] = *q++;
+                }
+                label[labelLength] = '\0';
+                Symbol *symbol = (labelLength) ? findSymbol(as, label) : NULL;
+                if (!labelLength && *q == '@') {
+                    // Bank being assembled
+                    q++;
+                    value = as->bank;
+                } else if (symbol && (symbol->defined || as->pass == 1)) {
+                    value = symbol->bank;
+                } else if (as->pass == 1) {
+                    error(as, "undefined symbol %s", label);
+                } else {
+                    as->undefined = true;
+                }
+            } else {
+                value = parseExpression(as, &q);
+                value = (!strcasecmp(name, "high")) ? (value >> 8) & 0xFF : value & 0xFF;
+            }
+            q = skipSpace(q);
+            if (*q != ')') {
+                error(as, "expected ')'");
+            }
+            p = q + 1;
+        } else {
+            Symbol *symbol = findSymbol(as, name);
+            // On the second pass every symbol has a value, even ones defined later in the source
+            if (symbol && (symbol->defined || as->pass == 1)) {
+                value = symbol->value;
+            } else if (as->pass == 1) {
+                error(as, "undefined symbol %s", name);
+            } else {
+                as->undefined = true;
+            }
+        }
+    } else {
+        error(as, "expected an expression at '%s'", p);
+    }
+    *text = p;
+    return value;
+}
+
+// Binary operators, lowest precedence first
+static const char *OPERATORS[][4] = {
+    {"|", NULL},
+    {"^", NULL},
+    {"&", NULL},
+    {"<<", ">>", NULL},
+    {"+", "-", NULL},
+    {"*", "/", "%", NULL},
+};
+#define PRECEDENCE_LEVELS 6
+
+static int32 parseLevel(Assembler *as, char **text, int level) {
+    if (level == PRECEDENCE_LEVELS) {
+        return parsePrimary(as, text);
+    }
+    int32 value = parseLevel(as, text, level + 1);
+    for (;;) {
+        char *p = skipSpace(*text);
+        const char *op = NULL;
+        for (int i = 0; OPERATORS[level][i]; i++) {
+            size_t length = strlen(OPERATORS[level][i]);
+            if (!strncmp(p, OPERATORS[level][i], length)) {
+                op = OPERATORS[level][i];
+                p += length;
+                break;
+            }
+        }
+        if (!op) {
+            return value;
+        }
+        int32 right = parseLevel(as, &p, level + 1);
+        *text = p;
+        switch (op[0]) {
+            case '|': value |= right; break;
+            case '^': value ^= right; break;
+            case '&': value &= right; break;
+            case '<': value <<= right; break;
+            case '>': value >>= right; break;
+            case '+': value += right; break;
+            case '-': value -= right; break;
+            case '*': value *= right; break;
+            case '/':
+            case '%':
+                if (!right) {
+                    if (as->undefined) {
+                        right = 1;
+                    } else {
+                        error(as, "division by zero");
+                    }
+                }
+                value = (op[0] == '/') ? value / right : value % right;
+                break;
+        }
+    }
+}
+
+static int32 parseExpression(Assembler *as, char **text) {
+    return parseLevel(as, text, 0);
+}
+
+// Evaluate a whole operand
+static int32 evaluate(Assembler *as, const char *text) {
+    char *p = (char *) text;
+    int32 value = parseExpression(as, &p);
+    p = skipSpace(p);
+    if (*p) {
+        error(as, "unexpected '%s' in expression", p);
+    }
+    return value;
+}
+
+// Evaluate an expression whose value changes the layout, so it must be known on the first pass
+static int32 evaluateNow(Assembler *as, const char *text) {
+    as->undefined = false;
+    int32 value = evaluate(as, text);
+    if (as->undefined) {
+        error(as, "'%s' must only use symbols defined before it", text);
+    }
+    return value;
+}
+
+/*
+ * Output
+ */
+
+static void emit(Assembler *as, uint8 value) {
+    uint32 limit = (as->bank) ? 2 * ASM_BANK_SIZE : ASM_BANK_SIZE;
+    if (!as->inRom) {
+        error(as, "code and data can't be placed in ram");
+    }
+    if (as->address >= limit) {
+        error(as, "bank %d overflows", as->bank);
+    }
+    if (!as->bank && as->address >= HEADER_BASE && as->address < HEADER_BOUND) {
+        error(as, "code overlaps the cartridge header at $%04X", as->address);
+    }
+    if (as->pass == 1) {
+        if (as->bank >= as->romBanks) {
+            error(as, "bank %d is outside the %d rom banks", as->bank, as->romBanks);
+        }
+        uint32 offset = as->bank * ASM_BANK_SIZE + ((as->bank) ? as->address - ASM_BANK_SIZE : as->address);
+        if (as->used[offset]) {
+            error(as, "overlaps code already at $%04X in bank %d", as->address, as->bank);
+        }
+        as->used[offset] = true;
+        as->rom[offset] = value;
+    }
+    as->address++;
+}
+
+static void emitWord(Assembler *as, int32 value) {
+    emit(as, value & 0xFF);
+    emit(as, (value >> 8) & 0xFF);
+}
+
+static void emitByte(Assembler *as, int32 value) {
+    if (as->pass == 1 && (value < -128 || value > 255)) {
+        error(as, "value %d doesn't fit in a byte", value);
+    }
+    emit(as, value & 0xFF);
+}
+
+/*
+ * Instructions
+ */
+
+static const char *R8[] = {"b", "c", "d", "e", "h", "l", "[hl]", "a"};
+static const char *R16[] = {"bc", "de", "hl", "sp", "af"};
+static const char *CONDITIONS[] = {"nz", "z", "nc", "c"};
+
+static Operand parseOperand(Assembler *as, const char *text) {
+    char name[ASM_MAX_LINE];
+    compact(text, name, sizeof(name));
+    Operand operand = {OP_IMM, 0, 0, false};
+    for (int i = 0; i < 8; i++) {
+        if (!strcmp(name, R8[i])) {
+            operand.kind = OP_R8;
+            operand.index = i;
+            operand.isC = (i == 1);
+            return operand;
+        }
+    }
+    for (int i = 0; i < 5; i++) {
+        if (!strcmp(name, R16[i])) {
+            operand.kind = OP_R16;
+            operand.index = i;
+            return operand;
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        if (!strcmp(name, CONDITIONS[i])) {
+            operand.kind = OP_COND;
+            operand.index = i;
+            return operand;
+        }
+    }
+    if (!strcmp(name, "[bc]")) {
+        operand.kind = OP_MEM_BC;
+    } else if (!strcmp(name, "[de]")) {
+        operand.kind = OP_MEM_DE;
+    } else if (!strcmp(name, "[hl+]") || !strcmp(name, "[hli]")) {
+        operand.kind = OP_MEM_HLI;
+    } else if (!strcmp(name, "[hl-]") || !strcmp(name, "[hld]")) {
+        operand.kind = OP_MEM_HLD;
+    } else if (!strcmp(name, "[c]") || !strcmp(name, "[$ff00+c]") || !strcmp(name, "[0xff00+c]")) {
+        operand.kind = OP_MEM_C;
+    } else if (name[0] == '[') {
+        // Evaluate the original text, as symbols are case sensitive
+        char inner[ASM_MAX_LINE];
+        const char *start = strchr(text, '[') + 1;
+        const char *end = strrchr(text, ']');
+        if (!end || end < start || end[1]) {
+            error(as, "missing ']' in %s", text);
+        }
+        snprintf(inner, sizeof(inner), "%.*s", (int) (end - start), start);
+        operand.kind = OP_MEM;
+        operand.value = evaluate(as, inner);
+    } else if (!strncmp(name, "sp+", 3) || !strncmp(name, "sp-", 3)) {
+        operand.kind = OP_SP_REL;
+        operand.value = evaluate(as, skipSpace((char *) text) + 2);
+    } else {
+        operand.value = evaluate(as, text);
+    }
+    return operand;
+}
+
+// Read register c as the carry condition for jumps, calls and returns
+static void asCondition(Operand *operand) {
+    if (operand->kind == OP_R8 && operand->isC) {
+        operand->kind = OP_COND;
+        operand->index = 3;
+    }
+}
+
+static bool isA(const Operand *operand) {
+    return operand->kind == OP_R8 && operand->index == 7;
+}
+
+static bool isHL(const Operand *operand) {
+    return operand->kind == OP_R16 && operand->index == 2;
+}
+
+static bool isSP(const Operand *operand) {
+    return operand->kind == OP_R16 && operand->index == 3;
+}
+
+static void expectCount(Assembler *as, const char *mnemonic, int count, int expected) {
+    if (count != expected) {
+        error(as, "%s takes %d operand%s", mnemonic, expected, (expected == 1) ? "" : "s");
+    }
+}
+
+static void invalid(Assembler *as, const char *mnemonic) {
+    error(as, "invalid operands for %s", mnemonic);
+}
+
+// Instructions without operands
+static const struct {
+    const char *name;
+    uint8 opcode;
+} IMPLIED[] = {
+    {"nop", 0x00}, {"halt", 0x76}, {"di", 0xF3}, {"ei", 0xFB}, {"rlca", 0x07}, {"rrca", 0x0F},
+    {"rla", 0x17}, {"rra", 0x1F}, {"daa", 0x27}, {"cpl", 0x2F}, {"scf", 0x37}, {"ccf", 0x3F},
+    {"reti", 0xD9},
+};
+
+// ALU operations on a, by base opcode for the register form
+static const struct {
+    const char *name;
+    uint8 opcode;
+} ALU[] = {
+    {"add", 0x80}, {"adc", 0x88}, {"sub", 0x90}, {"sbc", 0x98},
+    {"and", 0xA0}, {"xor", 0xA8}, {"or", 0xB0}, {"cp", 0xB8},
+};
+
+// CB prefixed rotates and shifts
+static const char *SHIFTS[] = {"rlc", "rrc", "rl", "rr", "sla", "sra", "swap", "srl"};
+
+static void assembleLoad(Assembler *as, Operand *ops, int count) {
+    expectCount(as, "ld", count, 2);
+    Operand *dst = &ops[0];
+    Operand *src = &ops[1];
+    if (dst->kind == OP_R8 && src->kind == OP_R8) {
+        if (dst->index == 6 && src->index == 6) {
+            invalid(as, "ld");
+        }
+        emit(as, 0x40 | (dst->index << 3) | src->index);
+    } else if (dst->kind == OP_R8 && src->kind == OP_IMM) {
+        emit(as, 0x06 | (dst->index << 3));
+        emitByte(as, src->value);
+    } else if (dst->kind == OP_R16 && dst->index < 4 && src->kind == OP_IMM) {
+        emit(as, 0x01 | (dst->index << 4));
+        emitWord(as, src->value);
+    } else if (isSP(dst) && isHL(src)) {
+        emit(as, 0xF9);
+    } else if (isHL(dst) && src->kind == OP_SP_REL) {
+        emit(as, 0xF8);
+        emitByte(as, src->value);
+    } else if (dst->kind == OP_MEM && isSP(src)) {
+        emit(as, 0x08);
+        emitWord(as, dst->value);
+    } else if (isA(src) && dst->kind != OP_R8) {
+        switch (dst->kind) {
+            case OP_MEM_BC: emit(as, 0x02); break;
+            case OP_MEM_DE: emit(as, 0x12); break;
+            case OP_MEM_HLI: emit(as, 0x22); break;
+            case OP_MEM_HLD: emit(as, 0x32); break;
+            case OP_MEM_C: emit(as, 0xE2); break;
+            case OP_MEM: emit(as, 0xEA); emitWord(as, dst->value); break;
+            default: invalid(as, "ld");
+        }
+    } else if (isA(dst) && src->kind != OP_R8) {
+        switch (src->kind) {
+            case OP_MEM_BC: emit(as, 0x0A); break;
+            case OP_MEM_DE: emit(as, 0x1A); break;
+            case OP_MEM_HLI: emit(as, 0x2A); break;
+            case OP_MEM_HLD: emit(as, 0x3A); break;
+            case OP_MEM_C: emit(as, 0xF2); break;
+            case OP_MEM: emit(as, 0xFA); emitWord(as, src->value); break;
+            default: invalid(as, "ld");
+        }
+    } else {
+        invalid(as, "ld");
+    }
+}
+
+static void assembleInstruction(Assembler *as, const char *mnemonic, Operand *ops, int count) {
+    for (size_t i = 0; i < sizeof(IMPLIED) / sizeof(IMPLIED[0]); i++) {
+        if (!strcmp(mnemonic, IMPLIED[i].name)) {
+            expectCount(as, mnemonic, count, 0);
+            emit(as, IMPLIED[i].opcode);
+            return;
+        }
+    }
+    for (size_t i = 0; i < sizeof(ALU) / sizeof(ALU[0]); i++) {
+        if (strcmp(mnemonic, ALU[i].name)) {
+            continue;
+        }
+        if (i == 0 && count == 2 && isHL(&ops[0]) && ops[1].kind == OP_R16 && ops[1].index < 4) {
+            emit(as, 0x09 | (ops[1].index << 4));
+            return;
+        }
+        if (i == 0 && count == 2 && isSP(&ops[0]) && ops[1].kind == OP_IMM) {
+            emit(as, 0xE8);
+            emitByte(as, ops[1].value);
+            return;
+        }
+        // Both 'sub b' and 'sub a, b' are accepted
+        Operand *src = &ops[count - 1];
+        if (count < 1 || count > 2 || (count == 2 && !isA(&ops[0]))) {
+            invalid(as, mnemonic);
+        }
+        if (src->kind == OP_R8) {
+            emit(as, ALU[i].opcode | src->index);
+        } else if (src->kind == OP_IMM) {
+            emit(as, ALU[i].opcode | 0x46);
+            emitByte(as, src->value);
+        } else {
+            invalid(as, mnemonic);
+        }
+        return;
+    }
+    for (int i = 0; i < 8; i++) {
+        if (!strcmp(mnemonic, SHIFTS[i])) {
+            expectCount(as, mnemonic, count, 1);
+            if (ops[0].kind != OP_R8) {
+                invalid(as, mnemonic);
+            }
+            emit(as, 0xCB);
+            emit(as, (i << 3) | ops[0].index);
+            return;
+        }
+    }
+    if (!strcmp(mnemonic, "bit") || !strcmp(mnemonic, "res") || !strcmp(mnemonic, "set")) {
+        expectCount(as, mnemonic, count, 2);
+        if (ops[0].kind != OP_IMM || ops[0].value < 0 || ops[0].value > 7 || ops[1].kind != OP_R8) {
+            invalid(as, mnemonic);
+        }
+        uint8 base = (mnemonic[0] == 'b') ? 0x40 : (mnemonic[0] == 'r') ? 0x80 : 0xC0;
+        emit(as, 0xCB);
+        emit(as, base | (ops[0].value << 3) | ops[1].index);
+    } else if (!strcmp(mnemonic, "ld")) {
+        assembleLoad(as, ops, count);
+    } else if (!strcmp(mnemonic, "ldh")) {
+        expectCount(as, mnemonic, count, 2);
+        Operand *memory = (isA(&ops[0])) ? &ops[1] : &ops[0];
+        if (memory->kind == OP_MEM_C) {
+            emit(as, (isA(&ops[0])) ? 0xF2 : 0xE2);
+            return;
+        }
+        if (memory->kind != OP_MEM || !(isA(&ops[0]) || isA(&ops[1]))) {
+            invalid(as, mnemonic);
+        }
+        int32 address = memory->value;
+        if (address >= 0xFF00) {
+            address -= 0xFF00;
+        }
+        if (as->pass == 1 && (address < 0 || address > 0xFF)) {
+            error(as, "ldh address $%X is outside $FF00-$FFFF", memory->value);
+        }
+        emit(as, (isA(&ops[0])) ? 0xF0 : 0xE0);
+        emit(as, address & 0xFF);
+    } else if (!strcmp(mnemonic, "inc") || !strcmp(mnemonic, "dec")) {
+        expectCount(as, mnemonic, count, 1);
+        bool inc = (mnemonic[0] == 'i');
+        if (ops[0].kind == OP_R8) {
+            emit(as, ((inc) ? 0x04 : 0x05) | (ops[0].index << 3));
+        } else if (ops[0].kind == OP_R16 && ops[0].index < 4) {
+            emit(as, ((inc) ? 0x03 : 0x0B) | (ops[0].index << 4));
+        } else {
+            invalid(as, mnemonic);
+        }
+    } else if (!strcmp(mnemonic, "push") || !strcmp(mnemonic, "pop")) {
+        expectCount(as, mnemonic, count, 1);
+        if (ops[0].kind != OP_R16 || isSP(&ops[0])) {
+            invalid(as, mnemonic);
+        }
+        int index = (ops[0].index == 4) ? 3 : ops[0].index;
+        emit(as, ((mnemonic[1] == 'u') ? 0xC5 : 0xC1) | (index << 4));
+    } else if (!strcmp(mnemonic, "jp")) {
+        if (count == 1 && (isHL(&ops[0]) || (ops[0].kind == OP_R8 && ops[0].index == 6))) {
+            emit(as, 0xE9);
+            return;
+        }
+        if (count == 2) {
+            asCondition(&ops[0]);
+        }
+        if (count < 1 || count > 2 || ops[count - 1].kind != OP_IMM || (count == 2 && ops[0].kind != OP_COND)) {
+            invalid(as, mnemonic);
+        }
+        emit(as, (count == 2) ? 0xC2 | (ops[0].index << 3) : 0xC3);
+        emitWord(as, ops[count - 1].value);
+    } else if (!strcmp(mnemonic, "jr")) {
+        if (count == 2) {
+            asCondition(&ops[0]);
+        }
+        if (count < 1 || count > 2 || ops[count - 1].kind != OP_IMM || (count == 2 && ops[0].kind != OP_COND)) {
+            invalid(as, mnemonic);
+        }
+        emit(as, (count == 2) ? 0x20 | (ops[0].index << 3) : 0x18);
+        int32 offset = ops[count - 1].value - (int32) (as->address + 1);
+        if (as->pass == 1 && (offset < -128 || offset > 127)) {
+            error(as, "jr target is %d bytes away", offset);
+        }
+        emit(as, offset & 0xFF);
+    } else if (!strcmp(mnemonic, "call")) {
+        if (count == 2) {
+            asCondition(&ops[0]);
+        }
+        if (count < 1 || count > 2 || ops[count - 1].kind != OP_IMM || (count == 2 && ops[0].kind != OP_COND)) {
+            invalid(as, mnemonic);
+        }
+        emit(as, (count == 2) ? 0xC4 | (ops[0].index << 3) : 0xCD);
+        emitWord(as, ops[count - 1].value);
+    } else if (!strcmp(mnemonic, "ret")) {
+        if (count == 1) {
+            asCondition(&ops[0]);
+            if (ops[0].kind != OP_COND) {
+                invalid(as, mnemonic);
+            }
+            emit(as, 0xC0 | (ops[0].index << 3));
+        } else {
+            expectCount(as, mnemonic, count, 0);
+            emit(as, 0xC9);
+        }
+    } else if (!strcmp(mnemonic, "rst")) {
+        expectCount(as, mnemonic, count, 1);
+        if (ops[0].kind != OP_IMM || (ops[0].value & ~0x38)) {
+            invalid(as, mnemonic);
+        }
+        emit(as, 0xC7 | ops[0].value);
+    } else if (!strcmp(mnemonic, "stop")) {
+        error(as, "stop isn't emulated");
+    } else {
+        error(as, "unknown instruction %s", mnemonic);
+    }
+}
+
+/*
+ * Source
+ */
+
+// Split operands on top level commas. Returns the number of operands.
+static int splitOperands(Assembler *as, char *text, char **operands, int max) {
+    int count = 0;
+    text = skipSpace(text);
+    if (!*text) {
+        return 0;
+    }
+    int depth = 0;
+    bool quoted = false;
+    operands[count++] = text;
+    for (char *p = text; *p; p++) {
+        if (*p == '"') {
+            quoted = !quoted;
+        } else if (quoted) {
+            continue;
+        } else if (*p == '\'' && p[1] && p[2] == '\'') {
+            p += 2;
+        } else if (*p == '(' || *p == '[') {
+            depth++;
+        } else if (*p == ')' || *p == ']') {
+            depth--;
+        } else if (*p == ',' && !depth) {
+            if (count == max) {
+                error(as, "too many operands");
+            }
+            *p = '\0';
+            operands[count++] = skipSpace(p + 1);
+        }
+    }
+    // Trim trailing whitespace
+    for (int i = 0; i < count; i++) {
+        char *end = operands[i] + strlen(operands[i]);
+        while (end > operands[i] && isspace((unsigned char) end[-1])) {
+            *--end = '\0';
+        }
+        if (!*operands[i]) {
+            error(as, "empty operand");
+        }
+    }
+    return count;
+}
+
+// Read a quoted string operand into out
+static void readString(Assembler *as, const char *text, char *out, size_t size) {
+    size_t length = strlen(text);
+    if (length < 2 || text[0] != '"' || text[length - 1] != '"') {
+        error(as, "expected a quoted string");
+    }
+    if (length - 2 >= size) {
+        error(as, "string too long");
+    }
+    memcpy(out, text + 1, length - 2);
+    out[length - 2] = '\0';
+}
+
+static void assembleFile(Assembler *as, const char *path);
+
+static void assembleDirective(Assembler *as, const char *directive, char **operands, int count) {
+    if (!strcmp(directive, "db")) {
+        for (int i = 0; i < count; i++) {
+            if (operands[i][0] == '"') {
+                char text[ASM_MAX_LINE];
+                readString(as, operands[i], text, sizeof(text));
+                for (char *c = text; *c; c++) {
+                    emit(as, (uint8) *c);
+                }
+            } else {
+                emitByte(as, evaluate(as, operands[i]));
+            }
+        }
+    } else if (!strcmp(directive, "dw")) {
+        for (int i = 0; i < count; i++) {
+            emitWord(as, evaluate(as, operands[i]));
+        }
+    } else if (!strcmp(directive, "ds")) {
+        if (count < 1 || count > 2) {
+            error(as, "ds takes a size and an optional fill byte");
+        }
+        int32 size = evaluateNow(as, operands[0]);
+        int32 fill = (count == 2) ? evaluate(as, operands[1]) : 0;
+        if (size < 0) {
+            error(as, "negative ds size");
+        }
+        if (!as->inRom) {
+            as->address += size;
+            return;
+        }
+        for (int32 i = 0; i < size; i++) {
+            emitByte(as, fill);
+        }
+    } else if (!strcmp(directive, "org")) {
+        expectCount(as, directive, count, 1);
+        int32 address = evaluateNow(as, operands[0]);
+        if (address < 0 || address > 0xFFFF) {
+            error(as, "org $%X is outside the address space", address);
+        }
+        as->inRom = (address < 2 * ASM_BANK_SIZE);
+        if (as->inRom && (address < ASM_BANK_SIZE) != (as->bank == 0)) {
+            error(as, "org $%04X is outside bank %d", address, as->bank);
+        }
+        as->address = address;
+    } else if (!strcmp(directive, "bank")) {
+        expectCount(as, directive, count, 1);
+        int32 bank = evaluateNow(as, operands[0]);
+        if (bank < 0 || bank >= ASM_MAX_BANKS) {
+            error(as, "invalid bank %d", bank);
+        }
+        as->bank = bank;
+        as->address = (bank) ? ASM_BANK_SIZE : 0;
+        as->inRom = true;
+    } else if (!strcmp(directive, "include")) {
+        expectCount(as, directive, count, 1);
+        char name[ASM_MAX_LINE];
+        readString(as, operands[0], name, sizeof(name));
+        // Resolve relative to the including file
+        char path[2 * ASM_MAX_LINE];
+        const char *slash = strrchr(as->file, '/');
+        if (name[0] != '/' && slash) {
+            snprintf(path, sizeof(path), "%.*s/%s", (int) (slash - as->file), as->file, name);
+        } else {
+            snprintf(path, sizeof(path), "%s", name);
+        }
+        assembleFile(as, path);
+    } else if (!strcmp(directive, "title")) {
+        expectCount(as, directive, count, 1);
+        readString(as, operands[0], as->title, sizeof(as->title));
+    } else if (!strcmp(directive, "cartridge")) {
+        expectCount(as, directive, count, 1);
+        as->cartType = evaluateNow(as, operands[0]);
+    } else if (!strcmp(directive, "rombanks")) {
+        expectCount(as, directive, count, 1);
+        as->romBanks = evaluateNow(as, operands[0]);
+    } else if (!strcmp(directive, "ramsize")) {
+        expectCount(as, directive, count, 1);
+        as->ramSize = evaluateNow(as, operands[0]);
+    } else {
+        error(as, "unknown instruction %s", directive);
+    }
+}
+
+static bool isDirective(const char *name) {
+    static const char *DIRECTIVES[] = {
+        "db", "dw", "ds", "org", "bank", "include", "title", "cartridge", "rombanks", "ramsize", NULL,
+    };
+    for (int i = 0; DIRECTIVES[i]; i++) {
+        if (!strcmp(name, DIRECTIVES[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void assembleLine(Assembler *as, char *line) {
+    // Strip comments, leaving semicolons in strings and character literals alone
+    bool quoted = false;
+    for (char *p = line; *p; p++) {
+        if (*p == '"') {
+            quoted = !quoted;
+        } else if (*p == '\'' && !quoted && p[1] && p[2] == '\'') {
+            p += 2;
+        } else if (*p == ';' && !quoted) {
+            *p = '\0';
+            break;
+        }
+    }
+    char *p = skipSpace(line);
+
+    // Labels
+    char *name = p;
+    while (isNameChar(*p)) {
+        p++;
+    }
+    if (p != name && *p == ':') {
+        *p++ = '\0';
+        defineSymbol(as, name, (int32) as->address, true);
+        if (name[0] != '.') {
+            strcpy(as->scope, name);
+        }
+        p = skipSpace(p);
+        name = p;
+        while (isNameChar(*p)) {
+            p++;
+        }
+    }
+    if (p == name) {
+        if (*skipSpace(p)) {
+            error(as, "unexpected '%s'", skipSpace(p));
+        }
+        return;
+    }
+
+    char word[ASM_MAX_NAME];
+    size_t length = (size_t) (p - name);
+    if (length >= ASM_MAX_NAME) {
+        error(as, "name too long");
+    }
+    memcpy(word, name, length);
+    word[length] = '\0';
+    char *rest = skipSpace(p);
+
+    // Constants: name equ expression
+    if (!strncmp(rest, "equ", 3) && !isNameChar(rest[3])) {
+        as->undefined = false;
+        int32 value = evaluate(as, rest + 3);
+        if (!as->undefined) {
+            defineSymbol(as, word, value, false);
+        }
+        return;
+    }
+
+    char mnemonic[ASM_MAX_NAME];
+    for (size_t i = 0; i <= length; i++) {
+        mnemonic[i] = (char) tolower((unsigned char) word[i]);
+    }
+    if (isDirective(mnemonic)) {
+        char *operands[ASM_MAX_LINE / 2];
+        int count = splitOperands(as, rest, operands, ASM_MAX_LINE / 2);
+        assembleDirective(as, mnemonic, operands, count);
+        return;
+    }
+    char *texts[ASM_MAX_OPERANDS];
+    int count = splitOperands(as, rest, texts, ASM_MAX_OPERANDS);
+    Operand operands[ASM_MAX_OPERANDS];
+    as->undefined = false;
+    for (int i = 0; i < count; i++) {
+        operands[i] = parseOperand(as, texts[i]);
+    }
+    assembleInstruction(as, mnemonic, operands, count);
+}
+
+static void assembleFile(Assembler *as, const char *path) {
+    if (as->depth >= ASM_MAX_INCLUDE) {
+        error(as, "includes nested too deeply");
+    }
+    FILE *source = fopen(path, "r");
+    if (!source) {
+        if (as->depth) {
+            error(as, "could not open %s", path);
+        }
+        fprintf(stderr, "Error: could not open %s\n", path);
+        exit(2);
+    }
+    const char *file = as->file;
+    int line = as->line;
+    char *name = strdup(path);
+    as->file = name;
+    as->line = 0;
+    as->depth++;
+
+    char text[ASM_MAX_LINE];
+    while (fgets(text, sizeof(text), source)) {
+        as->line++;
+        if (!strchr(text, '\n') && !feof(source)) {
+            error(as, "line too long");
+        }
+        text[strcspn(text, "\r\n")] = '\0';
+        assembleLine(as, text);
+    }
+    fclose(source);
+
+    as->depth--;
+    as->file = file;
+    as->line = line;
+    free(name);
+}
+
+/*
+ * Cartridge
+ */
+
+// Check the cartridge against what cartridgeInfo accepts
+static void checkCartridge(Assembler *as) {
+    switch (as->cartType) {
+        case 0x00:
+        case 0x08:
+        case 0x09:
+            if (as->romBanks != 2) {
+                error(as, "cartridges without an MBC have 2 rom banks");
+            }
+            break;
+        case 0x01:
+        case 0x02:
+        case 0x03:
+        case 0x11:
+        case 0x12:
+        case 0x13:
+        case 0x19:
+        case 0x1A:
+        case 0x1B:
+            break;
+        default:
+            error(as, "cartridge type $%02X isn't supported", as->cartType);
+    }
+    if (as->romBanks < 2 || as->romBanks > ASM_MAX_BANKS || (as->romBanks & (as->romBanks - 1))) {
+        error(as, "rombanks must be a power of two from 2 to %d", ASM_MAX_BANKS);
+    }
+    if (as->ramSize > 0x05) {
+        error(as, "invalid ramsize $%02X", as->ramSize);
+    }
+    bool hasRam = (as->cartType == 0x02 || as->cartType == 0x03 || as->cartType == 0x08 || as->cartType == 0x09 ||
+                   as->cartType == 0x12 || as->cartType == 0x13 || as->cartType == 0x1A || as->cartType == 0x1B);
+    if (as->ramSize && !hasRam) {
+        error(as, "cartridge type $%02X has no ram", as->cartType);
+    }
+}
+
+static void writeHeader(Assembler *as) {
+    uint8 *rom = as->rom;
+    memcpy(rom + 0x104, LOGO, sizeof(LOGO));
+    memset(rom + 0x134, 0, 16);
+    memcpy(rom + 0x134, as->title, strlen(as->title));
+    rom[0x143] = 0x00; // DMG
+    rom[0x144] = '0';
+    rom[0x145] = '0';
+    rom[0x146] = 0x00; // no SGB functions
+    rom[0x147] = as->cartType;
+    uint8 romSize = 0;
+    while ((2u << romSize) < as->romBanks) {
+        romSize++;
+    }
+    rom[0x148] = romSize;
+    rom[0x149] = as->ramSize;
+    rom[0x14A] = 0x01; // non-Japanese
+    rom[0x14B] = 0x33; // licensee is in $144
+    rom[0x14C] = 0x00;
+
+    uint8 headerChecksum = 0;
+    for (int i = 0x134; i < 0x14D; i++) {
+        headerChecksum = headerChecksum - rom[i] - 1;
+    }
+    rom[0x14D] = headerChecksum;
+
+    uint16 globalChecksum = 0;
+    uint32 size = as->romBanks * ASM_BANK_SIZE;
+    for (uint32 i = 0; i < size; i++) {
+        if (i != 0x14E && i != 0x14F) {
+            globalChecksum += rom[i];
+        }
+    }
+    rom[0x14E] = globalChecksum >> 8;
+    rom[0x14F] = globalChecksum & 0xFF;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "Error: Usage: %s [source] [rom]\n", argv[0]);
+        exit(1);
+    }
+    Assembler *as = calloc(1, sizeof(Assembler));
+    if (!as) {
+        fprintf(stderr, "Error: unable to allocate the assembler\n");
+        exit(2);
+    }
+    as->romBanks = 2;
+    as->file = argv[1];
+
+    for (as->pass = 0; as->pass < 2; as->pass++) {
+        if (as->pass == 1) {
+            checkCartridge(as);
+            as->rom = malloc(as->romBanks * ASM_BANK_SIZE);
+            as->used = calloc(as->romBanks * ASM_BANK_SIZE, sizeof(uint8));
+            if (!as->rom || !as->used) {
+                fprintf(stderr, "Error: unable to allocate the rom\n");
+                exit(2);
+            }
+            memset(as->rom, 0xFF, as->romBanks * ASM_BANK_SIZE);
+            for (int i = 0; i < as->symbolCount; i++) {
+                as->symbols[i].defined = false;
+            }
+        }
+        as->bank = 0;
+        as->address = 0;
+        as->inRom = true;
+        as->scope[0] = '\0';
+        as->file = argv[1];
+        as->line = 0;
+        assembleFile(as, argv[1]);
+    }
+    writeHeader(as);
+
+    FILE *out = fopen(argv[2], "wb");
+    if (!out) {
+        fprintf(stderr, "Error: could not open %s\n", argv[2]);
+        exit(2);
+    }
+    uint32 size = as->romBanks * ASM_BANK_SIZE;
+    if (fwrite(as->rom, 1, size, out) != size) {
+        fprintf(stderr, "Error: could not write %s\n", argv[2]);
+        exit(2);
+    }
+    fclose(out);
+    free(as->rom);
+    free(as->used);
+    free(as);
+    return 0;
+}
@@ -0,0 +1,191 @@
+; ALU-heavy loops: shift and add multiplies, a bitwise CRC, decimal counting and bit operations.
+; The display shows a static background, so nearly all the time is spent in the cpu.
+include "hardware.inc"
+
+    title "GBE ALU"
+    cartridge CART_ROM
+    rombanks 2
+
+    org $100
+    nop
+    jp Start
+
+    org $150
+Start:
+    di
+    ld sp, $e000
+    call LcdOff
+    call LoadTiles
+    ld d, 0
+    ld e, 7
+    call FillMap
+    ld a, %11100100
+    ldh [BGP], a
+    ld a, LCDC_ON | LCDC_TILES_8000 | LCDC_BG_ON
+    ldh [LCDC], a
+
+Main:
+    call Multiply
+    call Crc16
+    call Decimal
+    call Popcount
+    call BitOps
+    ld hl, Passes
+    inc [hl]
+    jr Main
+
+; Multiply every byte by itself xor $5a, summing the products
+Multiply:
+    xor a
+    ld [Sum], a
+    ld [Sum + 1], a
+    ld [Count], a
+.next:
+    ld a, [Count]
+    ld e, a
+    xor $5a
+    ld c, a
+    call Mul8
+    ld a, [Sum]
+    add a, l
+    ld [Sum], a
+    ld a, [Sum + 1]
+    adc a, h
+    ld [Sum + 1], a
+    ld a, [Count]
+    inc a
+    ld [Count], a
+    jr nz, .next
+    ret
+
+; hl = e * c
+Mul8:
+    ld hl, 0
+    ld d, 0
+    ld b, 8
+.bit:
+    srl c
+    jr nc, .skip
+    add hl, de
+.skip:
+    sla e
+    rl d
+    dec b
+    jr nz, .bit
+    ret
+
+; CRC-16-CCITT of the first 256 bytes of code, a bit at a time
+Crc16:
+    ld hl, Start
+    ld de, $ffff
+    ld c, 0
+.byte:
+    ld a, [hl+]
+    xor d
+    ld d, a
+    ld b, 8
+.bit:
+    sla e
+    rl d
+    jr nc, .next
+    ld a, d
+    xor $10
+    ld d, a
+    ld a, e
+    xor $21
+    ld e, a
+.next:
+    dec b
+    jr nz, .bit
+    dec c
+    jr nz, .byte
+    ld a, d
+    ld [Crc], a
+    ld a, e
+    ld [Crc + 1], a
+    ret
+
+; Count from 0 to 9999 in binary coded decimal
+Decimal:
+    ld de, 0
+.count:
+    ld a, e
+    add a, 1
+    daa
+    ld e, a
+    ld a, d
+    adc a, 0
+    daa
+    ld d, a
+    cp $99
+    jr nz, .count
+    ld a, e
+    cp $99
+    jr nz, .count
+    ld [Bcd], a
+    ret
+
+; Count the set bits in every byte value
+Popcount:
+    ld hl, 0
+    ld c, 0
+.value:
+    ld a, c
+    ld b, 8
+.bit:
+    add a, a
+    jr nc, .clear
+    inc hl
+.clear:
+    dec b
+    jr nz, .bit
+    inc c
+    jr nz, .value
+    ld a, h
+    ld [Bits], a
+    ld a, l
+    ld [Bits + 1], a
+    ret
+
+; Swap, rotate, test, set and reset bits across a table in wram
+BitOps:
+    ld hl, Table
+    ld b, 0
+.next:
+    ld a, b
+    swap a
+    ld [hl], a
+    bit 0, [hl]
+    jr z, .even
+    set 7, [hl]
+    res 0, [hl]
+.even:
+    srl [hl]
+    rlc [hl]
+    sra [hl]
+    rr [hl]
+    inc l
+    inc b
+    jr nz, .next
+    ret
+
+include "common.inc"
+
+    org WRAM
+Count:
+    ds 1
+Sum:
+    ds 2
+Crc:
+    ds 2
+Bcd:
+    ds 1
+Bits:
+    ds 2
+Passes:
+    ds 1
+
+    ; Page aligned, so the loop only steps l
+    org WRAM + $100
+Table:
+    ds 256
@@ -0,0 +1,185 @@
+; Bank switch storms on an MBC1 cartridge with 16 rom banks and 4 ram banks. Each pass calls a
+; routine in every rom bank, switches banks on every iteration of a tight read loop, and writes the
+; results through each cartridge ram bank.
+include "hardware.inc"
+
+BANKS equ 16
+RAM_BANKS equ 4
+BANK_ID equ $7fff
+
+    title "GBE BANKING"
+    cartridge CART_MBC1_RAM_BATTERY
+    rombanks BANKS
+    ramsize $03
+
+    org $100
+    nop
+    jp Start
+
+    org $150
+Start:
+    di
+    ld sp, $e000
+    call LcdOff
+    call LoadTiles
+    ld d, 0
+    ld e, 3
+    call FillMap
+    ld a, %11100100
+    ldh [BGP], a
+    ld a, LCDC_ON | LCDC_TILES_8000 | LCDC_BG_ON
+    ldh [LCDC], a
+
+    ; Enable cartridge ram and select ram banking mode
+    ld a, $0a
+    ld [MBC_RAM_ENABLE], a
+    ld a, 1
+    ld [MBC1_MODE], a
+    xor a
+    ld [Mismatches], a
+
+Main:
+    call CallBanks
+    call Storm
+    call WriteRam
+    ld hl, Passes
+    inc [hl]
+    jr Main
+
+; Call the routine in each switchable bank, adding the sums
+CallBanks:
+    xor a
+    ld [Total], a
+    ld [Total + 1], a
+    ld c, 1
+.bank:
+    ld a, c
+    ld [MBC_ROM_BANK], a
+    push bc
+    call $4000
+    pop bc
+    ld a, [Total]
+    add a, e
+    ld [Total], a
+    ld a, [Total + 1]
+    adc a, d
+    ld [Total + 1], a
+    inc c
+    ld a, c
+    cp BANKS
+    jr nz, .bank
+    ret
+
+; Switch bank on every iteration and read back its number
+Storm:
+    ld c, 0
+.switch:
+    ld a, c
+    and BANKS - 1
+    jr nz, .mapped
+    inc a
+.mapped:
+    ld b, a
+    ld [MBC_ROM_BANK], a
+    ld a, [BANK_ID]
+    cp b
+    jr z, .next
+    ld hl, Mismatches
+    inc [hl]
+.next:
+    dec c
+    jr nz, .switch
+    ret
+
+; Write the total and pass count into each ram bank, then read them back
+WriteRam:
+    ld c, 0
+.bank:
+    ld a, c
+    ld [MBC_RAM_BANK], a
+    ld hl, SRAM
+    ld a, [Total]
+    ld [hl+], a
+    ld a, [Total + 1]
+    ld [hl+], a
+    ld a, [Passes]
+    add a, c
+    ld [hl+], a
+    inc c
+    ld a, c
+    cp RAM_BANKS
+    jr nz, .bank
+    ; Read back, summing the third byte of each bank
+    ld b, 0
+    ld c, 0
+.read:
+    ld a, c
+    ld [MBC_RAM_BANK], a
+    ld a, [SRAM + 2]
+    add a, b
+    ld b, a
+    inc c
+    ld a, c
+    cp RAM_BANKS
+    jr nz, .read
+    ld a, b
+    ld [RamCheck], a
+    ret
+
+include "common.inc"
+
+    org WRAM
+Total:
+    ds 2
+Passes:
+    ds 1
+Mismatches:
+    ds 1
+RamCheck:
+    ds 1
+
+    bank 1
+Bank1:
+    include "banked.inc"
+    bank 2
+Bank2:
+    include "banked.inc"
+    bank 3
+Bank3:
+    include "banked.inc"
+    bank 4
+Bank4:
+    include "banked.inc"
+    bank 5
+Bank5:
+    include "banked.inc"
+    bank 6
+Bank6:
+    include "banked.inc"
+    bank 7
+Bank7:
+    include "banked.inc"
+    bank 8
+Bank8:
+    include "banked.inc"
+    bank 9
+Bank9:
+    include "banked.inc"
+    bank 10
+Bank10:
+    include "banked.inc"
+    bank 11
+Bank11:
+    include "banked.inc"
+    bank 12
+Bank12:
+    include "banked.inc"
+    bank 13
+Bank13:
+    include "banked.inc"
+    bank 14
+Bank14:
+    include "banked.inc"
+    bank 15
+Bank15:
+    include "banked.inc"
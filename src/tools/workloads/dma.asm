@@ -0,0 +1,170 @@
+; VRAM and OAM churn. Every vertical blank copies a shadow OAM in with DMA, while the main loop
+; moves all 40 sprites, rotates the pixels of 64 tiles and steps a row of the background map.
+include "hardware.inc"
+
+    title "GBE DMA"
+    cartridge CART_ROM
+    rombanks 2
+
+    org $40
+    jp VBlank
+
+    org $100
+    nop
+    jp Start
+
+    org $150
+Start:
+    di
+    ld sp, $e000
+    call LcdOff
+    call LoadTiles
+    call CopyDmaRoutine
+    ; Eight more copies of the shared tiles, from tile 8, for the animation
+    ld de, VRAM + 8 * 16
+    ld c, 8
+.copy:
+    ld hl, Tiles
+    push bc
+    ld bc, TilesEnd - Tiles
+    call MemCopy
+    pop bc
+    dec c
+    jr nz, .copy
+    ld d, 8
+    ld e, 63
+    call FillMap
+    call InitSprites
+    ld a, high(ShadowOam)
+    call RunDma
+    ld a, %11100100
+    ldh [BGP], a
+    ld a, %11010000
+    ldh [OBP0], a
+    ld a, LCDC_ON | LCDC_TILES_8000 | LCDC_OBJ_ON | LCDC_BG_ON
+    ldh [LCDC], a
+    xor a
+    ld [Passes], a
+    ld [Frames], a
+    ldh [IF], a
+    ld a, INT_VBLANK
+    ldh [IE], a
+    ei
+
+Main:
+    call AnimateTiles
+    call MoveSprites
+    call StepMap
+    ld hl, Passes
+    inc [hl]
+    jr Main
+
+VBlank:
+    push af
+    push hl
+    ld a, high(ShadowOam)
+    call RunDma
+    ld hl, Frames
+    inc [hl]
+    pop hl
+    pop af
+    reti
+
+; Spread the sprites over the screen with each of the four flip combinations
+InitSprites:
+    ld hl, ShadowOam
+    ld c, 0
+.sprite:
+    ld a, c
+    add a, a
+    add a, a
+    add a, 16
+    ld [hl+], a
+    ld a, c
+    add a, a
+    add a, a
+    add a, a
+    ld [hl+], a
+    ld a, c
+    and 7
+    ld [hl+], a
+    ld a, c
+    and 3
+    swap a
+    add a, a
+    ld [hl+], a
+    inc c
+    ld a, c
+    cp 40
+    jr nz, .sprite
+    ret
+
+; Move each sprite down by 1 to 4 lines and right by one pixel
+MoveSprites:
+    ld hl, ShadowOam
+    ld c, 0
+.sprite:
+    ld a, c
+    and 3
+    inc a
+    add a, [hl]
+    ld [hl+], a
+    inc [hl]
+    inc l
+    inc l
+    inc l
+    inc c
+    ld a, c
+    cp 40
+    jr nz, .sprite
+    ret
+
+; Rotate every byte of tiles 8 to 71
+AnimateTiles:
+    ld hl, VRAM + 8 * 16
+    ld bc, 64 * 16
+.byte:
+    rlc [hl]
+    inc hl
+    dec bc
+    ld a, b
+    or c
+    jr nz, .byte
+    ret
+
+; Step the tiles in one row of the map, a different row each pass
+StepMap:
+    ld a, [Passes]
+    and 31
+    ld l, a
+    ld h, 0
+    add hl, hl
+    add hl, hl
+    add hl, hl
+    add hl, hl
+    add hl, hl
+    ld de, BG_MAP0
+    add hl, de
+    ld b, 32
+.tile:
+    ld a, [hl]
+    sub 7
+    and 63
+    add a, 8
+    ld [hl+], a
+    dec b
+    jr nz, .tile
+    ret
+
+include "common.inc"
+
+    org WRAM
+Passes:
+    ds 1
+Frames:
+    ds 1
+
+    ; DMA copies from the start of a page
+    org WRAM + $100
+ShadowOam:
+    ds 160
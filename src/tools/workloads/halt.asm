@@ -0,0 +1,76 @@
+; HALT-heavy idling. The cpu sleeps between interrupts: the timer, which overflows about 17 times a
+; frame, and vertical blank, which scrolls the background.
+include "hardware.inc"
+
+    title "GBE HALT"
+    cartridge CART_ROM
+    rombanks 2
+
+    org $40
+    jp VBlank
+
+    org $50
+    jp Timer
+
+    org $100
+    nop
+    jp Start
+
+    org $150
+Start:
+    di
+    ld sp, $e000
+    call LcdOff
+    call LoadTiles
+    ld d, 0
+    ld e, 7
+    call FillMap
+    ld a, %11100100
+    ldh [BGP], a
+    ld a, LCDC_ON | LCDC_TILES_8000 | LCDC_BG_ON
+    ldh [LCDC], a
+    xor a
+    ld [Wakes], a
+    ld [Ticks], a
+    ; 262144Hz from 0 overflows every 4096 cycles
+    ldh [TMA], a
+    ldh [TIMA], a
+    ld a, TAC_ON | TAC_262144
+    ldh [TAC], a
+    xor a
+    ldh [IF], a
+    ld a, INT_VBLANK | INT_TIMER
+    ldh [IE], a
+    ei
+
+Main:
+    halt
+    ld hl, Wakes
+    inc [hl]
+    jr Main
+
+VBlank:
+    push af
+    ldh a, [SCX]
+    inc a
+    ldh [SCX], a
+    ldh a, [SCY]
+    dec a
+    ldh [SCY], a
+    pop af
+    reti
+
+Timer:
+    push hl
+    ld hl, Ticks
+    inc [hl]
+    pop hl
+    reti
+
+include "common.inc"
+
+    org WRAM
+Wakes:
+    ds 1
+Ticks:
+    ds 1
@@ -0,0 +1,100 @@
+; STAT interrupt raster effects. An LYC interrupt on every visible line sets the horizontal scroll
+; from a sine table, bending the background into a wave, and the palette is inverted for the lower
+; half of the screen. The cpu halts between interrupts.
+include "hardware.inc"
+
+    title "GBE STAT"
+    cartridge CART_ROM
+    rombanks 2
+
+    org $40
+    jp VBlank
+
+    org $48
+    jp Stat
+
+    org $100
+    nop
+    jp Start
+
+    org $150
+Start:
+    di
+    ld sp, $e000
+    call LcdOff
+    call LoadTiles
+    ld d, 0
+    ld e, 7
+    call FillMap
+    ld a, %11100100
+    ldh [BGP], a
+    ld a, LCDC_ON | LCDC_TILES_8000 | LCDC_BG_ON
+    ldh [LCDC], a
+    xor a
+    ld [Phase], a
+    ldh [LYC], a
+    ld a, STAT_LYC
+    ldh [STAT], a
+    xor a
+    ldh [IF], a
+    ld a, INT_VBLANK | INT_STAT
+    ldh [IE], a
+    ei
+
+Main:
+    halt
+    jr Main
+
+; Scroll this line by the sine table, then move LYC on to the next line
+Stat:
+    push af
+    push hl
+    ld hl, Phase
+    ldh a, [LY]
+    add a, [hl]
+    and 63
+    ld l, a
+    ld h, high(Sine)
+    ld a, [hl]
+    ldh [SCX], a
+    ldh a, [LY]
+    cp 72
+    jr nz, .next
+    ld a, %00011011
+    ldh [BGP], a
+.next:
+    ldh a, [LYC]
+    inc a
+    cp 144
+    jr c, .set
+    xor a
+.set:
+    ldh [LYC], a
+    pop hl
+    pop af
+    reti
+
+; Restore the palette and move the wave along
+VBlank:
+    push af
+    ld a, %11100100
+    ldh [BGP], a
+    ld a, [Phase]
+    inc a
+    ld [Phase], a
+    pop af
+    reti
+
+include "common.inc"
+
+    ; Page aligned, so the handler only sets l
+    org $1000
+Sine:
+    db 8, 9, 10, 10, 11, 12, 12, 13, 14, 14, 15, 15, 15, 16, 16, 16
+    db 16, 16, 16, 16, 15, 15, 15, 14, 14, 13, 12, 12, 11, 10, 10, 9
+    db 8, 7, 6, 6, 5, 4, 4, 3, 2, 2, 1, 1, 1, 0, 0, 0
+    db 0, 0, 0, 0, 1, 1, 1, 2, 2, 3, 4, 4, 5, 6, 6, 7
+
+    org WRAM
+Phase:
+    ds 1
@@ -12,5 +12,8 @@ typedef uint16_t uint16;
 typedef int16_t int16;
 //four bytes
 typedef uint32_t uint32;
+typedef int32_t int32;
+//eight bytes
+typedef uint64_t uint64;
 
 #endif /* TYPES_H */
@@ -4,7 +4,7 @@
 #include "types.h"
 
 extern void startDisplay();
-extern void displayOnWindow(uint8 *frameBuffer);
+extern void displayOnWindow(uint8 *shades, const bool *changedLines);
 extern void stopDisplay();
 
 #endif /* WINDOW_H */
\ No newline at end of file